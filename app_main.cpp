@@ -32,6 +32,10 @@ int main(int argc, char** argv)
               << flight_trip_database->FindFlightsByOriginCity("Pune") << std::endl
               << std::endl;
 
+    std::cout << "Found flights with number prefix (6e-): " << std::endl
+              << flight_trip_database->FindFlightsByNumberPrefix("6e-") << std::endl
+              << std::endl;
+
     std::cout << "Found average cost for all trips: " << flight_trip_database->FindAverageCostOfAllTrips() << std::endl
               << std::endl;
 
@@ -0,0 +1,377 @@
+///
+/// @file async_flight_trip_database.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/async_flight_trip_database.h"
+#include "flight_management/logging.h"
+
+namespace fms
+{
+AsyncFlightTripDatabase::AsyncFlightTripDatabase(std::unique_ptr<IFlightTripDatabase> database)
+    : database_{std::move(database)}, executor_{}
+{
+    ASSERT_CHECK(database_) << "Async database requires an underlying database";
+}
+
+std::future<void> AsyncFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                                   const std::string& origin, const std::string& destination,
+                                                   const double& fare, const CancellationToken& token)
+{
+    return ToFuture<void>([&](Completion<void> on_complete) {
+        AddTrip(name, operated_by, origin, destination, fare, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                      const std::string& origin, const std::string& destination, const double& fare,
+                                      Completion<void> on_complete, const CancellationToken& token)
+{
+    Submit<void>(
+        [name, operated_by, origin, destination, fare](IFlightTripDatabase& database) {
+            database.AddTrip(name, operated_by, origin, destination, fare);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                                   const std::string& origin, const std::string& destination,
+                                                   const double& fare, const Timestamp departure_time,
+                                                   const Timestamp arrival_time, const CancellationToken& token)
+{
+    return ToFuture<void>([&](Completion<void> on_complete) {
+        AddTrip(name, operated_by, origin, destination, fare, departure_time, arrival_time, std::move(on_complete),
+                token);
+    });
+}
+
+void AsyncFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                      const std::string& origin, const std::string& destination, const double& fare,
+                                      const Timestamp departure_time, const Timestamp arrival_time,
+                                      Completion<void> on_complete, const CancellationToken& token)
+{
+    Submit<void>(
+        [name, operated_by, origin, destination, fare, departure_time, arrival_time](IFlightTripDatabase& database) {
+            database.AddTrip(name, operated_by, origin, destination, fare, departure_time, arrival_time);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::RemoveTrip(const std::string& name, const CancellationToken& token)
+{
+    return ToFuture<void>([&](Completion<void> on_complete) { RemoveTrip(name, std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::RemoveTrip(const std::string& name, Completion<void> on_complete,
+                                         const CancellationToken& token)
+{
+    Submit<void>([name](IFlightTripDatabase& database) { database.RemoveTrip(name); }, std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::RemoveTrip(const std::string& name, const Timestamp departure_time,
+                                                      const CancellationToken& token)
+{
+    return ToFuture<void>(
+        [&](Completion<void> on_complete) { RemoveTrip(name, departure_time, std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::RemoveTrip(const std::string& name, const Timestamp departure_time,
+                                         Completion<void> on_complete, const CancellationToken& token)
+{
+    Submit<void>(
+        [name, departure_time](IFlightTripDatabase& database) { database.RemoveTrip(name, departure_time); },
+        std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::UpdateFareByTrip(const std::string& name, const double& fare,
+                                                            const CancellationToken& token)
+{
+    return ToFuture<void>(
+        [&](Completion<void> on_complete) { UpdateFareByTrip(name, fare, std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::UpdateFareByTrip(const std::string& name, const double& fare,
+                                               Completion<void> on_complete, const CancellationToken& token)
+{
+    Submit<void>([name, fare](IFlightTripDatabase& database) { database.UpdateFareByTrip(name, fare); },
+                 std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                                            const double& fare, const CancellationToken& token)
+{
+    return ToFuture<void>([&](Completion<void> on_complete) {
+        UpdateFareByTrip(name, departure_time, fare, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                               const double& fare, Completion<void> on_complete,
+                                               const CancellationToken& token)
+{
+    Submit<void>(
+        [name, departure_time, fare](IFlightTripDatabase& database) {
+            database.UpdateFareByTrip(name, departure_time, fare);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<void> AsyncFlightTripDatabase::UpdateFareByOperator(const std::string& operated_by, const double& fare,
+                                                                const CancellationToken& token)
+{
+    return ToFuture<void>([&](Completion<void> on_complete) {
+        UpdateFareByOperator(operated_by, fare, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::UpdateFareByOperator(const std::string& operated_by, const double& fare,
+                                                   Completion<void> on_complete, const CancellationToken& token)
+{
+    Submit<void>(
+        [operated_by, fare](IFlightTripDatabase& database) { database.UpdateFareByOperator(operated_by, fare); },
+        std::move(on_complete), token);
+}
+
+std::future<std::vector<FlightTrip>> AsyncFlightTripDatabase::FindFlightByNumber(const std::string& name,
+                                                                                 const CancellationToken& token)
+{
+    return ToFuture<std::vector<FlightTrip>>([&](Completion<std::vector<FlightTrip>> on_complete) {
+        FindFlightByNumber(name, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindFlightByNumber(const std::string& name,
+                                                 Completion<std::vector<FlightTrip>> on_complete,
+                                                 const CancellationToken& token)
+{
+    Submit<std::vector<FlightTrip>>(
+        [name](IFlightTripDatabase& database) { return database.FindFlightByNumber(name); }, std::move(on_complete),
+        token);
+}
+
+std::future<std::vector<FlightTrip>> AsyncFlightTripDatabase::FindFlightsByOriginCity(const std::string& origin_city,
+                                                                                      const CancellationToken& token)
+{
+    return ToFuture<std::vector<FlightTrip>>([&](Completion<std::vector<FlightTrip>> on_complete) {
+        FindFlightsByOriginCity(origin_city, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindFlightsByOriginCity(const std::string& origin_city,
+                                                      Completion<std::vector<FlightTrip>> on_complete,
+                                                      const CancellationToken& token)
+{
+    Submit<std::vector<FlightTrip>>(
+        [origin_city](IFlightTripDatabase& database) { return database.FindFlightsByOriginCity(origin_city); },
+        std::move(on_complete), token);
+}
+
+std::future<std::vector<FlightTrip>> AsyncFlightTripDatabase::FindFlightsByNumberPrefix(
+    const std::string& prefix, const CancellationToken& token)
+{
+    return ToFuture<std::vector<FlightTrip>>([&](Completion<std::vector<FlightTrip>> on_complete) {
+        FindFlightsByNumberPrefix(prefix, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindFlightsByNumberPrefix(const std::string& prefix,
+                                                        Completion<std::vector<FlightTrip>> on_complete,
+                                                        const CancellationToken& token)
+{
+    Submit<std::vector<FlightTrip>>(
+        [prefix](IFlightTripDatabase& database) { return database.FindFlightsByNumberPrefix(prefix); },
+        std::move(on_complete), token);
+}
+
+std::future<std::vector<FlightTrip>> AsyncFlightTripDatabase::FindFlightsByOriginCityPrefix(
+    const std::string& prefix, const CancellationToken& token)
+{
+    return ToFuture<std::vector<FlightTrip>>([&](Completion<std::vector<FlightTrip>> on_complete) {
+        FindFlightsByOriginCityPrefix(prefix, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindFlightsByOriginCityPrefix(const std::string& prefix,
+                                                            Completion<std::vector<FlightTrip>> on_complete,
+                                                            const CancellationToken& token)
+{
+    Submit<std::vector<FlightTrip>>(
+        [prefix](IFlightTripDatabase& database) { return database.FindFlightsByOriginCityPrefix(prefix); },
+        std::move(on_complete), token);
+}
+
+std::future<double> AsyncFlightTripDatabase::FindAverageCostOfAllTrips(const CancellationToken& token)
+{
+    return ToFuture<double>(
+        [&](Completion<double> on_complete) { FindAverageCostOfAllTrips(std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::FindAverageCostOfAllTrips(Completion<double> on_complete, const CancellationToken& token)
+{
+    Submit<double>([](IFlightTripDatabase& database) { return database.FindAverageCostOfAllTrips(); },
+                   std::move(on_complete), token);
+}
+
+std::future<double> AsyncFlightTripDatabase::FindMinFareBetweenCities(const std::string& origin_city,
+                                                                      const std::string& destination_city,
+                                                                      const CancellationToken& token)
+{
+    return ToFuture<double>([&](Completion<double> on_complete) {
+        FindMinFareBetweenCities(origin_city, destination_city, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindMinFareBetweenCities(const std::string& origin_city,
+                                                       const std::string& destination_city,
+                                                       Completion<double> on_complete, const CancellationToken& token)
+{
+    Submit<double>(
+        [origin_city, destination_city](IFlightTripDatabase& database) {
+            return database.FindMinFareBetweenCities(origin_city, destination_city);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<std::vector<FlightTrip>> AsyncFlightTripDatabase::FindFlightsByOriginCityInTimeWindow(
+    const std::string& origin_city, const Timestamp from, const Timestamp to, const CancellationToken& token)
+{
+    return ToFuture<std::vector<FlightTrip>>([&](Completion<std::vector<FlightTrip>> on_complete) {
+        FindFlightsByOriginCityInTimeWindow(origin_city, from, to, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                  const Timestamp from, const Timestamp to,
+                                                                  Completion<std::vector<FlightTrip>> on_complete,
+                                                                  const CancellationToken& token)
+{
+    Submit<std::vector<FlightTrip>>(
+        [origin_city, from, to](IFlightTripDatabase& database) {
+            return database.FindFlightsByOriginCityInTimeWindow(origin_city, from, to);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<double> AsyncFlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                                                  const std::string& destination_city,
+                                                                                  const Timestamp from,
+                                                                                  const Timestamp to,
+                                                                                  const CancellationToken& token)
+{
+    return ToFuture<double>([&](Completion<double> on_complete) {
+        FindMinFareBetweenCitiesInTimeWindow(origin_city, destination_city, from, to, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                                   const std::string& destination_city,
+                                                                   const Timestamp from, const Timestamp to,
+                                                                   Completion<double> on_complete,
+                                                                   const CancellationToken& token)
+{
+    Submit<double>(
+        [origin_city, destination_city, from, to](IFlightTripDatabase& database) {
+            return database.FindMinFareBetweenCitiesInTimeWindow(origin_city, destination_city, from, to);
+        },
+        std::move(on_complete), token);
+}
+
+std::future<double> AsyncFlightTripDatabase::FindMaxFareByOperator(const std::string& operated_by,
+                                                                   const CancellationToken& token)
+{
+    return ToFuture<double>(
+        [&](Completion<double> on_complete) { FindMaxFareByOperator(operated_by, std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::FindMaxFareByOperator(const std::string& operated_by, Completion<double> on_complete,
+                                                    const CancellationToken& token)
+{
+    Submit<double>(
+        [operated_by](IFlightTripDatabase& database) { return database.FindMaxFareByOperator(operated_by); },
+        std::move(on_complete), token);
+}
+
+std::future<std::size_t> AsyncFlightTripDatabase::GetTotalTrips(const CancellationToken& token)
+{
+    return ToFuture<std::size_t>(
+        [&](Completion<std::size_t> on_complete) { GetTotalTrips(std::move(on_complete), token); });
+}
+
+void AsyncFlightTripDatabase::GetTotalTrips(Completion<std::size_t> on_complete, const CancellationToken& token)
+{
+    Submit<std::size_t>([](IFlightTripDatabase& database) { return database.GetTotalTrips(); },
+                        std::move(on_complete), token);
+}
+
+std::future<std::vector<std::vector<FlightTrip>>> AsyncFlightTripDatabase::FindFlightsByNumbers(
+    const std::vector<std::string>& names, const CancellationToken& token)
+{
+    return ToFuture<std::vector<std::vector<FlightTrip>>>(
+        [&](Completion<std::vector<std::vector<FlightTrip>>> on_complete) {
+            FindFlightsByNumbers(names, std::move(on_complete), token);
+        });
+}
+
+void AsyncFlightTripDatabase::FindFlightsByNumbers(const std::vector<std::string>& names,
+                                                   Completion<std::vector<std::vector<FlightTrip>>> on_complete,
+                                                   const CancellationToken& token)
+{
+    Submit<std::vector<std::vector<FlightTrip>>>(
+        [names, token](IFlightTripDatabase& database) {
+            std::vector<std::vector<FlightTrip>> flight_trips;
+            flight_trips.reserve(names.size());
+            for (const auto& name : names)
+            {
+                if (token.IsCancelled())
+                {
+                    throw OperationCancelled{};
+                }
+                flight_trips.push_back(database.FindFlightByNumber(name));
+            }
+            return flight_trips;
+        },
+        std::move(on_complete), token);
+}
+
+std::future<std::vector<double>> AsyncFlightTripDatabase::FindMinFaresBetweenCities(const std::vector<Route>& routes,
+                                                                                    const CancellationToken& token)
+{
+    return ToFuture<std::vector<double>>([&](Completion<std::vector<double>> on_complete) {
+        FindMinFaresBetweenCities(routes, std::move(on_complete), token);
+    });
+}
+
+void AsyncFlightTripDatabase::FindMinFaresBetweenCities(const std::vector<Route>& routes,
+                                                        Completion<std::vector<double>> on_complete,
+                                                        const CancellationToken& token)
+{
+    Submit<std::vector<double>>(
+        [routes, token](IFlightTripDatabase& database) {
+            std::vector<double> min_fares;
+            min_fares.reserve(routes.size());
+            for (const auto& route : routes)
+            {
+                if (token.IsCancelled())
+                {
+                    throw OperationCancelled{};
+                }
+                min_fares.push_back(database.FindMinFareBetweenCities(route.first, route.second));
+            }
+            return min_fares;
+        },
+        std::move(on_complete), token);
+}
+
+void AsyncFlightTripDatabase::Forward(std::future<void>& result, std::promise<void>& promise)
+{
+    try
+    {
+        result.get();
+        promise.set_value();
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+}  // namespace fms
@@ -0,0 +1,321 @@
+///
+/// @file async_flight_trip_database.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_ASYNC_FLIGHT_TRIP_DATABASE_H_
+#define FLIGHT_MANAGEMENT_ASYNC_FLIGHT_TRIP_DATABASE_H_
+
+#include "flight_management/cancellation_token.h"
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/serial_executor.h"
+
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief Asynchronous front-end of Flight Trip Database.
+///
+/// Each operation is queued on an executor owned by the database and returns immediately, so that the calling (i.e.
+/// event loop) thread never blocks on a slow scan and may keep many operations in flight. Each operation either
+/// returns a future or takes a completion callback, which is called once the operation is done and lets event loops
+/// continue without blocking on or polling futures. Operations are executed one after another in submission order,
+/// hence the wrapped database needs no synchronization.
+///
+/// Cancellation only takes effect before an operation starts: operations whose token is cancelled by then are skipped
+/// and complete with OperationCancelled, running operations are not interrupted (batched lookups check their token
+/// between lookups).
+class AsyncFlightTripDatabase
+{
+  public:
+    /// @brief Route (origin city, destination city)
+    using Route = std::pair<std::string, std::string>;
+
+    /// @brief Completion callback, called on the executor thread with the ready future of the operation, holding its
+    ///        result, OperationCancelled or the exception thrown by the operation (get() never blocks). Callbacks
+    ///        delay later operations, hence should only hand the result over (i.e. to an event loop) and must not
+    ///        throw.
+    template <typename Result>
+    using Completion = std::function<void(std::future<Result>)>;
+
+    /// @brief Constructor
+    /// @param database[in] - Database to run the operations on
+    explicit AsyncFlightTripDatabase(std::unique_ptr<IFlightTripDatabase> database);
+
+    /// @brief Add Flight Trip to the Database (see IFlightTripDatabase::AddTrip)
+    std::future<void> AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                              const std::string& destination, const double& fare,
+                              const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                 const std::string& destination, const double& fare, Completion<void> on_complete,
+                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Add scheduled Flight Trip to the Database (see IFlightTripDatabase::AddTrip)
+    std::future<void> AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                              const std::string& destination, const double& fare, const Timestamp departure_time,
+                              const Timestamp arrival_time, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                 const std::string& destination, const double& fare, const Timestamp departure_time,
+                 const Timestamp arrival_time, Completion<void> on_complete,
+                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Remove Trip from the database (see IFlightTripDatabase::RemoveTrip)
+    std::future<void> RemoveTrip(const std::string& name, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void RemoveTrip(const std::string& name, Completion<void> on_complete,
+                    const CancellationToken& token = CancellationToken{});
+
+    /// @brief Remove one departure of a Trip from the database (see IFlightTripDatabase::RemoveTrip)
+    std::future<void> RemoveTrip(const std::string& name, const Timestamp departure_time,
+                                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void RemoveTrip(const std::string& name, const Timestamp departure_time, Completion<void> on_complete,
+                    const CancellationToken& token = CancellationToken{});
+
+    /// @brief Update Flight Fare for the provided Trip (see IFlightTripDatabase::UpdateFareByTrip)
+    std::future<void> UpdateFareByTrip(const std::string& name, const double& fare,
+                                       const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void UpdateFareByTrip(const std::string& name, const double& fare, Completion<void> on_complete,
+                          const CancellationToken& token = CancellationToken{});
+
+    /// @brief Update Flight Fare for one departure of the provided Trip (see IFlightTripDatabase::UpdateFareByTrip)
+    std::future<void> UpdateFareByTrip(const std::string& name, const Timestamp departure_time, const double& fare,
+                                       const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void UpdateFareByTrip(const std::string& name, const Timestamp departure_time, const double& fare,
+                          Completion<void> on_complete, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Update Flight Fare for the provided Operator (see IFlightTripDatabase::UpdateFareByOperator)
+    std::future<void> UpdateFareByOperator(const std::string& operated_by, const double& fare,
+                                           const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void UpdateFareByOperator(const std::string& operated_by, const double& fare, Completion<void> on_complete,
+                              const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips by flight number/name (see IFlightTripDatabase::FindFlightByNumber)
+    std::future<std::vector<FlightTrip>> FindFlightByNumber(const std::string& name,
+                                                            const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightByNumber(const std::string& name, Completion<std::vector<FlightTrip>> on_complete,
+                            const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips by flight origin city (see IFlightTripDatabase::FindFlightsByOriginCity)
+    std::future<std::vector<FlightTrip>> FindFlightsByOriginCity(const std::string& origin_city,
+                                                                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightsByOriginCity(const std::string& origin_city, Completion<std::vector<FlightTrip>> on_complete,
+                                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips by flight number/name prefix (see IFlightTripDatabase::FindFlightsByNumberPrefix)
+    std::future<std::vector<FlightTrip>> FindFlightsByNumberPrefix(const std::string& prefix,
+                                                                   const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightsByNumberPrefix(const std::string& prefix, Completion<std::vector<FlightTrip>> on_complete,
+                                   const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips by origin city prefix (see IFlightTripDatabase::FindFlightsByOriginCityPrefix)
+    std::future<std::vector<FlightTrip>> FindFlightsByOriginCityPrefix(
+        const std::string& prefix, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightsByOriginCityPrefix(const std::string& prefix, Completion<std::vector<FlightTrip>> on_complete,
+                                       const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find average cost of all the trips (see IFlightTripDatabase::FindAverageCostOfAllTrips)
+    std::future<double> FindAverageCostOfAllTrips(const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindAverageCostOfAllTrips(Completion<double> on_complete,
+                                   const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find minimum fare between provided cities (see IFlightTripDatabase::FindMinFareBetweenCities)
+    std::future<double> FindMinFareBetweenCities(const std::string& origin_city, const std::string& destination_city,
+                                                 const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindMinFareBetweenCities(const std::string& origin_city, const std::string& destination_city,
+                                  Completion<double> on_complete, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips from origin city within time window (see
+    ///        IFlightTripDatabase::FindFlightsByOriginCityInTimeWindow)
+    std::future<std::vector<FlightTrip>> FindFlightsByOriginCityInTimeWindow(
+        const std::string& origin_city, const Timestamp from, const Timestamp to,
+        const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightsByOriginCityInTimeWindow(const std::string& origin_city, const Timestamp from, const Timestamp to,
+                                             Completion<std::vector<FlightTrip>> on_complete,
+                                             const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find minimum fare between provided cities within time window (see
+    ///        IFlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow)
+    std::future<double> FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                             const std::string& destination_city, const Timestamp from,
+                                                             const Timestamp to,
+                                                             const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city, const std::string& destination_city,
+                                              const Timestamp from, const Timestamp to, Completion<double> on_complete,
+                                              const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find maximum fare from provided operator (see IFlightTripDatabase::FindMaxFareByOperator)
+    std::future<double> FindMaxFareByOperator(const std::string& operated_by,
+                                              const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindMaxFareByOperator(const std::string& operated_by, Completion<double> on_complete,
+                               const CancellationToken& token = CancellationToken{});
+
+    /// @brief Get Total number of trips in database (see IFlightTripDatabase::GetTotalTrips)
+    std::future<std::size_t> GetTotalTrips(const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void GetTotalTrips(Completion<std::size_t> on_complete, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find flight trips for a batch of flight numbers/names in one executor task
+    ///
+    /// @param names[in] - Flight Numbers/names to search
+    /// @param token[in] - Cancellation token
+    ///
+    /// @return flight_trips - list of flight trips for each name (same order as names)
+    std::future<std::vector<std::vector<FlightTrip>>> FindFlightsByNumbers(
+        const std::vector<std::string>& names, const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindFlightsByNumbers(const std::vector<std::string>& names,
+                              Completion<std::vector<std::vector<FlightTrip>>> on_complete,
+                              const CancellationToken& token = CancellationToken{});
+
+    /// @brief Find minimum fares for a batch of routes in one executor task
+    ///
+    /// @param routes[in] - Routes (origin city, destination city) to search
+    /// @param token[in] - Cancellation token
+    ///
+    /// @return min_fares - minimum fare for each route (same order as routes)
+    std::future<std::vector<double>> FindMinFaresBetweenCities(const std::vector<Route>& routes,
+                                                               const CancellationToken& token = CancellationToken{});
+
+    /// @brief Same as above, calls on_complete instead of returning a future
+    void FindMinFaresBetweenCities(const std::vector<Route>& routes, Completion<std::vector<double>> on_complete,
+                                   const CancellationToken& token = CancellationToken{});
+
+    /// @brief Run custom operation on the database executor
+    ///
+    /// @param operation[in] - Callable taking IFlightTripDatabase& and returning Result
+    /// @param token[in] - Cancellation token
+    ///
+    /// @return result - future result of the operation
+    template <typename Result, typename Operation>
+    std::future<Result> Submit(Operation operation, const CancellationToken& token = CancellationToken{})
+    {
+        return ToFuture<Result>([&](Completion<Result> on_complete) {
+            Submit<Result>(std::move(operation), std::move(on_complete), token);
+        });
+    }
+
+    /// @brief Run custom operation on the database executor, calling on_complete once it is done
+    ///
+    /// @param operation[in] - Callable taking IFlightTripDatabase& and returning Result
+    /// @param on_complete[in] - Called with the ready future of the operation (see Completion)
+    /// @param token[in] - Cancellation token
+    template <typename Result, typename Operation>
+    void Submit(Operation operation, Completion<Result> on_complete,
+                const CancellationToken& token = CancellationToken{})
+    {
+        executor_.Post([this, operation, on_complete, token]() mutable {
+            std::promise<Result> promise;
+            if (token.IsCancelled())
+            {
+                promise.set_exception(std::make_exception_ptr(OperationCancelled{}));
+            }
+            else
+            {
+                try
+                {
+                    Fulfil(promise, operation);
+                }
+                catch (...)
+                {
+                    promise.set_exception(std::current_exception());
+                }
+            }
+            on_complete(promise.get_future());
+        });
+    }
+
+  private:
+    /// @brief Start operation with a completion which fulfils the returned future
+    ///
+    /// @param start[in] - Callable taking the completion and submitting the operation with it
+    ///
+    /// @return result - future result of the operation
+    template <typename Result, typename Start>
+    static std::future<Result> ToFuture(Start start)
+    {
+        auto promise = std::make_shared<std::promise<Result>>();
+        auto future = promise->get_future();
+        start([promise](std::future<Result> result) { Forward(result, *promise); });
+        return future;
+    }
+
+    /// @brief Move result or exception of ready future to promise
+    template <typename Result>
+    static void Forward(std::future<Result>& result, std::promise<Result>& promise)
+    {
+        try
+        {
+            promise.set_value(result.get());
+        }
+        catch (...)
+        {
+            promise.set_exception(std::current_exception());
+        }
+    }
+
+    /// @brief Move completion or exception of ready future to promise (operations without result)
+    static void Forward(std::future<void>& result, std::promise<void>& promise);
+
+    /// @brief Run operation and set its result on the promise
+    template <typename Result, typename Operation>
+    void Fulfil(std::promise<Result>& promise, Operation& operation)
+    {
+        promise.set_value(operation(*database_));
+    }
+
+    /// @brief Run operation and mark the promise ready (operations without result)
+    template <typename Operation>
+    void Fulfil(std::promise<void>& promise, Operation& operation)
+    {
+        operation(*database_);
+        promise.set_value();
+    }
+
+    /// @brief Wrapped database, accessed only from executor thread
+    std::unique_ptr<IFlightTripDatabase> database_;
+
+    /// @brief Executor running the operations (declared last, so that it finishes pending operations first)
+    SerialExecutor executor_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_ASYNC_FLIGHT_TRIP_DATABASE_H_
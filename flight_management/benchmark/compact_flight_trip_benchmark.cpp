@@ -0,0 +1,86 @@
+///
+/// @file compact_flight_trip_benchmark.cpp
+/// @brief Compares footprint and scan speed of FlightTrip and CompactFlightTrip tables.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/cache_aligned_allocator.h"
+#include "flight_management/compact_flight_trip.h"
+#include "flight_management/flight_trip.h"
+#include "flight_management/string_dictionary.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+constexpr std::size_t kNumberOfCities{100U};
+
+std::vector<FlightTrip> MakeTrips(const std::size_t number_of_trips)
+{
+    std::vector<FlightTrip> trips;
+    trips.reserve(number_of_trips);
+    for (std::size_t idx = 0U; idx < number_of_trips; ++idx)
+    {
+        trips.push_back(FlightTrip{"FL-" + std::to_string(idx), "Operator-" + std::to_string(idx % 10U),
+                                   "City-" + std::to_string(idx % kNumberOfCities),
+                                   "City-" + std::to_string((idx / kNumberOfCities) % kNumberOfCities),
+                                   static_cast<double>(idx % 9000U) + 1000.0});
+    }
+    return trips;
+}
+
+void BM_ScanFlightTrip(benchmark::State& state)
+{
+    const auto trips = MakeTrips(static_cast<std::size_t>(state.range(0)));
+    const std::string origin_city{"City-42"};
+    for (auto _ : state)
+    {
+        double min_fare = std::numeric_limits<double>::max();
+        for (const auto& trip : trips)
+        {
+            if (trip.origin_city == origin_city)
+            {
+                min_fare = std::min(min_fare, trip.fare);
+            }
+        }
+        benchmark::DoNotOptimize(min_fare);
+    }
+    state.counters["bytes_per_trip"] = sizeof(FlightTrip);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * trips.size() * sizeof(FlightTrip)));
+}
+
+void BM_ScanCompactFlightTrip(benchmark::State& state)
+{
+    StringDictionary dictionary{};
+    std::vector<CompactFlightTrip, CacheAlignedAllocator<CompactFlightTrip>> trips;
+    for (const auto& trip : MakeTrips(static_cast<std::size_t>(state.range(0))))
+    {
+        trips.push_back(ToCompactFlightTrip(trip, dictionary));
+    }
+    const auto origin_city = dictionary.Find("City-42");
+    for (auto _ : state)
+    {
+        double min_fare = std::numeric_limits<double>::max();
+        for (const auto& trip : trips)
+        {
+            if (trip.origin_city == origin_city)
+            {
+                min_fare = std::min(min_fare, trip.fare);
+            }
+        }
+        benchmark::DoNotOptimize(min_fare);
+    }
+    state.counters["bytes_per_trip"] = sizeof(CompactFlightTrip);
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * trips.size() * sizeof(CompactFlightTrip)));
+}
+
+BENCHMARK(BM_ScanFlightTrip)->Arg(1 << 20);
+BENCHMARK(BM_ScanCompactFlightTrip)->Arg(1 << 20);
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,168 @@
+///
+/// @file fare_kernels_benchmark.cpp
+/// @brief Compares floating-point and fixed-point fare aggregation.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/fare.h"
+#include "flight_management/fare_kernels.h"
+#include "flight_management/flight_trip_database.h"
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+std::vector<double> MakeFares(const std::size_t number_of_fares)
+{
+    std::vector<double> fares;
+    fares.reserve(number_of_fares);
+    for (std::size_t idx = 0U; idx < number_of_fares; ++idx)
+    {
+        fares.push_back(1000.0 + static_cast<double>(idx % 900000U) / 100.0);
+    }
+    return fares;
+}
+
+std::vector<FixedPointFare> MakeFixedPointFares(const std::size_t number_of_fares)
+{
+    const auto fares = MakeFares(number_of_fares);
+    std::vector<FixedPointFare> fixed_point_fares(fares.size());
+    std::transform(fares.begin(), fares.end(), fixed_point_fares.begin(), ToFixedPointFare);
+    return fixed_point_fares;
+}
+
+void BM_SumFloatingPointFares(benchmark::State& state)
+{
+    const auto fares = MakeFares(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        double sum = 0.0;
+        for (const auto fare : fares)
+        {
+            sum += fare;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void BM_SumFixedPointFares(benchmark::State& state)
+{
+    const auto fares = MakeFixedPointFares(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(SumFares(fares.data(), fares.size()));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void BM_MinMaxFloatingPointFares(benchmark::State& state)
+{
+    const auto fares = MakeFares(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        double min_fare = std::numeric_limits<double>::max();
+        double max_fare = std::numeric_limits<double>::lowest();
+        for (const auto fare : fares)
+        {
+            min_fare = std::min(min_fare, fare);
+            max_fare = std::max(max_fare, fare);
+        }
+        benchmark::DoNotOptimize(min_fare);
+        benchmark::DoNotOptimize(max_fare);
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void BM_MinMaxFixedPointFares(benchmark::State& state)
+{
+    const auto fares = MakeFixedPointFares(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FindMinFare(fares.data(), fares.size()));
+        benchmark::DoNotOptimize(FindMaxFare(fares.data(), fares.size()));
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void AddTrips(FlightTripDatabase& database, const std::vector<double>& fares)
+{
+    for (std::size_t idx = 0U; idx < fares.size(); ++idx)
+    {
+        database.AddTrip("FL-" + std::to_string(idx), "Operator-" + std::to_string(idx % 10U),
+                         "City-" + std::to_string(idx % 100U), "City-" + std::to_string((idx / 100U) % 100U),
+                         fares[idx], static_cast<Timestamp>(idx), static_cast<Timestamp>(idx));
+    }
+}
+
+const char* GetLabel(const FareRepresentation fare_representation)
+{
+    return (fare_representation == FareRepresentation::kFixedPoint) ? "fixed_point" : "floating_point";
+}
+
+void BM_FindAverageCostOfAllTrips(benchmark::State& state)
+{
+    const auto fare_representation = static_cast<FareRepresentation>(state.range(1));
+    FlightTripDatabase database{fare_representation};
+    const auto fares = MakeFares(static_cast<std::size_t>(state.range(0)));
+    AddTrips(database, fares);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(database.FindAverageCostOfAllTrips());
+    }
+    state.SetLabel(GetLabel(fare_representation));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void BM_FindMaxFareByOperator(benchmark::State& state)
+{
+    const auto fare_representation = static_cast<FareRepresentation>(state.range(1));
+    FlightTripDatabase database{fare_representation};
+    const auto fares = MakeFares(static_cast<std::size_t>(state.range(0)));
+    AddTrips(database, fares);
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(database.FindMaxFareByOperator("Operator-3"));
+    }
+    state.SetLabel(GetLabel(fare_representation));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * fares.size()));
+}
+
+void BM_FindMinFareBetweenCitiesInTimeWindow(benchmark::State& state)
+{
+    const auto fare_representation = static_cast<FareRepresentation>(state.range(1));
+    FlightTripDatabase database{fare_representation};
+    const auto fares = MakeFares(static_cast<std::size_t>(state.range(0)));
+    AddTrips(database, fares);
+    // Route City-3 to City-0 departs once every 10000 trips, the window covers all of them
+    const auto route_trips = fares.size() / 10000U;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(database.FindMinFareBetweenCitiesInTimeWindow(
+            "City-3", "City-0", 0, static_cast<Timestamp>(fares.size())));
+    }
+    state.SetLabel(GetLabel(fare_representation));
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * route_trips));
+}
+
+BENCHMARK(BM_SumFloatingPointFares)->Arg(1 << 20);
+BENCHMARK(BM_SumFixedPointFares)->Arg(1 << 20);
+BENCHMARK(BM_MinMaxFloatingPointFares)->Arg(1 << 20);
+BENCHMARK(BM_MinMaxFixedPointFares)->Arg(1 << 20);
+BENCHMARK(BM_FindAverageCostOfAllTrips)
+    ->Args({1 << 18, static_cast<std::int64_t>(FareRepresentation::kFloatingPoint)})
+    ->Args({1 << 18, static_cast<std::int64_t>(FareRepresentation::kFixedPoint)});
+BENCHMARK(BM_FindMaxFareByOperator)
+    ->Args({1 << 20, static_cast<std::int64_t>(FareRepresentation::kFloatingPoint)})
+    ->Args({1 << 20, static_cast<std::int64_t>(FareRepresentation::kFixedPoint)});
+BENCHMARK(BM_FindMinFareBetweenCitiesInTimeWindow)
+    ->Args({1 << 20, static_cast<std::int64_t>(FareRepresentation::kFloatingPoint)})
+    ->Args({1 << 20, static_cast<std::int64_t>(FareRepresentation::kFixedPoint)});
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,96 @@
+///
+/// @file query_cache_benchmark.cpp
+/// @brief Compares cached and uncached queries for Zipf distributed (skewed) traffic.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/benchmark/zipf_distribution.h"
+#include "flight_management/cached_flight_trip_database.h"
+#include "flight_management/flight_trip_database.h"
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace fms
+{
+namespace
+{
+constexpr std::size_t kNumberOfTrips{20000U};
+constexpr std::size_t kNumberOfCities{200U};
+constexpr std::size_t kNumberOfOperators{40U};
+constexpr std::size_t kCacheCapacity{512U};
+constexpr std::size_t kMutationEveryNthQuery{100U};
+
+std::string City(const std::size_t idx) { return "City-" + std::to_string(idx); }
+
+std::string Operator(const std::size_t idx) { return "Operator-" + std::to_string(idx); }
+
+std::string Flight(const std::size_t idx) { return "FL-" + std::to_string(idx); }
+
+void PopulateDatabase(IFlightTripDatabase& database)
+{
+    std::mt19937 generator{42U};
+    ZipfDistribution city{kNumberOfCities, 1.0};
+    ZipfDistribution airline{kNumberOfOperators, 1.0};
+    std::uniform_real_distribution<double> fare{1000.0, 20000.0};
+    for (std::size_t idx = 0U; idx < kNumberOfTrips; ++idx)
+    {
+        database.AddTrip(Flight(idx), Operator(airline(generator)), City(city(generator)), City(city(generator)),
+                         fare(generator));
+    }
+}
+
+/// @brief Zipf distributed query mix with occasional fare updates
+template <typename Database>
+void RunQueryMix(benchmark::State& state, Database& database)
+{
+    std::mt19937 generator{7U};
+    ZipfDistribution city{kNumberOfCities, static_cast<double>(state.range(0)) / 10.0};
+    ZipfDistribution airline{kNumberOfOperators, static_cast<double>(state.range(0)) / 10.0};
+    std::uniform_int_distribution<std::size_t> trip{0U, kNumberOfTrips - 1U};
+
+    std::size_t iteration = 0U;
+    for (auto _ : state)
+    {
+        switch (iteration % 3U)
+        {
+            case 0U:
+                benchmark::DoNotOptimize(
+                    database.FindMinFareBetweenCities(City(city(generator)), City(city(generator))));
+                break;
+            case 1U:
+                benchmark::DoNotOptimize(database.FindFlightsByOriginCity(City(city(generator))));
+                break;
+            default:
+                benchmark::DoNotOptimize(database.FindMaxFareByOperator(Operator(airline(generator))));
+                break;
+        }
+        if ((++iteration % kMutationEveryNthQuery) == 0U)
+        {
+            database.UpdateFareByTrip(Flight(trip(generator)), 1000.0);
+        }
+    }
+}
+
+void BM_UncachedQueries(benchmark::State& state)
+{
+    FlightTripDatabase database{};
+    PopulateDatabase(database);
+    RunQueryMix(state, database);
+}
+
+void BM_CachedQueries(benchmark::State& state)
+{
+    CachedFlightTripDatabase database{std::make_unique<FlightTripDatabase>(), kCacheCapacity};
+    PopulateDatabase(database);
+    RunQueryMix(state, database);
+    state.counters["hit_rate"] = database.GetStatistics().HitRate();
+}
+
+/// @note Argument is Zipf exponent * 10
+BENCHMARK(BM_UncachedQueries)->Arg(8)->Arg(12);
+BENCHMARK(BM_CachedQueries)->Arg(8)->Arg(12);
+
+}  // namespace
+}  // namespace fms
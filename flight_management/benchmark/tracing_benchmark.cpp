@@ -0,0 +1,73 @@
+///
+/// @file tracing_benchmark.cpp
+/// @brief Measures overhead of trace spans on database lookups at different sampling rates.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/tracing.h"
+
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+
+namespace fms
+{
+namespace
+{
+/// @brief Sampling rates, indexed by benchmark argument
+constexpr double kSamplingRates[]{0.0, 0.01, 1.0};
+
+void BM_EmptySpan(benchmark::State& state)
+{
+    tracing::SetSamplingRate(kSamplingRates[state.range(0)]);
+    std::size_t spans = 0U;
+    for (auto _ : state)
+    {
+        TRACE_SPAN("EmptySpan");
+        benchmark::DoNotOptimize(++spans);
+        if ((spans % tracing::kTraceBufferCapacity) == 0U)
+        {
+            // Keep buffer from overflowing, so that recording (not dropping) is measured
+            state.PauseTiming();
+            std::stringstream trace;
+            tracing::ExportChromeTrace(trace);
+            state.ResumeTiming();
+        }
+    }
+    tracing::SetSamplingRate(0.0);
+    state.SetLabel("sampling_rate=" + std::to_string(kSamplingRates[state.range(0)]));
+}
+
+void BM_FindFlightByNumber(benchmark::State& state)
+{
+    constexpr std::size_t kNumberOfTrips{1U << 16U};
+    FlightTripDatabase database;
+    for (std::size_t idx = 0U; idx < kNumberOfTrips; ++idx)
+    {
+        database.AddTrip("FL-" + std::to_string(idx), "Operator-" + std::to_string(idx % 10U),
+                         "City-" + std::to_string(idx % 100U), "City-" + std::to_string((idx / 100U) % 100U),
+                         1000.0 + static_cast<double>(idx));
+    }
+
+    tracing::SetSamplingRate(kSamplingRates[state.range(0)]);
+    std::size_t idx = 0U;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(database.FindFlightByNumber("FL-" + std::to_string(idx++ % kNumberOfTrips)));
+        if ((idx % 1024U) == 0U)
+        {
+            state.PauseTiming();
+            std::stringstream trace;
+            tracing::ExportChromeTrace(trace);
+            state.ResumeTiming();
+        }
+    }
+    tracing::SetSamplingRate(0.0);
+    state.SetLabel("sampling_rate=" + std::to_string(kSamplingRates[state.range(0)]));
+}
+
+BENCHMARK(BM_EmptySpan)->DenseRange(0, 2);
+BENCHMARK(BM_FindFlightByNumber)->DenseRange(0, 2);
+
+}  // namespace
+}  // namespace fms
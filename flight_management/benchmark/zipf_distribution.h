@@ -0,0 +1,61 @@
+///
+/// @file zipf_distribution.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_BENCHMARK_ZIPF_DISTRIBUTION_H_
+#define FLIGHT_MANAGEMENT_BENCHMARK_ZIPF_DISTRIBUTION_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace fms
+{
+/// @brief Zipf distributed random ranks in [0, number_of_elements), rank 0 being the most frequent one
+class ZipfDistribution
+{
+  public:
+    /// @brief Constructor
+    ///
+    /// @param number_of_elements[in] - Number of distinct ranks
+    /// @param exponent[in] - Skew of distribution (0.0 uniform, ~1.0 typical real world skew)
+    ZipfDistribution(const std::size_t number_of_elements, const double exponent)
+        : cumulative_probabilities_(number_of_elements), uniform_{0.0, 1.0}
+    {
+        double sum = 0.0;
+        for (std::size_t rank = 0U; rank < number_of_elements; ++rank)
+        {
+            sum += 1.0 / std::pow(static_cast<double>(rank + 1U), exponent);
+            cumulative_probabilities_[rank] = sum;
+        }
+        std::for_each(cumulative_probabilities_.begin(), cumulative_probabilities_.end(),
+                      [sum](auto& probability) { probability /= sum; });
+    }
+
+    /// @brief Draw next rank
+    ///
+    /// @param generator[in] - Uniform random bit generator
+    ///
+    /// @return rank - Zipf distributed rank
+    template <typename Generator>
+    std::size_t operator()(Generator& generator)
+    {
+        const auto it = std::lower_bound(cumulative_probabilities_.begin(), cumulative_probabilities_.end(),
+                                         uniform_(generator));
+        return std::min(static_cast<std::size_t>(std::distance(cumulative_probabilities_.begin(), it)),
+                        cumulative_probabilities_.size() - 1U);
+    }
+
+  private:
+    /// @brief Cumulative probability for each rank
+    std::vector<double> cumulative_probabilities_;
+
+    /// @brief Uniform distribution used for inverse transform sampling
+    std::uniform_real_distribution<double> uniform_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_BENCHMARK_ZIPF_DISTRIBUTION_H_
@@ -0,0 +1,61 @@
+///
+/// @file cache_aligned_allocator.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_CACHE_ALIGNED_ALLOCATOR_H_
+#define FLIGHT_MANAGEMENT_CACHE_ALIGNED_ALLOCATOR_H_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace fms
+{
+/// @brief Size of a cache line in bytes
+constexpr std::size_t kCacheLineSize{64U};
+
+/// @brief Allocator which aligns storage to cache line boundary (i.e. for std::vector of compact records)
+///
+/// @tparam T - Allocated type
+template <typename T>
+struct CacheAlignedAllocator
+{
+    using value_type = T;
+
+    CacheAlignedAllocator() = default;
+
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U>&)
+    {
+    }
+
+    /// @brief Allocate cache line aligned storage for n objects
+    T* allocate(const std::size_t n)
+    {
+        void* storage = nullptr;
+        if (posix_memalign(&storage, kCacheLineSize, n * sizeof(T)) != 0)
+        {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(storage);
+    }
+
+    /// @brief Release storage allocated with allocate()
+    void deallocate(T* storage, const std::size_t) { std::free(storage); }
+};
+
+template <typename T, typename U>
+bool operator==(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&)
+{
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const CacheAlignedAllocator<T>&, const CacheAlignedAllocator<U>&)
+{
+    return false;
+}
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_CACHE_ALIGNED_ALLOCATOR_H_
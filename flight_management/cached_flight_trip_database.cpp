@@ -0,0 +1,227 @@
+///
+/// @file cached_flight_trip_database.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/cached_flight_trip_database.h"
+#include "flight_management/logging.h"
+
+#include <algorithm>
+
+namespace fms
+{
+CachedFlightTripDatabase::CachedFlightTripDatabase(std::unique_ptr<IFlightTripDatabase> database,
+                                                   const std::size_t capacity)
+    : database_{std::move(database)},
+      trips_by_origin_city_{capacity},
+      min_fare_by_route_{capacity},
+      max_fare_by_operator_{capacity},
+      routes_by_operator_{},
+      statistics_{0U, 0U, 0U, 0U}
+{
+    ASSERT_CHECK(database_) << "Cached database requires an underlying database";
+    ASSERT_CHECK_EQ(0U, database_->GetTotalTrips()) << "Cached database requires an empty underlying database";
+}
+
+void CachedFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                       const std::string& origin, const std::string& destination, const double& fare)
+{
+    AddTrip(name, operated_by, origin, destination, fare, 0, 0);
+}
+
+void CachedFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                       const std::string& origin, const std::string& destination, const double& fare,
+                                       const Timestamp departure_time, const Timestamp arrival_time)
+{
+    const auto total_trips = database_->GetTotalTrips();
+    database_->AddTrip(name, operated_by, origin, destination, fare, departure_time, arrival_time);
+    if (database_->GetTotalTrips() == total_trips)
+    {
+        // Rejected by underlying database, nothing to count or invalidate
+        return;
+    }
+
+    const FlightTrip trip{name, operated_by, origin, destination, fare, departure_time, arrival_time};
+    Invalidate(trip);
+    ++routes_by_operator_[operated_by][Route{origin, destination}];
+}
+
+void CachedFlightTripDatabase::RemoveTrip(const std::string& name)
+{
+    const auto removed_trips = database_->FindFlightByNumber(name);
+    database_->RemoveTrip(name);
+    Forget(removed_trips);
+}
+
+void CachedFlightTripDatabase::RemoveTrip(const std::string& name, const Timestamp departure_time)
+{
+    auto removed_trips = database_->FindFlightByNumber(name);
+    removed_trips.erase(
+        std::remove_if(removed_trips.begin(), removed_trips.end(),
+                       [departure_time](const auto& trip) { return trip.departure_time != departure_time; }),
+        removed_trips.end());
+    database_->RemoveTrip(name, departure_time);
+    Forget(removed_trips);
+}
+
+void CachedFlightTripDatabase::UpdateFareByTrip(const std::string& name, const double& fare)
+{
+    const auto updated_trips = database_->FindFlightByNumber(name);
+    database_->UpdateFareByTrip(name, fare);
+
+    std::for_each(updated_trips.begin(), updated_trips.end(), [&](const auto& trip) { Invalidate(trip); });
+}
+
+void CachedFlightTripDatabase::UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                                const double& fare)
+{
+    const auto updated_trips = database_->FindFlightByNumber(name);
+    database_->UpdateFareByTrip(name, departure_time, fare);
+
+    std::for_each(updated_trips.begin(), updated_trips.end(), [&](const auto& trip) {
+        if (trip.departure_time == departure_time)
+        {
+            Invalidate(trip);
+        }
+    });
+}
+
+void CachedFlightTripDatabase::UpdateFareByOperator(const std::string& operated_by, const double& fare)
+{
+    database_->UpdateFareByOperator(operated_by, fare);
+
+    statistics_.invalidations += max_fare_by_operator_.Erase(operated_by) ? 1U : 0U;
+    const auto routes = routes_by_operator_.find(operated_by);
+    if (routes != routes_by_operator_.end())
+    {
+        std::for_each(routes->second.begin(), routes->second.end(),
+                      [&](const auto& route) { Invalidate(route.first); });
+    }
+}
+
+void CachedFlightTripDatabase::DisplayAllTrips() const { database_->DisplayAllTrips(); }
+
+std::vector<FlightTrip> CachedFlightTripDatabase::FindFlightByNumber(const std::string& name) const
+{
+    return database_->FindFlightByNumber(name);
+}
+
+std::vector<FlightTrip> CachedFlightTripDatabase::FindFlightsByOriginCity(const std::string& origin_city) const
+{
+    const auto cached = trips_by_origin_city_.Find(origin_city);
+    if (cached != nullptr)
+    {
+        ++statistics_.hits;
+        return *cached;
+    }
+
+    ++statistics_.misses;
+    auto trips = database_->FindFlightsByOriginCity(origin_city);
+    trips_by_origin_city_.Insert(origin_city, trips);
+    return trips;
+}
+
+std::vector<FlightTrip> CachedFlightTripDatabase::FindFlightsByNumberPrefix(const std::string& prefix) const
+{
+    return database_->FindFlightsByNumberPrefix(prefix);
+}
+
+std::vector<FlightTrip> CachedFlightTripDatabase::FindFlightsByOriginCityPrefix(const std::string& prefix) const
+{
+    return database_->FindFlightsByOriginCityPrefix(prefix);
+}
+
+double CachedFlightTripDatabase::FindAverageCostOfAllTrips() const { return database_->FindAverageCostOfAllTrips(); }
+
+double CachedFlightTripDatabase::FindMinFareBetweenCities(const std::string& origin_city,
+                                                          const std::string& destination_city) const
+{
+    const Route route{origin_city, destination_city};
+    const auto cached = min_fare_by_route_.Find(route);
+    if (cached != nullptr)
+    {
+        ++statistics_.hits;
+        return *cached;
+    }
+
+    ++statistics_.misses;
+    const auto min_fare = database_->FindMinFareBetweenCities(origin_city, destination_city);
+    min_fare_by_route_.Insert(route, min_fare);
+    return min_fare;
+}
+
+std::vector<FlightTrip> CachedFlightTripDatabase::FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                                      const Timestamp from,
+                                                                                      const Timestamp to) const
+{
+    return database_->FindFlightsByOriginCityInTimeWindow(origin_city, from, to);
+}
+
+double CachedFlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                                      const std::string& destination_city,
+                                                                      const Timestamp from, const Timestamp to) const
+{
+    return database_->FindMinFareBetweenCitiesInTimeWindow(origin_city, destination_city, from, to);
+}
+
+double CachedFlightTripDatabase::FindMaxFareByOperator(const std::string& operated_by) const
+{
+    const auto cached = max_fare_by_operator_.Find(operated_by);
+    if (cached != nullptr)
+    {
+        ++statistics_.hits;
+        return *cached;
+    }
+
+    ++statistics_.misses;
+    const auto max_fare = database_->FindMaxFareByOperator(operated_by);
+    max_fare_by_operator_.Insert(operated_by, max_fare);
+    return max_fare;
+}
+
+std::size_t CachedFlightTripDatabase::GetTotalTrips(void) const { return database_->GetTotalTrips(); }
+
+void CachedFlightTripDatabase::Execute(const FlightTripQuery& query, const TripConsumer& consumer) const
+{
+    database_->Execute(query, consumer);
+}
+
+QueryCacheStatistics CachedFlightTripDatabase::GetStatistics() const
+{
+    auto statistics = statistics_;
+    statistics.evictions = trips_by_origin_city_.Evictions() + min_fare_by_route_.Evictions() +
+                           max_fare_by_operator_.Evictions();
+    return statistics;
+}
+
+void CachedFlightTripDatabase::Forget(const std::vector<FlightTrip>& removed_trips)
+{
+    for (const auto& trip : removed_trips)
+    {
+        Invalidate(trip);
+
+        auto& routes = routes_by_operator_[trip.operated_by];
+        const auto route = routes.find(Route{trip.origin_city, trip.destination_city});
+        if ((route != routes.end()) && (--route->second == 0U))
+        {
+            routes.erase(route);
+        }
+        if (routes.empty())
+        {
+            routes_by_operator_.erase(trip.operated_by);
+        }
+    }
+}
+
+void CachedFlightTripDatabase::Invalidate(const FlightTrip& trip)
+{
+    statistics_.invalidations += max_fare_by_operator_.Erase(trip.operated_by) ? 1U : 0U;
+    Invalidate(Route{trip.origin_city, trip.destination_city});
+}
+
+void CachedFlightTripDatabase::Invalidate(const Route& route)
+{
+    statistics_.invalidations += trips_by_origin_city_.Erase(route.first) ? 1U : 0U;
+    statistics_.invalidations += min_fare_by_route_.Erase(route) ? 1U : 0U;
+}
+
+}  // namespace fms
@@ -0,0 +1,260 @@
+///
+/// @file cached_flight_trip_database.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_CACHED_FLIGHT_TRIP_DATABASE_H_
+#define FLIGHT_MANAGEMENT_CACHED_FLIGHT_TRIP_DATABASE_H_
+
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/lru_cache.h"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace fms
+{
+/// @brief Query Cache Statistics
+struct QueryCacheStatistics
+{
+    /// @brief Number of queries served from the cache
+    std::size_t hits;
+
+    /// @brief Number of queries forwarded to the database
+    std::size_t misses;
+
+    /// @brief Number of entries evicted due to cache capacity
+    std::size_t evictions;
+
+    /// @brief Number of entries invalidated by mutations
+    std::size_t invalidations;
+
+    /// @brief Ratio of queries served from the cache
+    ///
+    /// @return hit_rate - hits / (hits + misses), 0.0 if no query was made
+    double HitRate() const
+    {
+        const auto lookups = hits + misses;
+        return (lookups == 0U) ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/// @brief Flight Trip Database decorator which caches results of frequent queries.
+///
+/// Results of FindFlightsByOriginCity, FindMinFareBetweenCities and FindMaxFareByOperator are kept in bounded LRU
+/// caches. Each mutation invalidates only the entries whose keys (origin city, route or operator) it touches.
+class CachedFlightTripDatabase : public IFlightTripDatabase
+{
+  public:
+    /// @brief Constructor
+    ///
+    /// @param database[in] - Database to be cached
+    /// @param capacity[in] - Maximum number of cached entries per query
+    explicit CachedFlightTripDatabase(std::unique_ptr<IFlightTripDatabase> database, const std::size_t capacity);
+
+    /// @brief Destructor
+    virtual ~CachedFlightTripDatabase() = default;
+
+    /// @brief Add Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare) override;
+
+    /// @brief Add scheduled Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    /// @param departure_time[in] - Departure time
+    /// @param arrival_time[in] - Arrival time (not before departure time)
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare, const Timestamp departure_time,
+                         const Timestamp arrival_time) override;
+
+    /// @brief Remove Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    ///                   If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name) override;
+
+    /// @brief Remove one departure of a Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    /// @param departure_time[in] - Departure time of the trip to be deleted
+    ///                             If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name, const Timestamp departure_time) override;
+
+    /// @brief Update Flight Fare for the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    ///                   If trip does not exist, function does nothing.
+    virtual void UpdateFareByTrip(const std::string& name, const double& fare) override;
+
+    /// @brief Update Flight Fare for one departure of the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    /// @param departure_time[in] - Departure time of the trip to be updated
+    ///                             If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                  const double& fare) override;
+
+    /// @brief Update Flight Fare for the provided Trip
+    /// @param operated_by[in] - Flight operator to be updated in Database
+    ///                          If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByOperator(const std::string& operated_by, const double& fare) override;
+
+    /// @brief Display all trips in database
+    virtual void DisplayAllTrips() const override;
+
+    /// @brief Find flight trips by flight number/name
+    ///
+    /// @param name[in] - Flight Number/name to search
+    ///
+    /// @return flight_trips - list of flight trips
+    virtual std::vector<FlightTrip> FindFlightByNumber(const std::string& name) const override;
+
+    /// @brief Find flight trips by flight origin city (cached)
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    ///
+    /// @return flight_trips - list of flight trips
+    virtual std::vector<FlightTrip> FindFlightsByOriginCity(const std::string& origin_city) const override;
+
+    /// @brief Find flight trips whose flight number/name starts with provided prefix, ignoring case (e.g. "6e-")
+    ///
+    /// @param prefix[in] - Flight Number/name prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by flight number/name
+    virtual std::vector<FlightTrip> FindFlightsByNumberPrefix(const std::string& prefix) const override;
+
+    /// @brief Find flight trips whose origin city starts with provided prefix, ignoring case (e.g. "beng")
+    ///
+    /// @param prefix[in] - Flight origin city prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by origin city
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityPrefix(const std::string& prefix) const override;
+
+    /// @brief Find average cost of all the trips
+    ///
+    /// @return min_fare - average fare cost of flight trips
+    virtual double FindAverageCostOfAllTrips() const override;
+
+    /// @brief Find minimum fare cost flight between provided cities (cached)
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities
+    virtual double FindMinFareBetweenCities(const std::string& origin_city,
+                                            const std::string& destination_city) const override;
+
+    /// @brief Find flight trips from provided origin city departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return flight_trips - list of flight trips, ordered by departure time
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                        const Timestamp from,
+                                                                        const Timestamp to) const override;
+
+    /// @brief Find minimum fare cost flight between provided cities departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities within time window
+    virtual double FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                        const std::string& destination_city, const Timestamp from,
+                                                        const Timestamp to) const override;
+
+    /// @brief Find maximum fare cost flight trip from provided operator (cached)
+    ///
+    /// @param operated_by[in] - Flight operator
+    ///
+    /// @return max_fare - maximum fare cost of flight trips from provided operator
+    virtual double FindMaxFareByOperator(const std::string& operated_by) const override;
+
+    /// @brief Get Total number of trips in database
+    ///
+    /// @return length - total number of trips in database
+    virtual std::size_t GetTotalTrips(void) const override;
+
+    /// @brief Execute query, streaming matching trips in query order (not cached)
+    ///
+    /// @param query[in] - Query (predicates, projection, ordering, limit)
+    /// @param consumer[in] - Called for each result, returns false to stop the query
+    virtual void Execute(const FlightTripQuery& query, const TripConsumer& consumer) const override;
+
+    /// @brief Get cache statistics accumulated over all cached queries
+    ///
+    /// @return statistics - hit/miss/eviction/invalidation counters
+    QueryCacheStatistics GetStatistics() const;
+
+  private:
+    /// @brief Route (origin city, destination city)
+    using Route = std::pair<std::string, std::string>;
+
+    /// @brief Hash function for Route
+    struct RouteHash
+    {
+        std::size_t operator()(const Route& route) const
+        {
+            const std::hash<std::string> hash{};
+            return hash(route.first) ^ (hash(route.second) * 31U);
+        }
+    };
+
+    /// @brief Invalidate all cached entries which depend on the provided trip
+    ///
+    /// @param trip[in] - Added/Removed/Updated trip
+    void Invalidate(const FlightTrip& trip);
+
+    /// @brief Invalidate cached entries and forget routes of removed trips
+    ///
+    /// @param removed_trips[in] - Trips removed from the underlying database
+    void Forget(const std::vector<FlightTrip>& removed_trips);
+
+    /// @brief Invalidate all cached entries which depend on the provided route
+    ///
+    /// @param route[in] - Route of the Added/Removed/Updated trip
+    void Invalidate(const Route& route);
+
+    /// @brief Underlying database
+    std::unique_ptr<IFlightTripDatabase> database_;
+
+    /// @brief Cached results of FindFlightsByOriginCity (key: origin city)
+    mutable LruCache<std::string, std::vector<FlightTrip>> trips_by_origin_city_;
+
+    /// @brief Cached results of FindMinFareBetweenCities (key: route)
+    mutable LruCache<Route, double, RouteHash> min_fare_by_route_;
+
+    /// @brief Cached results of FindMaxFareByOperator (key: operator)
+    mutable LruCache<std::string, double> max_fare_by_operator_;
+
+    /// @brief Number of trips per route for each operator, used to find entries touched by UpdateFareByOperator
+    std::unordered_map<std::string, std::unordered_map<Route, std::size_t, RouteHash>> routes_by_operator_;
+
+    /// @brief Cache statistics (evictions are collected from the caches on demand)
+    mutable QueryCacheStatistics statistics_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_CACHED_FLIGHT_TRIP_DATABASE_H_
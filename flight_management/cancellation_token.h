@@ -0,0 +1,64 @@
+///
+/// @file cancellation_token.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_CANCELLATION_TOKEN_H_
+#define FLIGHT_MANAGEMENT_CANCELLATION_TOKEN_H_
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace fms
+{
+/// @brief Error set on futures of operations cancelled before execution
+class OperationCancelled : public std::runtime_error
+{
+  public:
+    /// @brief Constructor
+    OperationCancelled() : std::runtime_error{"Operation cancelled"} {}
+};
+
+/// @brief Observes cancellation requested through a CancellationSource. Default constructed token is never cancelled.
+class CancellationToken
+{
+  public:
+    /// @brief Constructor (never cancelled token)
+    CancellationToken() = default;
+
+    /// @brief Constructor
+    /// @param cancelled[in] - Cancellation state shared with CancellationSource
+    explicit CancellationToken(std::shared_ptr<const std::atomic<bool>> cancelled) : cancelled_{std::move(cancelled)}
+    {
+    }
+
+    /// @brief Check whether cancellation was requested
+    bool IsCancelled() const { return cancelled_ && cancelled_->load(std::memory_order_acquire); }
+
+  private:
+    /// @brief Cancellation state shared with CancellationSource
+    std::shared_ptr<const std::atomic<bool>> cancelled_;
+};
+
+/// @brief Requests cancellation of all operations submitted with its tokens
+class CancellationSource
+{
+  public:
+    /// @brief Constructor
+    CancellationSource() : cancelled_{std::make_shared<std::atomic<bool>>(false)} {}
+
+    /// @brief Request cancellation (thread-safe)
+    void Cancel() { cancelled_->store(true, std::memory_order_release); }
+
+    /// @brief Get token observing this source
+    CancellationToken GetToken() const { return CancellationToken{cancelled_}; }
+
+  private:
+    /// @brief Cancellation state shared with tokens
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_CANCELLATION_TOKEN_H_
@@ -0,0 +1,141 @@
+///
+/// @file change_data_capture.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/change_data_capture.h"
+#include "flight_management/logging.h"
+#include "flight_management/tracing.h"
+
+#include <algorithm>
+
+namespace fms
+{
+ChangeStream::ChangeStream(const std::size_t capacity, const std::uint64_t start_sequence)
+    : events_{capacity}, start_sequence_{start_sequence}, dropped_events_{0U}
+{
+}
+
+bool ChangeStream::TryPush(ChangeEvent&& event)
+{
+    // Keep dropping after an overflow, delivering later events would hide the gap from the subscriber
+    const auto dropped_events = dropped_events_.load(std::memory_order_relaxed);
+    if ((dropped_events > 0U) || !events_.TryPush(std::move(event)))
+    {
+        dropped_events_.store(dropped_events + 1U, std::memory_order_release);
+        return false;
+    }
+    return true;
+}
+
+bool ChangeStream::TryPop(ChangeEvent& event) { return events_.TryPop(event); }
+
+bool ChangeStream::IsOverflowed() const { return GetDroppedEvents() > 0U; }
+
+std::uint64_t ChangeStream::GetDroppedEvents() const { return dropped_events_.load(std::memory_order_acquire); }
+
+std::uint64_t ChangeStream::GetStartSequence() const { return start_sequence_; }
+
+ChangeDataCapture::ChangeDataCapture() : streams_{}, last_sequence_{0U} {}
+
+std::shared_ptr<ChangeStream> ChangeDataCapture::Subscribe(const std::size_t capacity)
+{
+    streams_.push_back(std::make_shared<ChangeStream>(capacity, last_sequence_));
+    return streams_.back();
+}
+
+void ChangeDataCapture::Publish(const ChangeType type, const FlightTrip& trip)
+{
+    TRACE_SPAN("ChangeDataCapture::Publish");
+    ++last_sequence_;
+
+    // Streams released by their subscribers are only referenced from here
+    streams_.erase(std::remove_if(streams_.begin(), streams_.end(),
+                                  [](const auto& stream) { return stream.use_count() == 1; }),
+                   streams_.end());
+
+    for (auto& stream : streams_)
+    {
+        if (!stream->TryPush(ChangeEvent{last_sequence_, type, trip}) && (stream->GetDroppedEvents() == 1U))
+        {
+            LOG(ERROR) << "Change stream overflowed at sequence {" << last_sequence_
+                       << "}, subscriber must resynchronize";
+        }
+    }
+}
+
+std::uint64_t ChangeDataCapture::GetLastSequence() const { return last_sequence_; }
+
+ReplicaApplier::ReplicaApplier(std::shared_ptr<ChangeStream> stream, IFlightTripDatabase& replica)
+    : ReplicaApplier{std::move(stream), {}, replica}
+{
+}
+
+ReplicaApplier::ReplicaApplier(std::shared_ptr<ChangeStream> stream, const std::vector<FlightTrip>& snapshot,
+                               IFlightTripDatabase& replica)
+    : stream_{std::move(stream)}, replica_{replica}, last_applied_sequence_{0U}, has_gap_{false}
+{
+    ASSERT_CHECK(stream_) << "Replica applier requires a change stream";
+    last_applied_sequence_ = stream_->GetStartSequence();
+    std::for_each(snapshot.begin(), snapshot.end(), [this](const auto& trip) {
+        replica_.AddTrip(trip.name, trip.operated_by, trip.origin_city, trip.destination_city, trip.fare,
+                         trip.departure_time, trip.arrival_time);
+    });
+}
+
+std::size_t ReplicaApplier::ApplyPending()
+{
+    TRACE_SPAN("ReplicaApplier::ApplyPending");
+    std::size_t applied = 0U;
+    ChangeEvent event{};
+    while (!has_gap_ && stream_->TryPop(event) && Apply(event))
+    {
+        ++applied;
+    }
+    return applied;
+}
+
+std::uint64_t ReplicaApplier::GetLastAppliedSequence() const { return last_applied_sequence_; }
+
+bool ReplicaApplier::NeedsResynchronization() const { return has_gap_ || stream_->IsOverflowed(); }
+
+bool ReplicaApplier::Apply(const ChangeEvent& event)
+{
+    if (event.sequence != last_applied_sequence_ + 1U)
+    {
+        LOG(ERROR) << "Change stream gap, expected sequence {" << last_applied_sequence_ + 1U << "}, received {"
+                   << event.sequence << "}, replica must resynchronize";
+        has_gap_ = true;
+        return false;
+    }
+
+    switch (event.type)
+    {
+        case ChangeType::kAddTrip:
+            replica_.AddTrip(event.trip.name, event.trip.operated_by, event.trip.origin_city,
+                             event.trip.destination_city, event.trip.fare, event.trip.departure_time,
+                             event.trip.arrival_time);
+            break;
+        case ChangeType::kRemoveTrip:
+            replica_.RemoveTrip(event.trip.name);
+            break;
+        case ChangeType::kUpdateFareByTrip:
+            replica_.UpdateFareByTrip(event.trip.name, event.trip.fare);
+            break;
+        case ChangeType::kUpdateFareByOperator:
+            replica_.UpdateFareByOperator(event.trip.operated_by, event.trip.fare);
+            break;
+        case ChangeType::kRemoveTripByDeparture:
+            replica_.RemoveTrip(event.trip.name, event.trip.departure_time);
+            break;
+        case ChangeType::kUpdateFareByDeparture:
+            replica_.UpdateFareByTrip(event.trip.name, event.trip.departure_time, event.trip.fare);
+            break;
+        default:
+            LOG(ERROR) << "Unknown change type {" << static_cast<std::int32_t>(event.type) << "}";
+            break;
+    }
+    last_applied_sequence_ = event.sequence;
+    return true;
+}
+
+}  // namespace fms
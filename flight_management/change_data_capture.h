@@ -0,0 +1,185 @@
+///
+/// @file change_data_capture.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_CHANGE_DATA_CAPTURE_H_
+#define FLIGHT_MANAGEMENT_CHANGE_DATA_CAPTURE_H_
+
+#include "flight_management/flight_trip.h"
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/spsc_ring_buffer.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace fms
+{
+/// @brief Type of database mutation
+enum class ChangeType : std::uint8_t
+{
+    kAddTrip = 0U,
+    kRemoveTrip = 1U,
+    kUpdateFareByTrip = 2U,
+    kUpdateFareByOperator = 3U,
+    kRemoveTripByDeparture = 4U,
+    kUpdateFareByDeparture = 5U,
+};
+
+/// @brief Database mutation captured for downstream replicas
+struct ChangeEvent
+{
+    /// @brief Sequence number (starts at 1, incremented by one for each mutation)
+    std::uint64_t sequence;
+
+    /// @brief Type of mutation
+    ChangeType type;
+
+    /// @brief Mutation arguments. kAddTrip uses all fields, kRemoveTrip uses name, kUpdateFareByTrip uses name and
+    ///        fare, kUpdateFareByOperator uses operated_by and fare. kRemoveTripByDeparture and
+    ///        kUpdateFareByDeparture additionally use departure_time.
+    FlightTrip trip;
+};
+
+/// @brief Bounded stream of change events for one subscriber
+///
+/// If the subscriber falls behind and the stream is full, the stream overflows: the event and all later events are
+/// dropped (and counted), so the master never waits for a subscriber. Events buffered before the overflow can still
+/// be popped, afterwards the subscriber is disconnected and must resynchronize (i.e. subscribe again together with a
+/// snapshot of the master and rebuild its replica from it, see FlightTripDatabase::SubscribeToChanges).
+class ChangeStream
+{
+  public:
+    /// @brief Constructor
+    /// @param capacity[in] - Maximum number of unconsumed events (must be power of two)
+    /// @param start_sequence[in] - Sequence number of last mutation published before subscribing (0 if none)
+    ChangeStream(const std::size_t capacity, const std::uint64_t start_sequence);
+
+    /// @brief Push event (producer only)
+    ///
+    /// @param event[in] - Event to push
+    ///
+    /// @return pushed - false if the stream is full or has overflowed before (event is dropped)
+    bool TryPush(ChangeEvent&& event);
+
+    /// @brief Pop event (consumer only)
+    ///
+    /// @param event[out] - Popped event
+    ///
+    /// @return popped - false if no event is buffered
+    bool TryPop(ChangeEvent& event);
+
+    /// @brief Check whether events were dropped, because the stream was full
+    bool IsOverflowed() const;
+
+    /// @brief Get number of dropped events
+    std::uint64_t GetDroppedEvents() const;
+
+    /// @brief Get sequence number of last mutation published before subscribing, the first event follows it
+    std::uint64_t GetStartSequence() const;
+
+  private:
+    /// @brief Buffered events
+    SpscRingBuffer<ChangeEvent> events_;
+
+    /// @brief Sequence number of last mutation published before subscribing
+    const std::uint64_t start_sequence_;
+
+    /// @brief Number of dropped events (written by producer only)
+    std::atomic<std::uint64_t> dropped_events_;
+};
+
+/// @brief Publishes database mutations to subscribed change streams (Change Data Capture)
+///
+/// Publish and Subscribe must be called from the thread mutating the database, each stream may be consumed by one
+/// other thread. Publish never blocks, full streams overflow instead (see ChangeStream).
+class ChangeDataCapture
+{
+  public:
+    /// @brief Constructor
+    ChangeDataCapture();
+
+    /// @brief Subscribe to mutations published from now on
+    ///
+    /// @param capacity[in] - Maximum number of unconsumed events (must be power of two)
+    ///
+    /// @return stream - Stream of change events. Releasing it unsubscribes.
+    std::shared_ptr<ChangeStream> Subscribe(const std::size_t capacity);
+
+    /// @brief Publish mutation to all subscribers
+    ///
+    /// @param type[in] - Type of mutation
+    /// @param trip[in] - Mutation arguments
+    void Publish(const ChangeType type, const FlightTrip& trip);
+
+    /// @brief Get sequence number of last published mutation (0 if none)
+    std::uint64_t GetLastSequence() const;
+
+  private:
+    /// @brief Subscribed streams
+    std::vector<std::shared_ptr<ChangeStream>> streams_;
+
+    /// @brief Sequence number of last published mutation
+    std::uint64_t last_sequence_;
+};
+
+/// @brief Applies change events from a stream to a replica database
+///
+/// The replica is bootstrapped from a snapshot of the master taken when the stream was subscribed, so streams may be
+/// subscribed at any time, i.e. to resynchronize after an overflow. Once the stream has overflowed or delivered an
+/// event out of sequence, the replica stops at the last applied event and must be rebuilt from a new subscription.
+class ReplicaApplier
+{
+  public:
+    /// @brief Constructor, for streams subscribed while the master database was empty
+    ///
+    /// @param stream[in] - Stream of change events
+    /// @param replica[in] - Replica database (empty)
+    ReplicaApplier(std::shared_ptr<ChangeStream> stream, IFlightTripDatabase& replica);
+
+    /// @brief Constructor, adds snapshot trips to the replica
+    ///
+    /// @param stream[in] - Stream of change events
+    /// @param snapshot[in] - All trips of the master database when the stream was subscribed
+    /// @param replica[in] - Replica database (empty)
+    ReplicaApplier(std::shared_ptr<ChangeStream> stream, const std::vector<FlightTrip>& snapshot,
+                   IFlightTripDatabase& replica);
+
+    /// @brief Apply all currently available change events
+    ///
+    /// @return applied - number of applied events
+    std::size_t ApplyPending();
+
+    /// @brief Get sequence number of last applied change event (start sequence of the stream if none)
+    std::uint64_t GetLastAppliedSequence() const;
+
+    /// @brief Check whether the replica stopped following the master (stream overflowed or delivered an event out of
+    ///        sequence), hence must be rebuilt from a new subscription
+    bool NeedsResynchronization() const;
+
+  private:
+    /// @brief Apply change event to replica
+    ///
+    /// @param event[in] - Change event
+    ///
+    /// @return applied - false if the event is out of sequence (event is not applied)
+    bool Apply(const ChangeEvent& event);
+
+    /// @brief Subscribed stream
+    std::shared_ptr<ChangeStream> stream_;
+
+    /// @brief Replica database
+    IFlightTripDatabase& replica_;
+
+    /// @brief Sequence number of last applied change event
+    std::uint64_t last_applied_sequence_;
+
+    /// @brief Whether an event out of sequence has been received
+    bool has_gap_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_CHANGE_DATA_CAPTURE_H_
@@ -0,0 +1,537 @@
+///
+/// @file cold_trip_segment.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/cold_trip_segment.h"
+#include "flight_management/fare_kernels.h"
+#include "flight_management/tracing.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <tuple>
+#include <utility>
+
+namespace fms
+{
+namespace
+{
+/// @brief Least number of patched fares per block before they are folded back into the fare column
+constexpr std::size_t kMinPatchedFaresToFold{ColdTripSegment::kBlockSize / 16U};
+
+/// @brief Order patched fares by row
+bool IsPatchedBefore(const std::pair<std::size_t, double>& patched_fare, const std::size_t row)
+{
+    return patched_fare.first < row;
+}
+
+/// @brief Check whether value starts with prefix, ignoring case (ASCII)
+bool StartsWithIgnoringCase(const std::string& value, const std::string& prefix)
+{
+    return (value.size() >= prefix.size()) &&
+           std::equal(prefix.begin(), prefix.end(), value.begin(), [](const char lhs, const char rhs) {
+               return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+           });
+}
+}  // namespace
+
+constexpr std::size_t ColdTripSegment::kBlockSize;
+
+ColdTripSegment::ColdTripSegment(std::vector<CompactFlightTrip> trips, const StringDictionary& dictionary)
+    : blocks_{}, statistics_{0U, 0U, 0U}
+{
+    TRACE_SPAN("ColdTripSegment::ColdTripSegment");
+    std::sort(trips.begin(), trips.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.origin_city, lhs.destination_city, lhs.departure_time) <
+               std::tie(rhs.origin_city, rhs.destination_city, rhs.departure_time);
+    });
+
+    for (auto begin = trips.cbegin(); begin != trips.cend();)
+    {
+        const auto end = begin + static_cast<std::ptrdiff_t>(
+                                     std::min(kBlockSize, static_cast<std::size_t>(trips.cend() - begin)));
+        blocks_.push_back(MakeBlock(begin, end, dictionary));
+        begin = end;
+    }
+}
+
+std::size_t ColdTripSegment::Remove(const std::string& name)
+{
+    return RemoveDepartures(name, std::numeric_limits<Timestamp>::min(), std::numeric_limits<Timestamp>::max());
+}
+
+std::size_t ColdTripSegment::RemoveDepartures(const std::string& name, const Timestamp first_departure,
+                                              const Timestamp last_departure)
+{
+    TRACE_SPAN("ColdTripSegment::RemoveDepartures");
+    std::size_t removed = 0U;
+    VisitDepartures(name, first_departure, last_departure, [&removed](Block& block, const std::size_t row) {
+        block.removed[row] = true;
+        --block.live_trips;
+        AccumulateFare(block, GetFare(block, row), -1);
+        ++removed;
+    });
+    return removed;
+}
+
+std::size_t ColdTripSegment::UpdateFares(const std::string& name, const Timestamp first_departure,
+                                         const Timestamp last_departure, const double fare)
+{
+    TRACE_SPAN("ColdTripSegment::UpdateFares");
+    std::size_t updated = 0U;
+    VisitDepartures(name, first_departure, last_departure, [&](Block& block, const std::size_t row) {
+        SetFare(block, row, fare);
+        ++updated;
+    });
+    return updated;
+}
+
+std::size_t ColdTripSegment::UpdateFaresByOperator(const StringId operated_by, const double fare)
+{
+    TRACE_SPAN("ColdTripSegment::UpdateFaresByOperator");
+    std::size_t updated = 0U;
+    for (auto& block : blocks_)
+    {
+        const auto code = block.operated_by.Find(operated_by);
+        if (code == DictionaryColumn<StringId>::kNoCode)
+        {
+            continue;
+        }
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            if ((block.operated_by.GetCode(row) == code) && !block.removed[row])
+            {
+                SetFare(block, row, fare);
+                ++updated;
+            }
+        }
+    }
+    return updated;
+}
+
+void ColdTripSegment::FindByName(const std::string& name, const StringDictionary& dictionary,
+                                 std::vector<FlightTrip>& trips) const
+{
+    TRACE_SPAN("ColdTripSegment::FindByName");
+    for (const auto& block : blocks_)
+    {
+        const auto code = block.name.Find(name);
+        if (code == DictionaryColumn<std::string>::kNoCode)
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            if ((block.name.GetCode(row) == code) && !block.removed[row])
+            {
+                trips.push_back(Decode(block, row, dictionary));
+            }
+        }
+    }
+}
+
+void ColdTripSegment::FindByNamePrefix(const std::string& prefix, const StringDictionary& dictionary,
+                                       std::vector<FlightTrip>& trips) const
+{
+    TRACE_SPAN("ColdTripSegment::FindByNamePrefix");
+    for (const auto& block : blocks_)
+    {
+        const auto& names = block.name.GetValues();
+        std::vector<bool> matches(names.size());
+        std::transform(names.begin(), names.end(), matches.begin(),
+                       [&prefix](const auto& name) { return StartsWithIgnoringCase(name, prefix); });
+        if (std::none_of(matches.begin(), matches.end(), [](const bool match) { return match; }))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            if (matches[block.name.GetCode(row)] && !block.removed[row])
+            {
+                trips.push_back(Decode(block, row, dictionary));
+            }
+        }
+    }
+}
+
+void ColdTripSegment::FindByOriginCity(const StringId origin_city, const Timestamp from, const Timestamp to,
+                                       const StringDictionary& dictionary, std::vector<FlightTrip>& trips) const
+{
+    TRACE_SPAN("ColdTripSegment::FindByOriginCity");
+    for (const auto& block : blocks_)
+    {
+        const auto code = block.origin_city.Find(origin_city);
+        if ((code == DictionaryColumn<StringId>::kNoCode) || !DepartsWithin(block, from, to))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            const auto departure_time = block.departure_time.Get(row);
+            if ((block.origin_city.GetCode(row) == code) && (departure_time >= from) && (departure_time < to) &&
+                !block.removed[row])
+            {
+                trips.push_back(Decode(block, row, dictionary));
+            }
+        }
+    }
+}
+
+void ColdTripSegment::FindByOriginCityPrefix(const std::string& prefix, const StringDictionary& dictionary,
+                                             std::vector<FlightTrip>& trips) const
+{
+    TRACE_SPAN("ColdTripSegment::FindByOriginCityPrefix");
+    for (const auto& block : blocks_)
+    {
+        const auto& origin_cities = block.origin_city.GetValues();
+        std::vector<bool> matches(origin_cities.size());
+        std::transform(origin_cities.begin(), origin_cities.end(), matches.begin(), [&](const auto origin_city) {
+            return StartsWithIgnoringCase(dictionary.Lookup(origin_city), prefix);
+        });
+        if (std::none_of(matches.begin(), matches.end(), [](const bool match) { return match; }))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            if (matches[block.origin_city.GetCode(row)] && !block.removed[row])
+            {
+                trips.push_back(Decode(block, row, dictionary));
+            }
+        }
+    }
+}
+
+bool ColdTripSegment::Scan(const FlightTripFilter& filter, const StringId operated_by, const StringId origin_city,
+                           const StringId destination_city, const StringDictionary& dictionary,
+                           const std::function<bool(const FlightTrip&)>& visit) const
+{
+    TRACE_SPAN("ColdTripSegment::Scan");
+    // Prefix matches by name code, only computed for blocks passing the zone maps and reused across blocks
+    const auto has_name_prefix = !filter.name_prefix.empty();
+    std::vector<bool> prefix_matches{};
+    for (const auto& block : blocks_)
+    {
+        // Codes of equality predicates (kNoCode if the block holds no matching trip)
+        const auto name_code = filter.has_name ? block.name.Find(filter.name) : 0U;
+        const auto operator_code = filter.has_operated_by ? block.operated_by.Find(operated_by) : 0U;
+        const auto origin_code = filter.has_origin_city ? block.origin_city.Find(origin_city) : 0U;
+        const auto destination_code =
+            filter.has_destination_city ? block.destination_city.Find(destination_city) : 0U;
+        if ((name_code == DictionaryColumn<std::string>::kNoCode) ||
+            (operator_code == DictionaryColumn<StringId>::kNoCode) ||
+            (origin_code == DictionaryColumn<StringId>::kNoCode) ||
+            (destination_code == DictionaryColumn<StringId>::kNoCode) ||
+            !DepartsWithin(block, filter.departure_from, filter.departure_to) || (block.max_fare < filter.min_fare) ||
+            !(block.min_fare < filter.max_fare))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        if (has_name_prefix)
+        {
+            const auto& names = block.name.GetValues();
+            prefix_matches.assign(names.size(), false);
+            std::transform(names.begin(), names.end(), prefix_matches.begin(),
+                           [&filter](const auto& value) { return filter.MatchesNamePrefix(value); });
+            if (std::none_of(prefix_matches.begin(), prefix_matches.end(), [](const bool match) { return match; }))
+            {
+                ++statistics_.blocks_skipped;
+                continue;
+            }
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            const auto departure_time = block.departure_time.Get(row);
+            const auto fare = GetFare(block, row);
+            const auto matches_fields =
+                !block.removed[row] && (!filter.has_name || (block.name.GetCode(row) == name_code)) &&
+                (!has_name_prefix || prefix_matches[block.name.GetCode(row)]) &&
+                (!filter.has_operated_by || (block.operated_by.GetCode(row) == operator_code)) &&
+                (!filter.has_origin_city || (block.origin_city.GetCode(row) == origin_code)) &&
+                (!filter.has_destination_city || (block.destination_city.GetCode(row) == destination_code)) &&
+                (departure_time >= filter.departure_from) && (departure_time < filter.departure_to) &&
+                (fare >= filter.min_fare) && (fare < filter.max_fare);
+            if (!matches_fields)
+            {
+                continue;
+            }
+
+            ++statistics_.trips_decoded;
+            const auto trip = Decode(block, row, dictionary);
+            if (std::all_of(filter.predicates.begin(), filter.predicates.end(),
+                            [&trip](const auto& predicate) { return predicate(trip); }) &&
+                !visit(trip))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+double ColdTripSegment::FindMinFare(const StringId origin_city, const StringId destination_city, const Timestamp from,
+                                    const Timestamp to, const double min_fare) const
+{
+    TRACE_SPAN("ColdTripSegment::FindMinFare");
+    auto min_fare_found = min_fare;
+    for (const auto& block : blocks_)
+    {
+        const auto origin_city_code = block.origin_city.Find(origin_city);
+        const auto destination_city_code = block.destination_city.Find(destination_city);
+        if ((origin_city_code == DictionaryColumn<StringId>::kNoCode) ||
+            (destination_city_code == DictionaryColumn<StringId>::kNoCode) || !DepartsWithin(block, from, to) ||
+            (block.min_fare >= min_fare_found))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            const auto departure_time = block.departure_time.Get(row);
+            if ((block.origin_city.GetCode(row) == origin_city_code) &&
+                (block.destination_city.GetCode(row) == destination_city_code) && (departure_time >= from) &&
+                (departure_time < to) && !block.removed[row])
+            {
+                min_fare_found = std::min(min_fare_found, GetFare(block, row));
+            }
+        }
+    }
+    return min_fare_found;
+}
+
+double ColdTripSegment::FindMaxFare(const StringId operated_by, const double max_fare) const
+{
+    TRACE_SPAN("ColdTripSegment::FindMaxFare");
+    auto max_fare_found = max_fare;
+    for (const auto& block : blocks_)
+    {
+        const auto code = block.operated_by.Find(operated_by);
+        if ((code == DictionaryColumn<StringId>::kNoCode) || (block.max_fare <= max_fare_found))
+        {
+            ++statistics_.blocks_skipped;
+            continue;
+        }
+        ++statistics_.blocks_scanned;
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            if ((block.operated_by.GetCode(row) == code) && !block.removed[row])
+            {
+                max_fare_found = std::max(max_fare_found, GetFare(block, row));
+            }
+        }
+    }
+    return max_fare_found;
+}
+
+FixedPointFareSum ColdTripSegment::GetSumOfFares() const
+{
+    FixedPointFareSum sum_of_fares{0};
+    std::for_each(blocks_.begin(), blocks_.end(), [&](const auto& block) { sum_of_fares += block.sum_of_fares; });
+    return sum_of_fares;
+}
+
+double ColdTripSegment::GetSumOfUnroundedFares() const
+{
+    double sum_of_rounding_errors = 0.0;
+    std::for_each(blocks_.begin(), blocks_.end(),
+                  [&](const auto& block) { sum_of_rounding_errors += block.sum_of_rounding_errors; });
+    return (static_cast<double>(GetSumOfFares()) / static_cast<double>(kMinorUnitsPerMajorUnit)) +
+           sum_of_rounding_errors;
+}
+
+std::size_t ColdTripSegment::GetTotalTrips() const
+{
+    std::size_t total_trips = 0U;
+    std::for_each(blocks_.begin(), blocks_.end(), [&](const auto& block) { total_trips += block.live_trips; });
+    return total_trips;
+}
+
+std::size_t ColdTripSegment::GetMemoryUsage() const
+{
+    std::size_t memory_usage = blocks_.size() * sizeof(Block);
+    for (const auto& block : blocks_)
+    {
+        memory_usage += block.name.GetMemoryUsage() + block.operated_by.GetMemoryUsage() +
+                        block.origin_city.GetMemoryUsage() + block.destination_city.GetMemoryUsage() +
+                        block.fare.GetMemoryUsage() + block.departure_time.GetMemoryUsage() +
+                        block.arrival_time.GetMemoryUsage() + (block.removed.size() / 8U) +
+                        (block.patched_fares.size() * (sizeof(std::size_t) + sizeof(double)));
+    }
+    return memory_usage;
+}
+
+ColdTierStatistics ColdTripSegment::GetStatistics() const { return statistics_; }
+
+ColdTripSegment::Block ColdTripSegment::MakeBlock(std::vector<CompactFlightTrip>::const_iterator begin,
+                                                  std::vector<CompactFlightTrip>::const_iterator end,
+                                                  const StringDictionary& dictionary)
+{
+    std::vector<std::string> names;
+    std::vector<StringId> operators;
+    std::vector<StringId> origin_cities;
+    std::vector<StringId> destination_cities;
+    std::vector<FixedPointFare> fares;
+    std::vector<std::int64_t> departure_times;
+    std::vector<std::int64_t> arrival_times;
+    std::vector<std::pair<std::size_t, double>> patched_fares;
+    double sum_of_rounding_errors = 0.0;
+    std::for_each(begin, end, [&](const auto& trip) {
+        if (ToFare(ToFixedPointFare(trip.fare)) != trip.fare)
+        {
+            patched_fares.emplace_back(names.size(), trip.fare);
+            sum_of_rounding_errors += trip.fare - ToFare(ToFixedPointFare(trip.fare));
+        }
+        names.push_back(GetFlightName(trip, dictionary));
+        operators.push_back(trip.operated_by);
+        origin_cities.push_back(trip.origin_city);
+        destination_cities.push_back(trip.destination_city);
+        fares.push_back(ToFixedPointFare(trip.fare));
+        departure_times.push_back(trip.departure_time);
+        arrival_times.push_back(trip.arrival_time);
+    });
+
+    const auto number_of_trips = names.size();
+    const auto fare_range = std::minmax_element(begin, end, [](const auto& lhs, const auto& rhs) {
+        return lhs.fare < rhs.fare;
+    });
+    return Block{DictionaryColumn<std::string>{names},
+                 DictionaryColumn<StringId>{operators},
+                 DictionaryColumn<StringId>{origin_cities},
+                 DictionaryColumn<StringId>{destination_cities},
+                 FrameOfReferenceColumn{fares},
+                 FrameOfReferenceColumn{departure_times},
+                 FrameOfReferenceColumn{arrival_times},
+                 std::vector<bool>(number_of_trips, false),
+                 number_of_trips,
+                 SumFares(fares.data(), fares.size()),
+                 sum_of_rounding_errors,
+                 std::move(patched_fares),
+                 kMinPatchedFaresToFold,
+                 fare_range.first->fare,
+                 fare_range.second->fare};
+}
+
+void ColdTripSegment::VisitDepartures(const std::string& name, const Timestamp first_departure,
+                                      const Timestamp last_departure,
+                                      const std::function<void(Block&, const std::size_t)>& visit)
+{
+    for (auto& block : blocks_)
+    {
+        const auto code = block.name.Find(name);
+        if ((code == DictionaryColumn<std::string>::kNoCode) || (block.departure_time.Max() < first_departure) ||
+            (block.departure_time.Min() > last_departure))
+        {
+            continue;
+        }
+        for (std::size_t row = 0U; row < block.removed.size(); ++row)
+        {
+            const auto departure_time = block.departure_time.Get(row);
+            if ((block.name.GetCode(row) == code) && !block.removed[row] && (departure_time >= first_departure) &&
+                (departure_time <= last_departure))
+            {
+                visit(block, row);
+            }
+        }
+    }
+}
+
+double ColdTripSegment::GetFare(const Block& block, const std::size_t row)
+{
+    if (block.patched_fares.empty())
+    {
+        return ToFare(block.fare.Get(row));
+    }
+    const auto patched_fare =
+        std::lower_bound(block.patched_fares.begin(), block.patched_fares.end(), row, IsPatchedBefore);
+    return ((patched_fare != block.patched_fares.end()) && (patched_fare->first == row)) ? patched_fare->second
+                                                                                          : ToFare(block.fare.Get(row));
+}
+
+void ColdTripSegment::SetFare(Block& block, const std::size_t row, const double fare)
+{
+    AccumulateFare(block, GetFare(block, row), -1);
+    AccumulateFare(block, fare, 1);
+    const auto patched_fare =
+        std::lower_bound(block.patched_fares.begin(), block.patched_fares.end(), row, IsPatchedBefore);
+    const auto is_patched = (patched_fare != block.patched_fares.end()) && (patched_fare->first == row);
+    if (ToFare(block.fare.Get(row)) == fare)
+    {
+        if (is_patched)
+        {
+            block.patched_fares.erase(patched_fare);
+        }
+    }
+    else if (is_patched)
+    {
+        patched_fare->second = fare;
+    }
+    else
+    {
+        block.patched_fares.emplace(patched_fare, row, fare);
+    }
+    if (block.patched_fares.size() > block.max_patched_fares)
+    {
+        FoldPatchedFares(block);
+    }
+    block.min_fare = std::min(block.min_fare, fare);
+    block.max_fare = std::max(block.max_fare, fare);
+}
+
+void ColdTripSegment::FoldPatchedFares(Block& block)
+{
+    TRACE_SPAN("ColdTripSegment::FoldPatchedFares");
+    std::vector<FixedPointFare> fares(block.removed.size());
+    for (std::size_t row = 0U; row < fares.size(); ++row)
+    {
+        fares[row] = block.fare.Get(row);
+    }
+    std::vector<std::pair<std::size_t, double>> patched_fares;
+    for (const auto& patched_fare : block.patched_fares)
+    {
+        fares[patched_fare.first] = ToFixedPointFare(patched_fare.second);
+        if (ToFare(fares[patched_fare.first]) != patched_fare.second)
+        {
+            patched_fares.push_back(patched_fare);
+        }
+    }
+    block.fare = FrameOfReferenceColumn{fares};
+    block.patched_fares = std::move(patched_fares);
+    // Fares which are not whole minor units stay patched, fold again only once as many others have been patched
+    block.max_patched_fares = std::max(kMinPatchedFaresToFold, 2U * block.patched_fares.size());
+}
+
+void ColdTripSegment::AccumulateFare(Block& block, const double fare, const int sign)
+{
+    const auto fixed_point_fare = ToFixedPointFare(fare);
+    block.sum_of_fares += sign * fixed_point_fare;
+    block.sum_of_rounding_errors += sign * (fare - ToFare(fixed_point_fare));
+}
+
+FlightTrip ColdTripSegment::Decode(const Block& block, const std::size_t row, const StringDictionary& dictionary)
+{
+    return FlightTrip{block.name.Get(row),
+                      dictionary.Lookup(block.operated_by.Get(row)),
+                      dictionary.Lookup(block.origin_city.Get(row)),
+                      dictionary.Lookup(block.destination_city.Get(row)),
+                      GetFare(block, row),
+                      block.departure_time.Get(row),
+                      block.arrival_time.Get(row)};
+}
+
+bool ColdTripSegment::DepartsWithin(const Block& block, const Timestamp from, const Timestamp to)
+{
+    return (block.departure_time.Max() >= from) && (block.departure_time.Min() < to);
+}
+
+}  // namespace fms
@@ -0,0 +1,263 @@
+///
+/// @file cold_trip_segment.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_COLD_TRIP_SEGMENT_H_
+#define FLIGHT_MANAGEMENT_COLD_TRIP_SEGMENT_H_
+
+#include "flight_management/compact_flight_trip.h"
+#include "flight_management/dictionary_column.h"
+#include "flight_management/fare.h"
+#include "flight_management/flight_trip.h"
+#include "flight_management/flight_trip_query.h"
+#include "flight_management/frame_of_reference_column.h"
+#include "flight_management/string_dictionary.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief Block scan statistics of cold tier queries
+struct ColdTierStatistics
+{
+    /// @brief Number of blocks scanned row by row
+    std::size_t blocks_scanned;
+
+    /// @brief Number of blocks skipped, because their zone map ruled them out
+    std::size_t blocks_skipped;
+
+    /// @brief Number of trips decoded by Scan, because they matched all field predicates
+    std::size_t trips_decoded;
+};
+
+/// @brief Compressed segment of historical trips (cold tier).
+///
+/// Trips are sorted by route and departure time and split into blocks. Within a block, flight names, operators and
+/// cities are dictionary encoded, fares (in minor currency units, i.e. 1/100) and times are Frame-of-Reference
+/// encoded. Block dictionaries and min/max values form the zone map which lets queries skip whole blocks. Trips can
+/// only be removed (tombstoned) and have their fares updated. Fares which are not whole minor units, and updated
+/// fares, are kept exactly as per-row patches of the fare column.
+class ColdTripSegment
+{
+  public:
+    /// @brief Number of trips per block
+    static constexpr std::size_t kBlockSize{1024U};
+
+    /// @brief Constructor
+    /// @param trips[in] - Trips to archive (operator and city ids refer to the database dictionary)
+    /// @param dictionary[in] - Database dictionary (used to resolve long flight names)
+    ColdTripSegment(std::vector<CompactFlightTrip> trips, const StringDictionary& dictionary);
+
+    /// @brief Remove all trips with provided flight number/name
+    ///
+    /// @param name[in] - Flight Number/name
+    ///
+    /// @return removed - number of removed trips
+    std::size_t Remove(const std::string& name);
+
+    /// @brief Remove trips with provided flight number/name departing within [first_departure, last_departure]
+    ///
+    /// @param name[in] - Flight Number/name
+    /// @param first_departure[in] - Earliest departure time (inclusive)
+    /// @param last_departure[in] - Latest departure time (inclusive)
+    ///
+    /// @return removed - number of removed trips
+    std::size_t RemoveDepartures(const std::string& name, const Timestamp first_departure,
+                                 const Timestamp last_departure);
+
+    /// @brief Update fare of trips with provided flight number/name departing within [first_departure,
+    ///        last_departure]
+    ///
+    /// @param name[in] - Flight Number/name
+    /// @param first_departure[in] - Earliest departure time (inclusive)
+    /// @param last_departure[in] - Latest departure time (inclusive)
+    /// @param fare[in] - Flight fare
+    ///
+    /// @return updated - number of updated trips
+    std::size_t UpdateFares(const std::string& name, const Timestamp first_departure, const Timestamp last_departure,
+                            const double fare);
+
+    /// @brief Update fare of all trips of operator
+    ///
+    /// @param operated_by[in] - Operator (dictionary id)
+    /// @param fare[in] - Flight fare
+    ///
+    /// @return updated - number of updated trips
+    std::size_t UpdateFaresByOperator(const StringId operated_by, const double fare);
+
+    /// @brief Find trips by flight number/name
+    ///
+    /// @param name[in] - Flight Number/name
+    /// @param dictionary[in] - Database dictionary
+    /// @param trips[in/out] - Found trips are appended
+    void FindByName(const std::string& name, const StringDictionary& dictionary, std::vector<FlightTrip>& trips) const;
+
+    /// @brief Find trips by flight number/name prefix, ignoring case
+    ///
+    /// @param prefix[in] - Flight Number/name prefix
+    /// @param dictionary[in] - Database dictionary
+    /// @param trips[in/out] - Found trips are appended
+    void FindByNamePrefix(const std::string& prefix, const StringDictionary& dictionary,
+                          std::vector<FlightTrip>& trips) const;
+
+    /// @brief Find trips from origin city departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Origin city (dictionary id)
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    /// @param dictionary[in] - Database dictionary
+    /// @param trips[in/out] - Found trips are appended
+    void FindByOriginCity(const StringId origin_city, const Timestamp from, const Timestamp to,
+                          const StringDictionary& dictionary, std::vector<FlightTrip>& trips) const;
+
+    /// @brief Find trips by origin city prefix, ignoring case
+    ///
+    /// @param prefix[in] - Origin city prefix
+    /// @param dictionary[in] - Database dictionary
+    /// @param trips[in/out] - Found trips are appended
+    void FindByOriginCityPrefix(const std::string& prefix, const StringDictionary& dictionary,
+                                std::vector<FlightTrip>& trips) const;
+
+    /// @brief Visit trips matching filter, block by block. Blocks ruled out by their zone map are skipped and only
+    ///        trips matching all field predicates are decoded, so stopping early leaves the remaining blocks untouched.
+    ///
+    /// @param filter[in] - Predicates
+    /// @param operated_by[in] - Operator of filter (dictionary id, only used if filter has an operator)
+    /// @param origin_city[in] - Origin city of filter (dictionary id, only used if filter has an origin city)
+    /// @param destination_city[in] - Destination city of filter (dictionary id, only used if filter has a destination)
+    /// @param dictionary[in] - Database dictionary
+    /// @param visit[in] - Called for each matching trip, returns false to stop the scan
+    ///
+    /// @return completed - false if visit stopped the scan
+    bool Scan(const FlightTripFilter& filter, const StringId operated_by, const StringId origin_city,
+              const StringId destination_city, const StringDictionary& dictionary,
+              const std::function<bool(const FlightTrip&)>& visit) const;
+
+    /// @brief Find minimum fare between cities departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Origin city (dictionary id)
+    /// @param destination_city[in] - Destination city (dictionary id)
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    /// @param min_fare[in] - Minimum fare found so far (blocks which can not beat it are skipped)
+    ///
+    /// @return min_fare - minimum of provided and found fares
+    double FindMinFare(const StringId origin_city, const StringId destination_city, const Timestamp from,
+                       const Timestamp to, const double min_fare) const;
+
+    /// @brief Find maximum fare of operator
+    ///
+    /// @param operated_by[in] - Operator (dictionary id)
+    /// @param max_fare[in] - Maximum fare found so far (blocks which can not beat it are skipped)
+    ///
+    /// @return max_fare - maximum of provided and found fares
+    double FindMaxFare(const StringId operated_by, const double max_fare) const;
+
+    /// @brief Get exact sum of fares of all trips, each rounded to minor currency units
+    FixedPointFareSum GetSumOfFares() const;
+
+    /// @brief Get sum of fares of all trips (not rounded to minor currency units)
+    double GetSumOfUnroundedFares() const;
+
+    /// @brief Get number of trips
+    std::size_t GetTotalTrips() const;
+
+    /// @brief Get approximate number of bytes used by the segment
+    std::size_t GetMemoryUsage() const;
+
+    /// @brief Get block scan statistics accumulated over all queries
+    ColdTierStatistics GetStatistics() const;
+
+  private:
+    /// @brief Block of trips
+    struct Block
+    {
+        /// @brief Flight names
+        DictionaryColumn<std::string> name;
+
+        /// @brief Operators (database dictionary ids)
+        DictionaryColumn<StringId> operated_by;
+
+        /// @brief Origin cities (database dictionary ids)
+        DictionaryColumn<StringId> origin_city;
+
+        /// @brief Destination cities (database dictionary ids)
+        DictionaryColumn<StringId> destination_city;
+
+        /// @brief Fares in minor currency units
+        FrameOfReferenceColumn fare;
+
+        /// @brief Departure times
+        FrameOfReferenceColumn departure_time;
+
+        /// @brief Arrival times
+        FrameOfReferenceColumn arrival_time;
+
+        /// @brief Tombstones of removed trips
+        std::vector<bool> removed;
+
+        /// @brief Number of trips which are not removed
+        std::size_t live_trips;
+
+        /// @brief Sum of fares (rounded to minor currency units) of trips which are not removed
+        FixedPointFareSum sum_of_fares;
+
+        /// @brief Sum of rounding errors (fare minus rounded fare) of trips which are not removed
+        double sum_of_rounding_errors;
+
+        /// @brief Fares which differ from the fare column (not whole minor units, or updated), sorted by row
+        std::vector<std::pair<std::size_t, double>> patched_fares;
+
+        /// @brief Number of patched fares beyond which they are folded back into the fare column
+        std::size_t max_patched_fares;
+
+        /// @brief Lowest fare of the block (zone map, updates only widen it)
+        double min_fare;
+
+        /// @brief Highest fare of the block (zone map, updates only widen it)
+        double max_fare;
+    };
+
+    /// @brief Visit trips which are not removed, with provided flight number/name departing within [first_departure,
+    ///        last_departure]
+    void VisitDepartures(const std::string& name, const Timestamp first_departure, const Timestamp last_departure,
+                         const std::function<void(Block&, const std::size_t)>& visit);
+
+    /// @brief Get fare of trip at provided row of the block
+    static double GetFare(const Block& block, const std::size_t row);
+
+    /// @brief Set fare of trip at provided row of the block, keeping sums and zone map up to date
+    static void SetFare(Block& block, const std::size_t row, const double fare);
+
+    /// @brief Rewrite fare column of the block with its current fares, keeping only fares which are not whole minor
+    ///        units patched
+    static void FoldPatchedFares(Block& block);
+
+    /// @brief Add fare of trip to (sign 1) or subtract it from (sign -1) the sums of the block
+    static void AccumulateFare(Block& block, const double fare, const int sign);
+
+    /// @brief Build block from trips
+    static Block MakeBlock(std::vector<CompactFlightTrip>::const_iterator begin,
+                           std::vector<CompactFlightTrip>::const_iterator end, const StringDictionary& dictionary);
+
+    /// @brief Decode trip at provided row of the block
+    static FlightTrip Decode(const Block& block, const std::size_t row, const StringDictionary& dictionary);
+
+    /// @brief Check whether block has departures within time window [from, to)
+    static bool DepartsWithin(const Block& block, const Timestamp from, const Timestamp to);
+
+    /// @brief Blocks of trips
+    std::vector<Block> blocks_;
+
+    /// @brief Block scan statistics
+    mutable ColdTierStatistics statistics_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_COLD_TRIP_SEGMENT_H_
@@ -0,0 +1,69 @@
+///
+/// @file compact_flight_trip.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/compact_flight_trip.h"
+
+#include <cstring>
+
+namespace fms
+{
+namespace
+{
+/// @brief Create flight name of compact record, interning names which do not fit inline
+FlightName ToFlightName(const std::string& name, StringDictionary& dictionary)
+{
+    if (FlightName::Fits(name))
+    {
+        return FlightName::FromString(name);
+    }
+    static_assert(sizeof(StringId) <= kMaxInlineFlightNameLength, "Interned flight name id must fit inline.");
+    const auto id = dictionary.Intern(name);
+    FlightName flight_name{};
+    flight_name.length = kInternedFlightNameLength;
+    std::memcpy(flight_name.data.data(), &id, sizeof(id));
+    return flight_name;
+}
+
+/// @brief Get dictionary id of interned flight name
+StringId GetInternedFlightName(const FlightName& flight_name)
+{
+    StringId id{};
+    std::memcpy(&id, flight_name.data.data(), sizeof(id));
+    return id;
+}
+}  // namespace
+
+CompactFlightTrip ToCompactFlightTrip(const FlightTrip& trip, StringDictionary& dictionary)
+{
+    return CompactFlightTrip{trip.fare,
+                             trip.departure_time,
+                             trip.arrival_time,
+                             dictionary.Intern(trip.operated_by),
+                             dictionary.Intern(trip.origin_city),
+                             dictionary.Intern(trip.destination_city),
+                             ToFlightName(trip.name, dictionary)};
+}
+
+FlightTrip ToFlightTrip(const CompactFlightTrip& compact_trip, const StringDictionary& dictionary)
+{
+    return FlightTrip{GetFlightName(compact_trip, dictionary), dictionary.Lookup(compact_trip.operated_by),
+                      dictionary.Lookup(compact_trip.origin_city), dictionary.Lookup(compact_trip.destination_city),
+                      compact_trip.fare, compact_trip.departure_time, compact_trip.arrival_time};
+}
+
+std::string GetFlightName(const CompactFlightTrip& compact_trip, const StringDictionary& dictionary)
+{
+    return (compact_trip.name.length == kInternedFlightNameLength)
+               ? dictionary.Lookup(GetInternedFlightName(compact_trip.name))
+               : compact_trip.name.ToString();
+}
+
+bool HasFlightName(const CompactFlightTrip& compact_trip, const std::string& name, const StringDictionary& dictionary)
+{
+    return (compact_trip.name.length == kInternedFlightNameLength)
+               ? (dictionary.Lookup(GetInternedFlightName(compact_trip.name)) == name)
+               : (compact_trip.name == name);
+}
+
+}  // namespace fms
@@ -0,0 +1,96 @@
+///
+/// @file compact_flight_trip.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_COMPACT_FLIGHT_TRIP_H_
+#define FLIGHT_MANAGEMENT_COMPACT_FLIGHT_TRIP_H_
+
+#include "flight_management/flight_trip.h"
+#include "flight_management/inline_string.h"
+#include "flight_management/string_dictionary.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace fms
+{
+/// @brief Maximum length of flight number/name stored inline in the record, longer names are interned in the
+///        dictionary
+constexpr std::size_t kMaxInlineFlightNameLength{11U};
+
+/// @brief Flight number/name stored inline (e.g. 6E-702)
+using FlightName = InlineString<kMaxInlineFlightNameLength>;
+
+/// @brief Length of flight name marking an interned name (its dictionary id is stored in the first data bytes)
+constexpr std::uint8_t kInternedFlightNameLength{0xFFU};
+
+/// @brief Fixed size, trivially copyable Flight Trip record used as database storage.
+///
+/// Operator and city names are dictionary encoded, flight number is stored inline (or dictionary encoded, if it is
+/// longer than kMaxInlineFlightNameLength). Records are converted from/to
+/// FlightTrip only at the database API boundary.
+struct CompactFlightTrip
+{
+    /// @brief Fare
+    double fare;
+
+    /// @brief Departure time
+    Timestamp departure_time;
+
+    /// @brief Arrival time
+    Timestamp arrival_time;
+
+    /// @brief Flight Operator (dictionary id)
+    StringId operated_by;
+
+    /// @brief Origin City (dictionary id)
+    StringId origin_city;
+
+    /// @brief Destination City (dictionary id)
+    StringId destination_city;
+
+    /// @brief Name of flight (use GetFlightName/HasFlightName to access it)
+    FlightName name;
+};
+
+static_assert(std::is_trivially_copyable<CompactFlightTrip>::value, "CompactFlightTrip must be memcpy-able.");
+static_assert(sizeof(CompactFlightTrip) == 48U, "CompactFlightTrip must fit four records per three cache lines.");
+
+/// @brief Convert Flight Trip to compact record, interning operator and city names (and long flight names)
+///
+/// @param trip[in] - Flight Trip
+/// @param dictionary[in/out] - Dictionary for operator, city and long flight names
+///
+/// @return compact_trip - Compact Flight Trip record
+CompactFlightTrip ToCompactFlightTrip(const FlightTrip& trip, StringDictionary& dictionary);
+
+/// @brief Convert compact record to Flight Trip
+///
+/// @param compact_trip[in] - Compact Flight Trip record
+/// @param dictionary[in] - Dictionary used to create the record
+///
+/// @return trip - Flight Trip
+FlightTrip ToFlightTrip(const CompactFlightTrip& compact_trip, const StringDictionary& dictionary);
+
+/// @brief Get flight number/name of compact record
+///
+/// @param compact_trip[in] - Compact Flight Trip record
+/// @param dictionary[in] - Dictionary used to create the record
+///
+/// @return name - Flight number/name
+std::string GetFlightName(const CompactFlightTrip& compact_trip, const StringDictionary& dictionary);
+
+/// @brief Check whether compact record has provided flight number/name (case-sensitive, without allocation)
+///
+/// @param compact_trip[in] - Compact Flight Trip record
+/// @param name[in] - Flight number/name
+/// @param dictionary[in] - Dictionary used to create the record
+///
+/// @return has_name - true if names are equal
+bool HasFlightName(const CompactFlightTrip& compact_trip, const std::string& name, const StringDictionary& dictionary);
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_COMPACT_FLIGHT_TRIP_H_
@@ -0,0 +1,83 @@
+///
+/// @file dictionary_column.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_DICTIONARY_COLUMN_H_
+#define FLIGHT_MANAGEMENT_DICTIONARY_COLUMN_H_
+
+#include "flight_management/logging.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace fms
+{
+/// @brief Immutable column, dictionary encoded.
+///
+/// Distinct values are stored once (sorted), each row stores the 16 bit code of its value. The distinct values
+/// double as exact zone map of the column: a value not in the dictionary does not occur in any row.
+///
+/// @tparam Value - Value type (less than comparable)
+template <typename Value>
+class DictionaryColumn
+{
+  public:
+    /// @brief Code of a value
+    using Code = std::uint16_t;
+
+    /// @brief Code returned for values which are not in the dictionary
+    static constexpr Code kNoCode{std::numeric_limits<Code>::max()};
+
+    /// @brief Constructor
+    /// @param values[in] - Values to encode (at most kNoCode distinct values)
+    explicit DictionaryColumn(const std::vector<Value>& values) : values_{values}, codes_{}
+    {
+        std::sort(values_.begin(), values_.end());
+        values_.erase(std::unique(values_.begin(), values_.end()), values_.end());
+        ASSERT_CHECK(values_.size() < kNoCode) << "Too many distinct values for dictionary column";
+
+        codes_.reserve(values.size());
+        std::transform(values.begin(), values.end(), std::back_inserter(codes_),
+                       [this](const auto& value) { return Find(value); });
+    }
+
+    /// @brief Find code of provided value
+    ///
+    /// @param value[in] - Value to search
+    ///
+    /// @return code - Code of value, kNoCode if value does not occur in the column
+    Code Find(const Value& value) const
+    {
+        const auto it = std::lower_bound(values_.begin(), values_.end(), value);
+        return ((it == values_.end()) || (value < *it)) ? kNoCode : static_cast<Code>(it - values_.begin());
+    }
+
+    /// @brief Get code at provided row
+    Code GetCode(const std::size_t row) const { return codes_[row]; }
+
+    /// @brief Get value at provided row
+    const Value& Get(const std::size_t row) const { return values_[codes_[row]]; }
+
+    /// @brief Get distinct values, indexed by code
+    const std::vector<Value>& GetValues() const { return values_; }
+
+    /// @brief Number of bytes used by the codes and distinct values (excluding heap memory owned by values)
+    std::size_t GetMemoryUsage() const { return (codes_.size() * sizeof(Code)) + (values_.size() * sizeof(Value)); }
+
+  private:
+    /// @brief Distinct values, sorted
+    std::vector<Value> values_;
+
+    /// @brief Code of each row
+    std::vector<Code> codes_;
+};
+
+template <typename Value>
+constexpr typename DictionaryColumn<Value>::Code DictionaryColumn<Value>::kNoCode;
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_DICTIONARY_COLUMN_H_
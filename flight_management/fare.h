@@ -0,0 +1,92 @@
+///
+/// @file fare.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_FARE_H_
+#define FLIGHT_MANAGEMENT_FARE_H_
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#if !defined(__SIZEOF_INT128__)
+#error "FixedPointFareSum needs __int128, a GCC/Clang extension; provide a two-word sum for other compilers"
+#endif
+
+namespace fms
+{
+/// @brief Fare in minor currency units (i.e. 1/100), fixed-point representation of double fare
+using FixedPointFare = std::int64_t;
+
+/// @brief Exact sum of fixed-point fares (128 bit, never overflows for any practical number of fares)
+///
+/// __int128 is a GCC/Clang extension, which is checked above.
+using FixedPointFareSum = __int128;
+
+/// @brief Number of minor currency units per major unit
+constexpr FixedPointFare kMinorUnitsPerMajorUnit{100};
+
+/// @brief Fare representation used by the database storage
+enum class FareRepresentation : std::uint8_t
+{
+    kFloatingPoint = 0U,
+    kFixedPoint = 1U
+};
+
+/// @brief Bound of fares in minor currency units representable by FixedPointFare (2^63, exact as double)
+constexpr double kFixedPointFareBound{9223372036854775808.0};
+
+/// @brief Check whether fare is finite and within the range of FixedPointFare
+inline bool IsFixedPointFare(const double fare)
+{
+    const auto minor_units = fare * static_cast<double>(kMinorUnitsPerMajorUnit);
+    return (minor_units >= -kFixedPointFareBound) && (minor_units < kFixedPointFareBound);
+}
+
+/// @brief Convert fare to fixed-point, rounding to nearest minor currency unit
+///
+/// llround is undefined for NaN, infinity and fares out of range, so these saturate instead: NaN maps to 0, all
+/// other fares to the nearest representable fixed-point fare (see IsFixedPointFare).
+inline FixedPointFare ToFixedPointFare(const double fare)
+{
+    const auto minor_units = fare * static_cast<double>(kMinorUnitsPerMajorUnit);
+    if (std::isnan(minor_units))
+    {
+        return 0;
+    }
+    if (minor_units < -kFixedPointFareBound)
+    {
+        return std::numeric_limits<FixedPointFare>::min();
+    }
+    if (minor_units >= kFixedPointFareBound)
+    {
+        return std::numeric_limits<FixedPointFare>::max();
+    }
+    return std::llround(minor_units);
+}
+
+/// @brief Convert fixed-point fare to fare
+inline double ToFare(const FixedPointFare fare)
+{
+    return static_cast<double>(fare) / static_cast<double>(kMinorUnitsPerMajorUnit);
+}
+
+/// @brief Convert sum of fixed-point fares to average fare
+///
+/// @param sum[in] - Exact sum of fixed-point fares
+/// @param count[in] - Number of summed fares
+///
+/// @return average - average fare (NaN if count is 0)
+inline double ToAverageFare(const FixedPointFareSum sum, const std::size_t count)
+{
+    // Divide exactly first, so that only the remainder is subject to rounding
+    const auto quotient = (count == 0U) ? FixedPointFareSum{0} : (sum / static_cast<FixedPointFareSum>(count));
+    const auto remainder = sum - (quotient * static_cast<FixedPointFareSum>(count));
+    const auto average = static_cast<double>(quotient) + (static_cast<double>(remainder) / static_cast<double>(count));
+    return average / static_cast<double>(kMinorUnitsPerMajorUnit);
+}
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_FARE_H_
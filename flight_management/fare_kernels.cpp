@@ -0,0 +1,69 @@
+///
+/// @file fare_kernels.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/fare_kernels.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+namespace fms
+{
+namespace
+{
+/// @brief Maximum number of fares accumulated before lanes are folded into the exact sum
+constexpr std::size_t kMaxFaresPerChunk{std::size_t{1U} << 31U};
+}  // namespace
+
+FixedPointFare FindMinFare(const FixedPointFare* fares, const std::size_t count)
+{
+    auto min_fare = std::numeric_limits<FixedPointFare>::max();
+    for (std::size_t idx = 0U; idx < count; ++idx)
+    {
+        min_fare = std::min(min_fare, fares[idx]);
+    }
+    return min_fare;
+}
+
+FixedPointFare FindMaxFare(const FixedPointFare* fares, const std::size_t count)
+{
+    auto max_fare = std::numeric_limits<FixedPointFare>::min();
+    for (std::size_t idx = 0U; idx < count; ++idx)
+    {
+        max_fare = std::max(max_fare, fares[idx]);
+    }
+    return max_fare;
+}
+
+FixedPointFare FindMaxFareOfKey(const FixedPointFare* fares, const std::uint32_t* keys, const std::uint32_t key,
+                                const std::size_t count)
+{
+    auto max_fare = std::numeric_limits<FixedPointFare>::min();
+    for (std::size_t idx = 0U; idx < count; ++idx)
+    {
+        const auto fare = (keys[idx] == key) ? fares[idx] : std::numeric_limits<FixedPointFare>::min();
+        max_fare = std::max(max_fare, fare);
+    }
+    return max_fare;
+}
+
+FixedPointFareSum SumFares(const FixedPointFare* fares, const std::size_t count)
+{
+    FixedPointFareSum sum{0};
+    for (std::size_t begin = 0U; begin < count; begin += kMaxFaresPerChunk)
+    {
+        const auto end = std::min(count, begin + kMaxFaresPerChunk);
+        std::int64_t high_sum = 0;
+        std::uint64_t low_sum = 0U;
+        for (std::size_t idx = begin; idx < end; ++idx)
+        {
+            high_sum += fares[idx] >> 32U;
+            low_sum += static_cast<std::uint64_t>(fares[idx]) & 0xFFFFFFFFU;
+        }
+        sum += (static_cast<FixedPointFareSum>(high_sum) * (FixedPointFareSum{1} << 32U)) + low_sum;
+    }
+    return sum;
+}
+
+}  // namespace fms
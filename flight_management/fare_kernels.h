@@ -0,0 +1,61 @@
+///
+/// @file fare_kernels.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_FARE_KERNELS_H_
+#define FLIGHT_MANAGEMENT_FARE_KERNELS_H_
+
+#include "flight_management/fare.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace fms
+{
+/// @brief Find minimum of fixed-point fares
+///
+/// Branch free integer loop, which compilers vectorize (e.g. SSE4.2/AVX2/AVX-512 64 bit compares).
+///
+/// @param fares[in] - Contiguous fixed-point fares
+/// @param count[in] - Number of fares
+///
+/// @return min_fare - minimum fare (max FixedPointFare if count is 0)
+FixedPointFare FindMinFare(const FixedPointFare* fares, const std::size_t count);
+
+/// @brief Find maximum of fixed-point fares (see FindMinFare)
+///
+/// @param fares[in] - Contiguous fixed-point fares
+/// @param count[in] - Number of fares
+///
+/// @return max_fare - maximum fare (min FixedPointFare if count is 0)
+FixedPointFare FindMaxFare(const FixedPointFare* fares, const std::size_t count);
+
+/// @brief Find maximum of fixed-point fares whose key (i.e. operator id) equals provided key
+///
+/// Fares of other keys are masked out by a select instead of a branch, so the loop vectorizes like FindMaxFare and
+/// neither gathers nor allocates.
+///
+/// @param fares[in] - Contiguous fixed-point fares
+/// @param keys[in] - Contiguous keys, one per fare
+/// @param key[in] - Key of fares to consider
+/// @param count[in] - Number of fares
+///
+/// @return max_fare - maximum fare (min FixedPointFare if no key matches)
+FixedPointFare FindMaxFareOfKey(const FixedPointFare* fares, const std::uint32_t* keys, const std::uint32_t key,
+                                const std::size_t count);
+
+/// @brief Sum fixed-point fares exactly
+///
+/// Each fare is split into its high (signed) and low (unsigned) 32 bit halves, which are accumulated in separate
+/// 64 bit lanes. Neither lane can overflow for less than 2^31 fares, hence the loop runs in chunks of that size and
+/// stays a plain (vectorizable) integer addition.
+///
+/// @param fares[in] - Contiguous fixed-point fares
+/// @param count[in] - Number of fares
+///
+/// @return sum - exact sum of fares
+FixedPointFareSum SumFares(const FixedPointFare* fares, const std::size_t count);
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_FARE_KERNELS_H_
@@ -5,11 +5,17 @@
 #ifndef FLIGHT_MANAGEMENT_FLIGHT_TRIP_H_
 #define FLIGHT_MANAGEMENT_FLIGHT_TRIP_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <ostream>
 #include <string>
+#include <vector>
 
 namespace fms
 {
+/// @brief Point in time, in seconds since Unix epoch (UTC)
+using Timestamp = std::int64_t;
+
 /// @brief Flight Trip Information
 struct FlightTrip
 {
@@ -27,6 +33,12 @@ struct FlightTrip
 
     /// @brief Fare
     double fare;
+
+    /// @brief Departure time
+    Timestamp departure_time{0};
+
+    /// @brief Arrival time
+    Timestamp arrival_time{0};
 };
 
 /// @brief Prepares output stream for detailing FlightTrip object (useful for logging)
@@ -39,7 +51,20 @@ inline std::ostream& operator<<(std::ostream& out, const FlightTrip& flight_trip
 {
     return out << "FlightTrip{name: " << flight_trip.name << ", operator: " << flight_trip.operated_by
                << ", origin_city: " << flight_trip.origin_city << ", destination_city: " << flight_trip.destination_city
-               << ", fare: " << flight_trip.fare << "}" << std::endl;
+               << ", fare: " << flight_trip.fare << ", departure_time: " << flight_trip.departure_time
+               << ", arrival_time: " << flight_trip.arrival_time << "}" << std::endl;
+}
+
+/// @brief Output stream for all the provided trips (vector) (useful for logging)
+///
+/// @param out[in/out] - Output stream
+/// @param trips[in] - List of Trips to stream on output
+///
+/// @return out - Output stream
+inline std::ostream& operator<<(std::ostream& out, const std::vector<FlightTrip> trips)
+{
+    std::for_each(trips.begin(), trips.end(), [&](const auto& trip) { out << " (+) " << trip; });
+    return out;
 }
 
 }  // namespace fms
@@ -3,102 +3,870 @@
 /// @copyright Copyright (c) 2020. All Rights Reserved.
 ///
 #include "flight_management/flight_trip_database.h"
+#include "flight_management/fare_kernels.h"
 #include "flight_management/logging.h"
+#include "flight_management/tracing.h"
 
 #include <algorithm>
+#include <cctype>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <numeric>
+#include <utility>
 
 namespace fms
 {
+namespace
+{
+/// @brief Order strings lexicographically, ignoring case (ASCII), i.e. in the order of trie prefix lookups
+bool IsLessIgnoringCase(const std::string& lhs, const std::string& rhs)
+{
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const char l, const char r) {
+        return std::tolower(static_cast<unsigned char>(l)) < std::tolower(static_cast<unsigned char>(r));
+    });
+}
+
+/// @brief Get dictionary id of operator or city field of stored trip
+StringId GetStringId(const CompactFlightTrip& trip, const TripField field)
+{
+    switch (field)
+    {
+        case TripField::kOperatedBy:
+            return trip.operated_by;
+        case TripField::kOriginCity:
+            return trip.origin_city;
+        case TripField::kDestinationCity:
+        default:
+            return trip.destination_city;
+    }
+}
+
+/// @brief Compare string field (name, operator or city) of two stored trips (see CompareTrips)
+int CompareStrings(const CompactFlightTrip& lhs, const CompactFlightTrip& rhs, const TripField field,
+                   const StringDictionary& dictionary)
+{
+    if (field == TripField::kName)
+    {
+        return GetFlightName(lhs, dictionary).compare(GetFlightName(rhs, dictionary));
+    }
+    return dictionary.Lookup(GetStringId(lhs, field)).compare(dictionary.Lookup(GetStringId(rhs, field)));
+}
+
+/// @brief Convert selected fields of stored trip to Flight Trip, other fields are left default
+FlightTrip ToSelectedFlightTrip(const CompactFlightTrip& trip, const FlightTripQuery& query,
+                                const StringDictionary& dictionary)
+{
+    FlightTrip flight_trip{};
+    flight_trip.name = query.IsSelected(TripField::kName) ? GetFlightName(trip, dictionary) : std::string{};
+    flight_trip.operated_by = query.IsSelected(TripField::kOperatedBy) ? dictionary.Lookup(trip.operated_by) : "";
+    flight_trip.origin_city = query.IsSelected(TripField::kOriginCity) ? dictionary.Lookup(trip.origin_city) : "";
+    flight_trip.destination_city =
+        query.IsSelected(TripField::kDestinationCity) ? dictionary.Lookup(trip.destination_city) : "";
+    flight_trip.fare = query.IsSelected(TripField::kFare) ? trip.fare : 0.0;
+    flight_trip.departure_time = query.IsSelected(TripField::kDepartureTime) ? trip.departure_time : 0;
+    flight_trip.arrival_time = query.IsSelected(TripField::kArrivalTime) ? trip.arrival_time : 0;
+    return flight_trip;
+}
+}  // namespace
+
+FlightTripDatabase::FlightTripDatabase(const FareRepresentation fare_representation)
+    : fare_representation_{fare_representation},
+      fixed_point_fares_{},
+      fixed_point_fare_operators_{},
+      dictionary_{},
+      trips_{},
+      trips_by_name_{},
+      trips_by_origin_city_{},
+      departures_by_origin_city_{},
+      departures_by_route_{},
+      cold_segments_{},
+      change_data_capture_{}
+{
+}
+
 void FlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
                                  const std::string& destination, const double& fare)
 {
+    AddTrip(name, operated_by, origin, destination, fare, 0, 0);
+}
+
+void FlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                                 const std::string& destination, const double& fare, const Timestamp departure_time,
+                                 const Timestamp arrival_time)
+{
+    TRACE_SPAN("FlightTripDatabase::AddTrip");
+    if (arrival_time < departure_time)
+    {
+        LOG(ERROR) << "Rejecting Trip {" << name << "}, arrival time is before departure time";
+        return;
+    }
+    if (!IsStorableFare(fare))
+    {
+        LOG(ERROR) << "Rejecting Trip {" << name << "}, fare {" << fare << "} is out of fixed-point range";
+        return;
+    }
+
     LOG(DEBUG) << "Adding Trip {" << name << "}";
-    trips_.push_back(FlightTrip{name, operated_by, origin, destination, fare});
+    const FlightTrip trip{name, operated_by, origin, destination, fare, departure_time, arrival_time};
+    const auto slot = trips_.size();
+    trips_.push_back(ToCompactFlightTrip(trip, dictionary_));
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        fixed_point_fares_.push_back(0);
+        fixed_point_fare_operators_.push_back(trips_.back().operated_by);
+        SetFare(slot, fare);
+    }
+    const auto& compact_trip = trips_.back();
+    trips_by_name_.Insert(name, slot);
+    trips_by_origin_city_.Insert(origin, slot);
+    departures_by_origin_city_.Insert(compact_trip.origin_city, departure_time, slot);
+    departures_by_route_.Insert(ScheduleIndex::MakeKey(compact_trip.origin_city, compact_trip.destination_city),
+                                departure_time, slot);
+    change_data_capture_.Publish(ChangeType::kAddTrip, trip);
 }
 
 void FlightTripDatabase::RemoveTrip(const std::string& name)
 {
+    TRACE_SPAN("FlightTripDatabase::RemoveTrip");
     LOG(DEBUG) << "Removing Trip {" << name << "}";
-    trips_.erase(std::remove_if(trips_.begin(), trips_.end(), [&name](const auto& trip) { return trip.name == name; }),
-                 trips_.end());
+    if (RemoveDepartures(name, std::numeric_limits<Timestamp>::min(), std::numeric_limits<Timestamp>::max()) > 0U)
+    {
+        change_data_capture_.Publish(ChangeType::kRemoveTrip, FlightTrip{name, {}, {}, {}, 0.0});
+    }
+}
+
+void FlightTripDatabase::RemoveTrip(const std::string& name, const Timestamp departure_time)
+{
+    TRACE_SPAN("FlightTripDatabase::RemoveTrip");
+    LOG(DEBUG) << "Removing Trip {" << name << "} departing at {" << departure_time << "}";
+    if (RemoveDepartures(name, departure_time, departure_time) > 0U)
+    {
+        change_data_capture_.Publish(ChangeType::kRemoveTripByDeparture,
+                                     FlightTrip{name, {}, {}, {}, 0.0, departure_time, departure_time});
+    }
 }
 
 void FlightTripDatabase::UpdateFareByTrip(const std::string& name, const double& fare)
 {
+    TRACE_SPAN("FlightTripDatabase::UpdateFareByTrip");
     LOG(DEBUG) << "Updating Fare for Trip {" << name << "}";
-    std::transform(trips_.begin(), trips_.end(), trips_.begin(), [&](auto& trip) {
-        if (trip.name == name)
-        {
-            trip.fare = fare;
-        }
-        return trip;
-    });
+    if (!IsStorableFare(fare))
+    {
+        LOG(ERROR) << "Rejecting Fare {" << fare << "} for Trip {" << name << "}, fare is out of fixed-point range";
+        return;
+    }
+    UpdateDepartureFares(name, std::numeric_limits<Timestamp>::min(), std::numeric_limits<Timestamp>::max(), fare);
+    change_data_capture_.Publish(ChangeType::kUpdateFareByTrip, FlightTrip{name, {}, {}, {}, fare});
+}
+
+void FlightTripDatabase::UpdateFareByTrip(const std::string& name, const Timestamp departure_time, const double& fare)
+{
+    TRACE_SPAN("FlightTripDatabase::UpdateFareByTrip");
+    LOG(DEBUG) << "Updating Fare for Trip {" << name << "} departing at {" << departure_time << "}";
+    if (!IsStorableFare(fare))
+    {
+        LOG(ERROR) << "Rejecting Fare {" << fare << "} for Trip {" << name << "}, fare is out of fixed-point range";
+        return;
+    }
+    UpdateDepartureFares(name, departure_time, departure_time, fare);
+    change_data_capture_.Publish(ChangeType::kUpdateFareByDeparture,
+                                 FlightTrip{name, {}, {}, {}, fare, departure_time, departure_time});
 }
 
 void FlightTripDatabase::UpdateFareByOperator(const std::string& operated_by, const double& fare)
 {
+    TRACE_SPAN("FlightTripDatabase::UpdateFareByOperator");
     LOG(DEBUG) << "Updating Fare for Operator {" << operated_by << "}";
-    std::transform(trips_.begin(), trips_.end(), trips_.begin(), [&](auto& trip) {
-        if (trip.operated_by == operated_by)
+    if (!IsStorableFare(fare))
+    {
+        LOG(ERROR) << "Rejecting Fare {" << fare << "} for Operator {" << operated_by
+                   << "}, fare is out of fixed-point range";
+        return;
+    }
+    const auto operator_id = dictionary_.Find(operated_by);
+    for (std::size_t slot = 0U; slot < trips_.size(); ++slot)
+    {
+        if (trips_[slot].operated_by == operator_id)
         {
-            trip.fare = fare;
+            SetFare(slot, fare);
         }
-        return trip;
-    });
+    }
+    if (operator_id != kInvalidStringId)
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                      [&](auto& segment) { segment.UpdateFaresByOperator(operator_id, ToStoredFare(fare)); });
+    }
+    change_data_capture_.Publish(ChangeType::kUpdateFareByOperator, FlightTrip{{}, operated_by, {}, {}, fare});
 }
 
-void FlightTripDatabase::DisplayAllTrips() const { LOG(INFO) << "Current available trips: " << std::endl << trips_; }
+void FlightTripDatabase::DisplayAllTrips() const
+{
+    TRACE_SPAN("FlightTripDatabase::DisplayAllTrips");
+    std::vector<FlightTrip> trips;
+    trips.reserve(trips_.size());
+    std::transform(trips_.begin(), trips_.end(), std::back_inserter(trips),
+                   [this](const auto& trip) { return ToFlightTrip(trip, dictionary_); });
+    std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                  [&](const auto& segment) { segment.FindByNamePrefix("", dictionary_, trips); });
+    LOG(INFO) << "Current available trips: " << std::endl << trips;
+}
 
 std::vector<FlightTrip> FlightTripDatabase::FindFlightByNumber(const std::string& name) const
 {
-    std::vector<FlightTrip> matches;
-    std::copy_if(trips_.begin(), trips_.end(), std::back_inserter(matches),
-                 [&name](const auto& trip) { return trip.name == name; });
-    return matches;
+    TRACE_SPAN("FlightTripDatabase::FindFlightByNumber");
+    std::vector<std::size_t> slots;
+    trips_by_name_.VisitExact(name, [&](const std::size_t slot) {
+        if (HasFlightName(trips_[slot], name, dictionary_))
+        {
+            slots.push_back(slot);
+        }
+        return true;
+    });
+    auto trips = ToFlightTrips(slots);
+    std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                  [&](const auto& segment) { segment.FindByName(name, dictionary_, trips); });
+    return trips;
 }
 
 std::vector<FlightTrip> FlightTripDatabase::FindFlightsByOriginCity(const std::string& origin_city) const
 {
-    std::vector<FlightTrip> matches;
-    std::copy_if(trips_.begin(), trips_.end(), std::back_inserter(matches),
-                 [&origin_city](const auto& trip) { return trip.origin_city == origin_city; });
-    return matches;
+    TRACE_SPAN("FlightTripDatabase::FindFlightsByOriginCity");
+    const auto origin_city_id = dictionary_.Find(origin_city);
+    std::vector<std::size_t> slots;
+    trips_by_origin_city_.VisitExact(origin_city, [&](const std::size_t slot) {
+        if (trips_[slot].origin_city == origin_city_id)
+        {
+            slots.push_back(slot);
+        }
+        return true;
+    });
+    auto trips = ToFlightTrips(slots);
+    if (origin_city_id != kInvalidStringId)
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(), [&](const auto& segment) {
+            segment.FindByOriginCity(origin_city_id, std::numeric_limits<Timestamp>::min(),
+                                     std::numeric_limits<Timestamp>::max(), dictionary_, trips);
+        });
+    }
+    return trips;
+}
+
+std::vector<FlightTrip> FlightTripDatabase::FindFlightsByNumberPrefix(const std::string& prefix) const
+{
+    TRACE_SPAN("FlightTripDatabase::FindFlightsByNumberPrefix");
+    auto trips = ToFlightTrips(trips_by_name_.FindPrefix(prefix));
+    if (!cold_segments_.empty())
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                      [&](const auto& segment) { segment.FindByNamePrefix(prefix, dictionary_, trips); });
+        std::stable_sort(trips.begin(), trips.end(),
+                         [](const auto& lhs, const auto& rhs) { return IsLessIgnoringCase(lhs.name, rhs.name); });
+    }
+    return trips;
+}
+
+std::vector<FlightTrip> FlightTripDatabase::FindFlightsByOriginCityPrefix(const std::string& prefix) const
+{
+    TRACE_SPAN("FlightTripDatabase::FindFlightsByOriginCityPrefix");
+    auto trips = ToFlightTrips(trips_by_origin_city_.FindPrefix(prefix));
+    if (!cold_segments_.empty())
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                      [&](const auto& segment) { segment.FindByOriginCityPrefix(prefix, dictionary_, trips); });
+        std::stable_sort(trips.begin(), trips.end(), [](const auto& lhs, const auto& rhs) {
+            return IsLessIgnoringCase(lhs.origin_city, rhs.origin_city);
+        });
+    }
+    return trips;
 }
 
 double FlightTripDatabase::FindAverageCostOfAllTrips() const
 {
+    TRACE_SPAN("FlightTripDatabase::FindAverageCostOfAllTrips");
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        auto sum = SumFares(fixed_point_fares_.data(), fixed_point_fares_.size());
+        std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                      [&sum](const auto& segment) { sum += segment.GetSumOfFares(); });
+        return ToAverageFare(sum, GetTotalTrips());
+    }
+
     double sum = 0.0;
     std::for_each(trips_.begin(), trips_.end(), [&sum](const auto& trip) { return sum += trip.fare; });
+    std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                  [&sum](const auto& segment) { sum += segment.GetSumOfUnroundedFares(); });
     return sum / static_cast<double>(GetTotalTrips());
 }
 
 double FlightTripDatabase::FindMinFareBetweenCities(const std::string& origin_city,
                                                     const std::string& destination_city) const
 {
+    TRACE_SPAN("FlightTripDatabase::FindMinFareBetweenCities");
+    return FindMinFareBetweenCitiesInTimeWindow(origin_city, destination_city, std::numeric_limits<Timestamp>::min(),
+                                                std::numeric_limits<Timestamp>::max());
+}
+
+std::vector<FlightTrip> FlightTripDatabase::FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                                const Timestamp from,
+                                                                                const Timestamp to) const
+{
+    TRACE_SPAN("FlightTripDatabase::FindFlightsByOriginCityInTimeWindow");
+    std::vector<FlightTrip> matches;
+    const auto origin_city_id = dictionary_.Find(origin_city);
+    if (origin_city_id == kInvalidStringId)
+    {
+        return matches;
+    }
+
+    const auto departures = departures_by_origin_city_.Find(origin_city_id, from, to);
+    std::transform(departures.first, departures.second, std::back_inserter(matches),
+                   [this](const auto& departure) { return ToFlightTrip(trips_[departure.second], dictionary_); });
+    if (!cold_segments_.empty())
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(), [&](const auto& segment) {
+            segment.FindByOriginCity(origin_city_id, from, to, dictionary_, matches);
+        });
+        std::stable_sort(matches.begin(), matches.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.departure_time < rhs.departure_time; });
+    }
+    return matches;
+}
+
+double FlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                                const std::string& destination_city,
+                                                                const Timestamp from, const Timestamp to) const
+{
+    TRACE_SPAN("FlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow");
     double min_fare = std::numeric_limits<double>::max();
-    std::for_each(trips_.begin(), trips_.end(), [&](const auto& trip) {
-        if (trip.origin_city == origin_city && trip.destination_city == destination_city)
+    const auto origin_city_id = dictionary_.Find(origin_city);
+    const auto destination_city_id = dictionary_.Find(destination_city);
+    if ((origin_city_id == kInvalidStringId) || (destination_city_id == kInvalidStringId))
+    {
+        return min_fare;
+    }
+
+    const auto departures =
+        departures_by_route_.Find(ScheduleIndex::MakeKey(origin_city_id, destination_city_id), from, to);
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        auto min_fixed_point_fare = std::numeric_limits<FixedPointFare>::max();
+        std::for_each(departures.first, departures.second, [&](const auto& departure) {
+            min_fixed_point_fare = std::min(min_fixed_point_fare, fixed_point_fares_[departure.second]);
+        });
+        if (departures.first != departures.second)
         {
-            min_fare = std::min(min_fare, trip.fare);
+            min_fare = ToFare(min_fixed_point_fare);
         }
+    }
+    else
+    {
+        std::for_each(departures.first, departures.second,
+                      [&](const auto& departure) { min_fare = std::min(min_fare, trips_[departure.second].fare); });
+    }
+    std::for_each(cold_segments_.begin(), cold_segments_.end(), [&](const auto& segment) {
+        min_fare = segment.FindMinFare(origin_city_id, destination_city_id, from, to, min_fare);
     });
     return min_fare;
 }
 
 double FlightTripDatabase::FindMaxFareByOperator(const std::string& operated_by) const
 {
+    TRACE_SPAN("FlightTripDatabase::FindMaxFareByOperator");
     double max_fare = std::numeric_limits<double>::min();
-    std::for_each(trips_.begin(), trips_.end(), [&](const auto& trip) {
-        if (trip.operated_by == operated_by)
+    const auto operator_id = dictionary_.Find(operated_by);
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        const auto max_fixed_point_fare = FindMaxFareOfKey(
+            fixed_point_fares_.data(), fixed_point_fare_operators_.data(), operator_id, fixed_point_fares_.size());
+        // Kernel returns min FixedPointFare also if operator has no trips, only then look for a trip of the operator
+        if ((max_fixed_point_fare != std::numeric_limits<FixedPointFare>::min()) ||
+            (std::find(fixed_point_fare_operators_.begin(), fixed_point_fare_operators_.end(), operator_id) !=
+             fixed_point_fare_operators_.end()))
         {
-            max_fare = std::max(max_fare, trip.fare);
+            max_fare = ToFare(max_fixed_point_fare);
         }
-    });
+    }
+    else
+    {
+        std::for_each(trips_.begin(), trips_.end(), [&](const auto& trip) {
+            if (trip.operated_by == operator_id)
+            {
+                max_fare = std::max(max_fare, trip.fare);
+            }
+        });
+    }
+    if (operator_id != kInvalidStringId)
+    {
+        std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                      [&](const auto& segment) { max_fare = segment.FindMaxFare(operator_id, max_fare); });
+    }
     return max_fare;
 }
 
-std::size_t FlightTripDatabase::GetTotalTrips(void) const { return trips_.size(); }
+std::size_t FlightTripDatabase::GetTotalTrips(void) const
+{
+    auto total_trips = trips_.size();
+    std::for_each(cold_segments_.begin(), cold_segments_.end(),
+                  [&total_trips](const auto& segment) { total_trips += segment.GetTotalTrips(); });
+    return total_trips;
+}
+
+void FlightTripDatabase::Execute(const FlightTripQuery& query, const TripConsumer& consumer) const
+{
+    TRACE_SPAN("FlightTripDatabase::Execute");
+    const auto& filter = query.GetFilter();
+    const auto& order = query.GetOrder();
+    const auto limit = query.GetLimit();
+    const auto resolved_query = ResolveQuery(query);
+    if ((resolved_query.plan.access_path == QueryAccessPath::kNone) || (limit == 0U))
+    {
+        return;
+    }
+
+    std::size_t count = 0U;
+    if (order.empty() || (resolved_query.plan.is_ordered && cold_segments_.empty()))
+    {
+        // Stream straight from the access path and then from the cold blocks, stopping as soon as the limit is reached
+        auto is_stopped = false;
+        VisitCandidates(resolved_query, filter, [&](const std::size_t slot) {
+            if (!Matches(slot, resolved_query, filter))
+            {
+                return true;
+            }
+            ++count;
+            is_stopped = !consumer(ToSelectedFlightTrip(trips_[slot], query, dictionary_)) || (count >= limit);
+            return !is_stopped;
+        });
+        if (!is_stopped)
+        {
+            ScanColdTrips(resolved_query, filter, [&](const FlightTrip& trip) {
+                ++count;
+                return consumer(query.Project(trip)) && (count < limit);
+            });
+        }
+        return;
+    }
+
+    const auto cold_trips = FindColdMatches(query, resolved_query);
+    std::vector<std::size_t> slots;
+    VisitCandidates(resolved_query, filter, [&](const std::size_t slot) {
+        if (Matches(slot, resolved_query, filter))
+        {
+            slots.push_back(slot);
+        }
+        return true;
+    });
+    if (!order.empty() && !resolved_query.plan.is_ordered)
+    {
+        TRACE_SPAN("FlightTripDatabase::Execute::Sort");
+        const auto compare_strings = [this](const auto& lhs, const auto& rhs, const TripField field) {
+            return CompareStrings(lhs, rhs, field, dictionary_);
+        };
+        const auto is_before = [&](const std::size_t lhs, const std::size_t rhs) {
+            return query.IsOrderedBefore(trips_[lhs], trips_[rhs], compare_strings);
+        };
+        const auto sorted_slots = std::min(slots.size(), limit);
+        std::partial_sort(slots.begin(), slots.begin() + static_cast<std::ptrdiff_t>(sorted_slots), slots.end(),
+                          is_before);
+        slots.resize(sorted_slots);
+    }
+
+    // Merge hot and cold matches, hot trips are decoded in full only to compare them with cold trips
+    auto slot = slots.begin();
+    auto cold_trip = cold_trips.begin();
+    FlightTrip hot_trip{};
+    bool is_hot_trip_decoded = false;
+    while ((count < limit) && ((slot != slots.end()) || (cold_trip != cold_trips.end())))
+    {
+        bool is_hot = (cold_trip == cold_trips.end());
+        if (!is_hot && (slot != slots.end()))
+        {
+            if (!order.empty() && !is_hot_trip_decoded)
+            {
+                hot_trip = ToFlightTrip(trips_[*slot], dictionary_);
+                is_hot_trip_decoded = true;
+            }
+            is_hot = order.empty() || !query.IsOrderedBefore(*cold_trip, hot_trip);
+        }
+
+        ++count;
+        auto result = !is_hot ? query.Project(*cold_trip++)
+                              : (is_hot_trip_decoded ? query.Project(std::move(hot_trip))
+                                                     : ToSelectedFlightTrip(trips_[*slot], query, dictionary_));
+        if (is_hot)
+        {
+            ++slot;
+            is_hot_trip_decoded = false;
+        }
+        if (!consumer(result))
+        {
+            break;
+        }
+    }
+}
+
+QueryPlan FlightTripDatabase::ExplainQuery(const FlightTripQuery& query) const { return ResolveQuery(query).plan; }
+
+std::shared_ptr<ChangeStream> FlightTripDatabase::SubscribeToChanges(const std::size_t capacity)
+{
+    return change_data_capture_.Subscribe(capacity);
+}
+
+std::shared_ptr<ChangeStream> FlightTripDatabase::SubscribeToChanges(const std::size_t capacity,
+                                                                     std::vector<FlightTrip>& snapshot)
+{
+    snapshot = FindFlightsByNumberPrefix("");
+    return change_data_capture_.Subscribe(capacity);
+}
+
+std::uint64_t FlightTripDatabase::GetLastChangeSequence() const { return change_data_capture_.GetLastSequence(); }
+
+void FlightTripDatabase::ArchiveTripsDepartedBefore(const Timestamp time)
+{
+    TRACE_SPAN("FlightTripDatabase::ArchiveTripsDepartedBefore");
+    LOG(DEBUG) << "Archiving Trips departed before {" << time << "}";
+    // Partition storage in a single pass, keeping the order of remaining trips, then rebuild indexes once
+    std::vector<CompactFlightTrip> archived_trips;
+    std::size_t kept_trips{0U};
+    for (std::size_t slot = 0U; slot < trips_.size(); ++slot)
+    {
+        if (trips_[slot].departure_time < time)
+        {
+            archived_trips.push_back(trips_[slot]);
+            continue;
+        }
+        trips_[kept_trips] = trips_[slot];
+        if (fare_representation_ == FareRepresentation::kFixedPoint)
+        {
+            fixed_point_fares_[kept_trips] = fixed_point_fares_[slot];
+            fixed_point_fare_operators_[kept_trips] = fixed_point_fare_operators_[slot];
+        }
+        ++kept_trips;
+    }
+    if (archived_trips.empty())
+    {
+        return;
+    }
+    trips_.resize(kept_trips);
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        fixed_point_fares_.resize(kept_trips);
+        fixed_point_fare_operators_.resize(kept_trips);
+    }
+    RebuildIndexes();
+    cold_segments_.emplace_back(std::move(archived_trips), dictionary_);
+}
+
+ColdTierStatistics FlightTripDatabase::GetColdTierStatistics() const
+{
+    ColdTierStatistics statistics{0U, 0U, 0U};
+    std::for_each(cold_segments_.begin(), cold_segments_.end(), [&statistics](const auto& segment) {
+        statistics.blocks_scanned += segment.GetStatistics().blocks_scanned;
+        statistics.blocks_skipped += segment.GetStatistics().blocks_skipped;
+        statistics.trips_decoded += segment.GetStatistics().trips_decoded;
+    });
+    return statistics;
+}
+
+FlightTripDatabase::ResolvedQuery FlightTripDatabase::ResolveQuery(const FlightTripQuery& query) const
+{
+    const auto& filter = query.GetFilter();
+    ResolvedQuery resolved_query{QueryPlan{QueryAccessPath::kNone, 0U, false}, kInvalidStringId, kInvalidStringId,
+                                 kInvalidStringId, TrieIndex::KeyMatch{TrieIndex::kNoNode, false, 0U}};
+    resolved_query.operated_by = filter.has_operated_by ? dictionary_.Find(filter.operated_by) : kInvalidStringId;
+    resolved_query.origin_city = filter.has_origin_city ? dictionary_.Find(filter.origin_city) : kInvalidStringId;
+    resolved_query.destination_city =
+        filter.has_destination_city ? dictionary_.Find(filter.destination_city) : kInvalidStringId;
+
+    // Names missing in the dictionary are neither stored in hot nor in cold trips
+    if (filter.matches_nothing || (filter.has_operated_by && (resolved_query.operated_by == kInvalidStringId)) ||
+        (filter.has_origin_city && (resolved_query.origin_city == kInvalidStringId)) ||
+        (filter.has_destination_city && (resolved_query.destination_city == kInvalidStringId)) ||
+        !(filter.min_fare < filter.max_fare) || (filter.departure_from >= filter.departure_to))
+    {
+        return resolved_query;
+    }
+
+    auto& plan = resolved_query.plan;
+    plan = QueryPlan{QueryAccessPath::kFullScan, trips_.size(), false};
+    const auto consider = [&plan](const QueryAccessPath access_path, const std::size_t candidates) {
+        // Indexes win ties with full scans, as they already apply their predicate
+        if ((candidates < plan.candidates) ||
+            ((candidates == plan.candidates) && (plan.access_path == QueryAccessPath::kFullScan)))
+        {
+            plan.access_path = access_path;
+            plan.candidates = candidates;
+        }
+    };
+    // Name matches are kept, so that VisitCandidates does not search the trie again
+    if (filter.has_name)
+    {
+        const auto name_match = trips_by_name_.MatchExact(filter.name);
+        consider(QueryAccessPath::kNameIndex, name_match.count);
+        if (plan.access_path == QueryAccessPath::kNameIndex)
+        {
+            resolved_query.name_match = name_match;
+        }
+    }
+    if (!filter.name_prefix.empty())
+    {
+        const auto name_match = trips_by_name_.MatchPrefix(filter.name_prefix);
+        consider(QueryAccessPath::kNamePrefixIndex, name_match.count);
+        if (plan.access_path == QueryAccessPath::kNamePrefixIndex)
+        {
+            resolved_query.name_match = name_match;
+        }
+    }
+    if (filter.has_origin_city && filter.has_destination_city)
+    {
+        const auto departures = departures_by_route_.Find(
+            ScheduleIndex::MakeKey(resolved_query.origin_city, resolved_query.destination_city), filter.departure_from,
+            filter.departure_to);
+        consider(QueryAccessPath::kRouteSchedule, static_cast<std::size_t>(departures.second - departures.first));
+    }
+    if (filter.has_origin_city)
+    {
+        const auto departures =
+            departures_by_origin_city_.Find(resolved_query.origin_city, filter.departure_from, filter.departure_to);
+        consider(QueryAccessPath::kOriginCitySchedule, static_cast<std::size_t>(departures.second - departures.first));
+    }
+
+    const auto& order = query.GetOrder();
+    plan.is_ordered = ((plan.access_path == QueryAccessPath::kRouteSchedule) ||
+                       (plan.access_path == QueryAccessPath::kOriginCitySchedule)) &&
+                      (order.size() == 1U) && (order.front().field == TripField::kDepartureTime) &&
+                      !order.front().descending;
+    return resolved_query;
+}
+
+void FlightTripDatabase::VisitCandidates(const ResolvedQuery& resolved_query, const FlightTripFilter& filter,
+                                         const std::function<bool(const std::size_t)>& visit) const
+{
+    const auto visit_departures = [&visit](const auto& departures) {
+        for (auto departure = departures.first; departure != departures.second; ++departure)
+        {
+            if (!visit(departure->second))
+            {
+                break;
+            }
+        }
+    };
+    switch (resolved_query.plan.access_path)
+    {
+        case QueryAccessPath::kNameIndex:
+        case QueryAccessPath::kNamePrefixIndex:
+            static_cast<void>(trips_by_name_.Visit(resolved_query.name_match, visit));
+            break;
+        case QueryAccessPath::kRouteSchedule:
+            visit_departures(departures_by_route_.Find(
+                ScheduleIndex::MakeKey(resolved_query.origin_city, resolved_query.destination_city),
+                filter.departure_from, filter.departure_to));
+            break;
+        case QueryAccessPath::kOriginCitySchedule:
+            visit_departures(departures_by_origin_city_.Find(resolved_query.origin_city, filter.departure_from,
+                                                             filter.departure_to));
+            break;
+        case QueryAccessPath::kFullScan:
+            for (std::size_t slot = 0U; slot < trips_.size(); ++slot)
+            {
+                if (!visit(slot))
+                {
+                    break;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+bool FlightTripDatabase::Matches(const std::size_t slot, const ResolvedQuery& resolved_query,
+                                 const FlightTripFilter& filter) const
+{
+    const auto& trip = trips_[slot];
+    const auto matches_fields =
+        (!filter.has_name || HasFlightName(trip, filter.name, dictionary_)) &&
+        (!filter.has_operated_by || (trip.operated_by == resolved_query.operated_by)) &&
+        (!filter.has_origin_city || (trip.origin_city == resolved_query.origin_city)) &&
+        (!filter.has_destination_city || (trip.destination_city == resolved_query.destination_city)) &&
+        (trip.fare >= filter.min_fare) && (trip.fare < filter.max_fare) &&
+        (trip.departure_time >= filter.departure_from) && (trip.departure_time < filter.departure_to) &&
+        (filter.name_prefix.empty() || filter.MatchesNamePrefix(GetFlightName(trip, dictionary_)));
+    if (!matches_fields || filter.predicates.empty())
+    {
+        return matches_fields;
+    }
+
+    // Custom predicates need the decoded trip
+    const auto flight_trip = ToFlightTrip(trip, dictionary_);
+    return std::all_of(filter.predicates.begin(), filter.predicates.end(),
+                       [&flight_trip](const auto& predicate) { return predicate(flight_trip); });
+}
+
+bool FlightTripDatabase::ScanColdTrips(const ResolvedQuery& resolved_query, const FlightTripFilter& filter,
+                                       const TripConsumer& visit) const
+{
+    return std::all_of(cold_segments_.begin(), cold_segments_.end(), [&](const auto& segment) {
+        return segment.Scan(filter, resolved_query.operated_by, resolved_query.origin_city,
+                            resolved_query.destination_city, dictionary_, visit);
+    });
+}
+
+std::vector<FlightTrip> FlightTripDatabase::FindColdMatches(const FlightTripQuery& query,
+                                                            const ResolvedQuery& resolved_query) const
+{
+    TRACE_SPAN("FlightTripDatabase::FindColdMatches");
+    // Heap of the first trips in query order seen so far, its front is the last of them
+    const auto is_before = [&query](const auto& lhs, const auto& rhs) { return query.IsOrderedBefore(lhs, rhs); };
+    const auto limit = query.GetLimit();
+    std::vector<FlightTrip> trips;
+    ScanColdTrips(resolved_query, query.GetFilter(), [&](const FlightTrip& trip) {
+        if (trips.size() < limit)
+        {
+            trips.push_back(trip);
+            std::push_heap(trips.begin(), trips.end(), is_before);
+        }
+        else if (is_before(trip, trips.front()))
+        {
+            std::pop_heap(trips.begin(), trips.end(), is_before);
+            trips.back() = trip;
+            std::push_heap(trips.begin(), trips.end(), is_before);
+        }
+        return true;
+    });
+    std::sort_heap(trips.begin(), trips.end(), is_before);
+    return trips;
+}
+
+std::size_t FlightTripDatabase::RemoveDepartures(const std::string& name, const Timestamp first_departure,
+                                                 const Timestamp last_departure)
+{
+    auto slots = trips_by_name_.FindExact(name);
+
+    // Remove highest slots first, so that moving the last trip never relocates a slot which is yet to be removed
+    std::sort(slots.begin(), slots.end(), std::greater<std::size_t>{});
+    std::size_t removed = 0U;
+    std::for_each(slots.begin(), slots.end(), [&](const auto slot) {
+        const auto& trip = trips_[slot];
+        if (HasFlightName(trip, name, dictionary_) && (trip.departure_time >= first_departure) &&
+            (trip.departure_time <= last_departure))
+        {
+            RemoveSlot(slot);
+            ++removed;
+        }
+    });
+    std::for_each(cold_segments_.begin(), cold_segments_.end(), [&](auto& segment) {
+        removed += segment.RemoveDepartures(name, first_departure, last_departure);
+    });
+    return removed;
+}
+
+void FlightTripDatabase::UpdateDepartureFares(const std::string& name, const Timestamp first_departure,
+                                              const Timestamp last_departure, const double fare)
+{
+    trips_by_name_.VisitExact(name, [&](const std::size_t slot) {
+        const auto& trip = trips_[slot];
+        if (HasFlightName(trip, name, dictionary_) && (trip.departure_time >= first_departure) &&
+            (trip.departure_time <= last_departure))
+        {
+            SetFare(slot, fare);
+        }
+        return true;
+    });
+    std::for_each(cold_segments_.begin(), cold_segments_.end(), [&](auto& segment) {
+        segment.UpdateFares(name, first_departure, last_departure, ToStoredFare(fare));
+    });
+}
+
+void FlightTripDatabase::RebuildIndexes()
+{
+    TRACE_SPAN("FlightTripDatabase::RebuildIndexes");
+    trips_by_name_ = TrieIndex{};
+    trips_by_origin_city_ = TrieIndex{};
+    std::vector<std::pair<ScheduleIndex::Key, ScheduleIndex::Entry>> departures_by_origin_city;
+    std::vector<std::pair<ScheduleIndex::Key, ScheduleIndex::Entry>> departures_by_route;
+    departures_by_origin_city.reserve(trips_.size());
+    departures_by_route.reserve(trips_.size());
+    for (std::size_t slot = 0U; slot < trips_.size(); ++slot)
+    {
+        const auto& trip = trips_[slot];
+        trips_by_name_.Insert(GetFlightName(trip, dictionary_), slot);
+        trips_by_origin_city_.Insert(dictionary_.Lookup(trip.origin_city), slot);
+        departures_by_origin_city.emplace_back(trip.origin_city, ScheduleIndex::Entry{trip.departure_time, slot});
+        departures_by_route.emplace_back(ScheduleIndex::MakeKey(trip.origin_city, trip.destination_city),
+                                         ScheduleIndex::Entry{trip.departure_time, slot});
+    }
+    departures_by_origin_city_.Rebuild(departures_by_origin_city);
+    departures_by_route_.Rebuild(departures_by_route);
+}
+
+void FlightTripDatabase::RemoveSlot(const std::size_t slot)
+{
+    TRACE_SPAN("FlightTripDatabase::RemoveSlot");
+    const auto& trip = trips_[slot];
+    trips_by_name_.Erase(GetFlightName(trip, dictionary_), slot);
+    trips_by_origin_city_.Erase(dictionary_.Lookup(trip.origin_city), slot);
+    departures_by_origin_city_.Erase(trip.origin_city, trip.departure_time, slot);
+    departures_by_route_.Erase(ScheduleIndex::MakeKey(trip.origin_city, trip.destination_city), trip.departure_time,
+                               slot);
+
+    const auto last_slot = trips_.size() - 1U;
+    if (slot != last_slot)
+    {
+        const auto& last_trip = trips_[last_slot];
+        trips_by_name_.Replace(GetFlightName(last_trip, dictionary_), last_slot, slot);
+        trips_by_origin_city_.Replace(dictionary_.Lookup(last_trip.origin_city), last_slot, slot);
+        departures_by_origin_city_.Replace(last_trip.origin_city, last_trip.departure_time, last_slot, slot);
+        departures_by_route_.Replace(ScheduleIndex::MakeKey(last_trip.origin_city, last_trip.destination_city),
+                                     last_trip.departure_time, last_slot, slot);
+        trips_[slot] = last_trip;
+        if (fare_representation_ == FareRepresentation::kFixedPoint)
+        {
+            fixed_point_fares_[slot] = fixed_point_fares_[last_slot];
+            fixed_point_fare_operators_[slot] = fixed_point_fare_operators_[last_slot];
+        }
+    }
+    trips_.pop_back();
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        fixed_point_fares_.pop_back();
+        fixed_point_fare_operators_.pop_back();
+    }
+}
+
+void FlightTripDatabase::SetFare(const std::size_t slot, const double fare)
+{
+    if (fare_representation_ == FareRepresentation::kFixedPoint)
+    {
+        // Fixed-point fare is authoritative, the record's fare is derived from it for decoding trips
+        fixed_point_fares_[slot] = ToFixedPointFare(fare);
+        trips_[slot].fare = ToFare(fixed_point_fares_[slot]);
+    }
+    else
+    {
+        trips_[slot].fare = fare;
+    }
+}
+
+bool FlightTripDatabase::IsStorableFare(const double fare) const
+{
+    return (fare_representation_ != FareRepresentation::kFixedPoint) || IsFixedPointFare(fare);
+}
+
+double FlightTripDatabase::ToStoredFare(const double fare) const
+{
+    return (fare_representation_ == FareRepresentation::kFixedPoint) ? ToFare(ToFixedPointFare(fare)) : fare;
+}
+
+std::vector<FlightTrip> FlightTripDatabase::ToFlightTrips(const std::vector<std::size_t>& slots) const
+{
+    TRACE_SPAN("FlightTripDatabase::ToFlightTrips");
+    std::vector<FlightTrip> flight_trips;
+    flight_trips.reserve(slots.size());
+    std::transform(slots.begin(), slots.end(), std::back_inserter(flight_trips),
+                   [this](const auto slot) { return ToFlightTrip(trips_[slot], dictionary_); });
+    return flight_trips;
+}
 
 }  // namespace fms
@@ -5,17 +5,66 @@
 #ifndef FLIGHT_MANAGEMENT_FLIGHT_TRIP_DATABASE_H_
 #define FLIGHT_MANAGEMENT_FLIGHT_TRIP_DATABASE_H_
 
+#include "flight_management/cache_aligned_allocator.h"
+#include "flight_management/change_data_capture.h"
+#include "flight_management/cold_trip_segment.h"
+#include "flight_management/compact_flight_trip.h"
+#include "flight_management/fare.h"
 #include "flight_management/i_flight_trip_database.h"
+#include "flight_management/schedule_index.h"
+#include "flight_management/string_dictionary.h"
+#include "flight_management/trie_index.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <ostream>
 
 namespace fms
 {
+/// @brief Access path used by FlightTripDatabase to find query candidates among hot trips
+enum class QueryAccessPath : std::uint8_t
+{
+    kNone = 0U,
+    kNameIndex = 1U,
+    kNamePrefixIndex = 2U,
+    kRouteSchedule = 3U,
+    kOriginCitySchedule = 4U,
+    kFullScan = 5U
+};
+
+/// @brief Execution plan of a query
+struct QueryPlan
+{
+    /// @brief Access path with fewest candidates (kNone if predicates match no trip)
+    QueryAccessPath access_path;
+
+    /// @brief Number of hot trips visited by the access path
+    std::size_t candidates;
+
+    /// @brief Whether access path yields trips in query order, so that results are streamed without sorting
+    bool is_ordered;
+};
+
 /// @brief Flight Trip Database Interface Implementation
+///
+/// Trips are stored as fixed size CompactFlightTrip records in cache line aligned storage; conversion from/to
+/// FlightTrip happens only at the API boundary. Flight names and origin cities are indexed in tries, which serve exact,
+/// prefix and case-insensitive lookups without scanning the table. Departures are indexed per origin city and per route
+/// in time ordered runs, which serve time window and route queries. Historical trips can be archived into compressed,
+/// immutable cold segments; all queries cover both hot and cold trips. Composed queries (see FlightTripQuery) are
+/// served from the index with fewest candidates, evaluating field predicates on stored records.
 class FlightTripDatabase : public IFlightTripDatabase
 {
   public:
+    /// @brief Constructor
+    ///
+    /// @param fare_representation[in] - Representation of stored fares. Fixed-point fares are rounded to minor currency
+    ///                                  units on insertion and aggregated exactly with integer kernels;
+    ///                                  fares which are not finite or out of their range are rejected.
+    explicit FlightTripDatabase(const FareRepresentation fare_representation = FareRepresentation::kFloatingPoint);
+
     /// @brief Destructor
     virtual ~FlightTripDatabase() = default;
 
@@ -26,10 +75,23 @@ class FlightTripDatabase : public IFlightTripDatabase
     /// @param origin[in] - Flight Origin City
     /// @param destination[in] - Flight Destination City
     /// @param fare[in] - Flight Airfare
-    ///
     virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
                          const std::string& destination, const double& fare) override;
 
+    /// @brief Add scheduled Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    /// @param departure_time[in] - Departure time
+    /// @param arrival_time[in] - Arrival time (not before departure time)
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare, const Timestamp departure_time,
+                         const Timestamp arrival_time) override;
+
     /// @brief Remove Trip from the database
     ///
     /// @param name[in] - Flight Number/name to be deleted from Database
@@ -37,11 +99,27 @@ class FlightTripDatabase : public IFlightTripDatabase
     ///
     virtual void RemoveTrip(const std::string& name) override;
 
+    /// @brief Remove one departure of a Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    /// @param departure_time[in] - Departure time of the trip to be deleted
+    ///                             If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name, const Timestamp departure_time) override;
+
     /// @brief Update Flight Fare for the provided Trip
     /// @param name[in] - Flight Number/name to be updated in Database
     ///                   If trip does not exist, function does nothing.
     virtual void UpdateFareByTrip(const std::string& name, const double& fare) override;
 
+    /// @brief Update Flight Fare for one departure of the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    /// @param departure_time[in] - Departure time of the trip to be updated
+    ///                             If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                  const double& fare) override;
+
     /// @brief Update Flight Fare for the provided Trip
     /// @param operated_by[in] - Flight operator to be updated in Database
     ///                          If trip does not exist, function does nothing.
@@ -65,6 +143,20 @@ class FlightTripDatabase : public IFlightTripDatabase
     /// @return flight_trips - list of flight trips
     virtual std::vector<FlightTrip> FindFlightsByOriginCity(const std::string& origin_city) const override;
 
+    /// @brief Find flight trips whose flight number/name starts with provided prefix, ignoring case (e.g. "6e-")
+    ///
+    /// @param prefix[in] - Flight Number/name prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by flight number/name
+    virtual std::vector<FlightTrip> FindFlightsByNumberPrefix(const std::string& prefix) const override;
+
+    /// @brief Find flight trips whose origin city starts with provided prefix, ignoring case (e.g. "beng")
+    ///
+    /// @param prefix[in] - Flight origin city prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by origin city
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityPrefix(const std::string& prefix) const override;
+
     /// @brief Find average cost of all the trips
     ///
     /// @return min_fare - average fare cost of flight trips
@@ -79,6 +171,29 @@ class FlightTripDatabase : public IFlightTripDatabase
     virtual double FindMinFareBetweenCities(const std::string& origin_city,
                                             const std::string& destination_city) const override;
 
+    /// @brief Find flight trips from provided origin city departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return flight_trips - list of flight trips, ordered by departure time
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                        const Timestamp from,
+                                                                        const Timestamp to) const override;
+
+    /// @brief Find minimum fare cost flight between provided cities departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities within time window
+    virtual double FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                        const std::string& destination_city, const Timestamp from,
+                                                        const Timestamp to) const override;
+
     /// @brief Find maximum fare cost flight trip from provided operator
     ///
     /// @param operated_by[in] - Flight operator
@@ -91,22 +206,194 @@ class FlightTripDatabase : public IFlightTripDatabase
     /// @return length - total number of trips in database
     virtual std::size_t GetTotalTrips(void) const override;
 
+    /// @brief Execute query, streaming matching trips in query order
+    ///
+    /// Candidates are taken from the access path with fewest candidates (see ExplainQuery) and filtered on stored
+    /// records; only matching trips are decoded, and only their selected fields. Unordered queries, and queries
+    /// ordered by ascending departure time served from a schedule (without cold trips), are streamed without collecting
+    /// candidates: hot trips first, then cold trips block by block, until the limit is reached or the consumer stops.
+    /// Other ordered queries sort candidate slots (partially, if limited) and merge them with the first cold trips in
+    /// query order, of which no more than the limit are kept while scanning.
+    ///
+    /// @param query[in] - Query (predicates, projection, ordering, limit)
+    /// @param consumer[in] - Called for each result, returns false to stop the query
+    virtual void Execute(const FlightTripQuery& query, const TripConsumer& consumer) const override;
+
+    /// @brief Get execution plan of query on hot trips
+    ///
+    /// @param query[in] - Query
+    ///
+    /// @return plan - Access path, estimated candidates and ordering
+    QueryPlan ExplainQuery(const FlightTripQuery& query) const;
+
+    /// @brief Subscribe to stream of mutations (Change Data Capture), i.e. to keep replicas in sync
+    ///
+    /// @param capacity[in] - Maximum number of unconsumed change events (must be power of two)
+    ///
+    /// @return stream - Stream of change events, starting with next mutation
+    std::shared_ptr<ChangeStream> SubscribeToChanges(const std::size_t capacity);
+
+    /// @brief Subscribe to stream of mutations, together with a snapshot of all trips the mutations apply to (i.e. to
+    ///        bootstrap a replica at any time, see ReplicaApplier)
+    ///
+    /// @param capacity[in] - Maximum number of unconsumed change events (must be power of two)
+    /// @param snapshot[out] - All trips, hot and archived, before the next mutation
+    ///
+    /// @return stream - Stream of change events, starting with next mutation
+    std::shared_ptr<ChangeStream> SubscribeToChanges(const std::size_t capacity, std::vector<FlightTrip>& snapshot);
+
+    /// @brief Get sequence number of last published change event (0 if none), i.e. to measure replication lag
+    std::uint64_t GetLastChangeSequence() const;
+
+    /// @brief Move all trips departed before provided time into a new compressed cold segment
+    ///
+    /// Archived trips remain visible to all queries, keep their exact fares and are still removed and updated by all
+    /// mutations. Archiving changes storage only, hence is not published as change event (replicas archive on their
+    /// own schedule).
+    ///
+    /// @param time[in] - Trips with departure time before this time are archived
+    void ArchiveTripsDepartedBefore(const Timestamp time);
+
+    /// @brief Get block scan statistics accumulated over all cold segments
+    ///
+    /// @return statistics - scanned/skipped block and decoded trip counters
+    ColdTierStatistics GetColdTierStatistics() const;
+
   private:
+    /// @brief Query resolved against storage
+    struct ResolvedQuery
+    {
+        /// @brief Execution plan
+        QueryPlan plan;
+
+        /// @brief Dictionary id of flight operator (if constrained)
+        StringId operated_by;
+
+        /// @brief Dictionary id of origin city (if constrained)
+        StringId origin_city;
+
+        /// @brief Dictionary id of destination city (if constrained)
+        StringId destination_city;
+
+        /// @brief Flight names matching name or name prefix, visited by access paths kNameIndex and kNamePrefixIndex
+        TrieIndex::KeyMatch name_match;
+    };
+
+    /// @brief Resolve query predicates to dictionary ids and choose access path
+    ///
+    /// @param query[in] - Query
+    ///
+    /// @return resolved_query - Resolved query
+    ResolvedQuery ResolveQuery(const FlightTripQuery& query) const;
+
+    /// @brief Visit candidate slots of the access path, in access path order
+    ///
+    /// @param resolved_query[in] - Resolved query
+    /// @param filter[in] - Query predicates
+    /// @param visit[in] - Called for each candidate slot, returns false to stop
+    void VisitCandidates(const ResolvedQuery& resolved_query, const FlightTripFilter& filter,
+                         const std::function<bool(const std::size_t)>& visit) const;
+
+    /// @brief Check whether trip stored at provided slot matches query predicates
+    ///
+    /// @param slot[in] - Slot of trip
+    /// @param resolved_query[in] - Resolved query
+    /// @param filter[in] - Query predicates
+    ///
+    /// @return matches - true if all predicates match
+    bool Matches(const std::size_t slot, const ResolvedQuery& resolved_query, const FlightTripFilter& filter) const;
+
+    /// @brief Visit matching cold trips, segment by segment (see ColdTripSegment::Scan)
+    ///
+    /// @param resolved_query[in] - Resolved query
+    /// @param filter[in] - Query predicates
+    /// @param visit[in] - Called for each matching trip, returns false to stop
+    ///
+    /// @return completed - false if visit stopped the scan
+    bool ScanColdTrips(const ResolvedQuery& resolved_query, const FlightTripFilter& filter,
+                       const TripConsumer& visit) const;
+
+    /// @brief Find first matching cold trips in query order, keeping no more than the query limit while scanning
+    ///
+    /// @param query[in] - Ordered query
+    /// @param resolved_query[in] - Resolved query
+    ///
+    /// @return flight_trips - list of matching cold trips
+    std::vector<FlightTrip> FindColdMatches(const FlightTripQuery& query, const ResolvedQuery& resolved_query) const;
+
+    /// @brief Remove trips with provided flight number/name departing within [first_departure, last_departure]
+    ///
+    /// @return removed - number of removed hot and cold trips
+    std::size_t RemoveDepartures(const std::string& name, const Timestamp first_departure,
+                                 const Timestamp last_departure);
+
+    /// @brief Update fare of trips with provided flight number/name departing within [first_departure,
+    ///        last_departure]
+    void UpdateDepartureFares(const std::string& name, const Timestamp first_departure,
+                              const Timestamp last_departure, const double fare);
+
+    /// @brief Rebuild all indexes from trip storage (i.e. after many trips have been moved at once)
+    void RebuildIndexes();
+
+    /// @brief Remove trip stored at provided slot, moving last trip into its place
+    ///
+    /// @param slot[in] - Slot of trip to remove
+    void RemoveSlot(const std::size_t slot);
+
+    /// @brief Set fare of trip stored at provided slot
+    ///
+    /// @param slot[in] - Slot of trip
+    /// @param fare[in] - Flight fare
+    void SetFare(const std::size_t slot, const double fare);
+
+    /// @brief Check whether fare can be stored (FareRepresentation::kFixedPoint needs a finite fare within its range)
+    bool IsStorableFare(const double fare) const;
+
+    /// @brief Get fare as stored (rounded to minor currency units by FareRepresentation::kFixedPoint)
+    double ToStoredFare(const double fare) const;
+
+    /// @brief Convert trips stored at provided slots to Flight Trips
+    ///
+    /// @param slots[in] - Slots of trips
+    ///
+    /// @return flight_trips - list of flight trips
+    std::vector<FlightTrip> ToFlightTrips(const std::vector<std::size_t>& slots) const;
+
+    /// @brief Representation of stored fares
+    const FareRepresentation fare_representation_;
+
+    /// @brief Fixed-point fares of all trips, same slots as trips_ (used by FareRepresentation::kFixedPoint only).
+    ///        These are authoritative, the fares of the records in trips_ are derived from them by SetFare.
+    std::vector<FixedPointFare, CacheAlignedAllocator<FixedPointFare>> fixed_point_fares_;
+
+    /// @brief Operators of all trips, same slots as fixed_point_fares_ (used by FareRepresentation::kFixedPoint only),
+    ///        so that fares of an operator are found by scanning two contiguous columns
+    std::vector<StringId, CacheAlignedAllocator<StringId>> fixed_point_fare_operators_;
+
+    /// @brief Dictionary for operator and city names
+    StringDictionary dictionary_;
+
     /// @brief List of all the added Trip in database
-    std::vector<FlightTrip> trips_;
-};
+    std::vector<CompactFlightTrip, CacheAlignedAllocator<CompactFlightTrip>> trips_;
 
-/// @brief Output stream for all the provided trips (vector) (useful for logging)
-///
-/// @param out[in/out] - Output stream
-/// @param trips[in] - List of Trips to stream on output
-///
-/// @return out - Output stream
-inline std::ostream& operator<<(std::ostream& out, const std::vector<FlightTrip> trips)
-{
-    std::for_each(trips.begin(), trips.end(), [&](const auto& trip) { out << " (+) " << trip; });
-    return out;
-}
+    /// @brief Index from flight number/name to trip slots
+    TrieIndex trips_by_name_;
+
+    /// @brief Index from origin city to trip slots
+    TrieIndex trips_by_origin_city_;
+
+    /// @brief Time ordered index from origin city to trip slots
+    ScheduleIndex departures_by_origin_city_;
+
+    /// @brief Time ordered index from route (origin city, destination city) to trip slots
+    ScheduleIndex departures_by_route_;
+
+    /// @brief Compressed segments of archived trips (cold tier)
+    std::vector<ColdTripSegment> cold_segments_;
+
+    /// @brief Publisher of mutations to subscribed change streams
+    ChangeDataCapture change_data_capture_;
+};
 
 }  // namespace fms
 
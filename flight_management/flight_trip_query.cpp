@@ -0,0 +1,220 @@
+///
+/// @file flight_trip_query.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/flight_trip_query.h"
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/tracing.h"
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+
+namespace fms
+{
+namespace
+{
+/// @brief Bit mask of all fields
+constexpr std::uint32_t kAllFields{(1U << 7U) - 1U};
+
+bool StartsWithIgnoringCase(const std::string& value, const std::string& prefix)
+{
+    return (value.size() >= prefix.size()) &&
+           std::equal(prefix.begin(), prefix.end(), value.begin(), [](const char lhs, const char rhs) {
+               return std::tolower(static_cast<unsigned char>(lhs)) == std::tolower(static_cast<unsigned char>(rhs));
+           });
+}
+
+/// @brief Add equality predicate, contradicting equality predicates on the same field match nothing
+void Constrain(const std::string& value, bool& has_value, std::string& constrained_value, bool& matches_nothing)
+{
+    matches_nothing = matches_nothing || (has_value && (constrained_value != value));
+    has_value = true;
+    constrained_value = value;
+}
+
+/// @brief Get value of string field (name, operator or city) of trip
+const std::string& GetString(const FlightTrip& trip, const TripField field)
+{
+    switch (field)
+    {
+        case TripField::kName:
+            return trip.name;
+        case TripField::kOperatedBy:
+            return trip.operated_by;
+        case TripField::kOriginCity:
+            return trip.origin_city;
+        case TripField::kDestinationCity:
+        default:
+            return trip.destination_city;
+    }
+}
+}  // namespace
+
+bool FlightTripFilter::Matches(const FlightTrip& trip) const
+{
+    const auto matches_fields =
+        !matches_nothing && (!has_name || (trip.name == name)) && MatchesNamePrefix(trip.name) &&
+        (!has_operated_by || (trip.operated_by == operated_by)) &&
+        (!has_origin_city || (trip.origin_city == origin_city)) &&
+        (!has_destination_city || (trip.destination_city == destination_city)) && (trip.fare >= min_fare) &&
+        (trip.fare < max_fare) && (trip.departure_time >= departure_from) && (trip.departure_time < departure_to);
+    return matches_fields && std::all_of(predicates.begin(), predicates.end(),
+                                         [&trip](const auto& predicate) { return predicate(trip); });
+}
+
+bool FlightTripFilter::MatchesNamePrefix(const std::string& name) const
+{
+    return StartsWithIgnoringCase(name, name_prefix);
+}
+
+FlightTripQuery::FlightTripQuery(const IFlightTripDatabase& database)
+    : database_{&database},
+      filter_{},
+      order_{},
+      limit_{std::numeric_limits<std::size_t>::max()},
+      selected_fields_{kAllFields}
+{
+}
+
+FlightTripQuery& FlightTripQuery::WhereName(const std::string& name)
+{
+    Constrain(name, filter_.has_name, filter_.name, filter_.matches_nothing);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereNamePrefix(const std::string& prefix)
+{
+    // Keep the longer of both prefixes, unless they contradict each other
+    if (StartsWithIgnoringCase(prefix, filter_.name_prefix))
+    {
+        filter_.name_prefix = prefix;
+    }
+    else if (!StartsWithIgnoringCase(filter_.name_prefix, prefix))
+    {
+        filter_.matches_nothing = true;
+    }
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereOperatedBy(const std::string& operated_by)
+{
+    Constrain(operated_by, filter_.has_operated_by, filter_.operated_by, filter_.matches_nothing);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereOriginCity(const std::string& origin_city)
+{
+    Constrain(origin_city, filter_.has_origin_city, filter_.origin_city, filter_.matches_nothing);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereDestinationCity(const std::string& destination_city)
+{
+    Constrain(destination_city, filter_.has_destination_city, filter_.destination_city, filter_.matches_nothing);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereFareBetween(const double min_fare, const double max_fare)
+{
+    filter_.min_fare = std::max(filter_.min_fare, min_fare);
+    filter_.max_fare = std::min(filter_.max_fare, max_fare);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::WhereFareBelow(const double max_fare)
+{
+    return WhereFareBetween(std::numeric_limits<double>::lowest(), max_fare);
+}
+
+FlightTripQuery& FlightTripQuery::WhereDepartureBetween(const Timestamp from, const Timestamp to)
+{
+    filter_.departure_from = std::max(filter_.departure_from, from);
+    filter_.departure_to = std::min(filter_.departure_to, to);
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::Where(TripPredicate predicate)
+{
+    filter_.predicates.push_back(std::move(predicate));
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::Select(std::initializer_list<TripField> fields)
+{
+    selected_fields_ = 0U;
+    std::for_each(fields.begin(), fields.end(),
+                  [this](const auto field) { selected_fields_ |= 1U << static_cast<std::uint32_t>(field); });
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::OrderBy(const TripField field, const bool descending)
+{
+    order_.push_back(TripOrder{field, descending});
+    return *this;
+}
+
+FlightTripQuery& FlightTripQuery::Limit(const std::size_t limit)
+{
+    limit_ = std::min(limit_, limit);
+    return *this;
+}
+
+std::size_t FlightTripQuery::ForEach(const TripConsumer& consumer) const
+{
+    TRACE_SPAN("FlightTripQuery::ForEach");
+    std::size_t count = 0U;
+    if (limit_ > 0U)
+    {
+        database_->Execute(*this, [&](const FlightTrip& trip) {
+            ++count;
+            return consumer(trip) && (count < limit_);
+        });
+    }
+    return count;
+}
+
+std::vector<FlightTrip> FlightTripQuery::ToVector() const
+{
+    std::vector<FlightTrip> trips;
+    ForEach([&trips](const FlightTrip& trip) {
+        trips.push_back(trip);
+        return true;
+    });
+    return trips;
+}
+
+const FlightTripFilter& FlightTripQuery::GetFilter() const { return filter_; }
+
+const std::vector<TripOrder>& FlightTripQuery::GetOrder() const { return order_; }
+
+std::size_t FlightTripQuery::GetLimit() const { return limit_; }
+
+bool FlightTripQuery::IsSelected(const TripField field) const
+{
+    return (selected_fields_ & (1U << static_cast<std::uint32_t>(field))) != 0U;
+}
+
+bool FlightTripQuery::IsOrderedBefore(const FlightTrip& lhs, const FlightTrip& rhs) const
+{
+    return IsOrderedBefore(lhs, rhs, [](const FlightTrip& lhs_trip, const FlightTrip& rhs_trip, const TripField field) {
+        return GetString(lhs_trip, field).compare(GetString(rhs_trip, field));
+    });
+}
+
+FlightTrip FlightTripQuery::Project(FlightTrip trip) const
+{
+    if (selected_fields_ != kAllFields)
+    {
+        trip = FlightTrip{IsSelected(TripField::kName) ? std::move(trip.name) : std::string{},
+                          IsSelected(TripField::kOperatedBy) ? std::move(trip.operated_by) : std::string{},
+                          IsSelected(TripField::kOriginCity) ? std::move(trip.origin_city) : std::string{},
+                          IsSelected(TripField::kDestinationCity) ? std::move(trip.destination_city) : std::string{},
+                          IsSelected(TripField::kFare) ? trip.fare : 0.0,
+                          IsSelected(TripField::kDepartureTime) ? trip.departure_time : 0,
+                          IsSelected(TripField::kArrivalTime) ? trip.arrival_time : 0};
+    }
+    return trip;
+}
+
+}  // namespace fms
@@ -0,0 +1,263 @@
+///
+/// @file flight_trip_query.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_FLIGHT_TRIP_QUERY_H_
+#define FLIGHT_MANAGEMENT_FLIGHT_TRIP_QUERY_H_
+
+#include "flight_management/flight_trip.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+class IFlightTripDatabase;
+
+/// @brief Field of Flight Trip, used for projection and ordering
+enum class TripField : std::uint8_t
+{
+    kName = 0U,
+    kOperatedBy = 1U,
+    kOriginCity = 2U,
+    kDestinationCity = 3U,
+    kFare = 4U,
+    kDepartureTime = 5U,
+    kArrivalTime = 6U
+};
+
+/// @brief Predicate on Flight Trip (returns true if trip matches)
+using TripPredicate = std::function<bool(const FlightTrip&)>;
+
+/// @brief Consumer of query results (returns false to stop the query)
+using TripConsumer = std::function<bool(const FlightTrip&)>;
+
+/// @brief Conjunction of predicates on Flight Trips. Unconstrained fields match all trips.
+///
+/// Field predicates are known to query engines, which serve them from indexes and evaluate them on stored records.
+/// Custom predicates are evaluated on decoded trips which pass all field predicates.
+struct FlightTripFilter
+{
+    /// @brief Check whether provided trip matches all predicates
+    bool Matches(const FlightTrip& trip) const;
+
+    /// @brief Check whether provided flight name starts with name_prefix, ignoring case
+    bool MatchesNamePrefix(const std::string& name) const;
+
+    /// @brief Whether predicates contradict each other (i.e. two different flight names)
+    bool matches_nothing{false};
+
+    /// @brief Whether flight name must be equal to name
+    bool has_name{false};
+
+    /// @brief Flight name (case-sensitive)
+    std::string name{};
+
+    /// @brief Flight name prefix (case-insensitive, empty matches all trips)
+    std::string name_prefix{};
+
+    /// @brief Whether flight operator must be equal to operated_by
+    bool has_operated_by{false};
+
+    /// @brief Flight operator
+    std::string operated_by{};
+
+    /// @brief Whether origin city must be equal to origin_city
+    bool has_origin_city{false};
+
+    /// @brief Origin city
+    std::string origin_city{};
+
+    /// @brief Whether destination city must be equal to destination_city
+    bool has_destination_city{false};
+
+    /// @brief Destination city
+    std::string destination_city{};
+
+    /// @brief Lowest fare (inclusive)
+    double min_fare{std::numeric_limits<double>::lowest()};
+
+    /// @brief Highest fare (exclusive)
+    double max_fare{std::numeric_limits<double>::infinity()};
+
+    /// @brief Earliest departure time (inclusive)
+    Timestamp departure_from{std::numeric_limits<Timestamp>::min()};
+
+    /// @brief Latest departure time (exclusive)
+    Timestamp departure_to{std::numeric_limits<Timestamp>::max()};
+
+    /// @brief Custom predicates
+    std::vector<TripPredicate> predicates{};
+};
+
+/// @brief Ordering key of query results
+struct TripOrder
+{
+    /// @brief Field to order by
+    TripField field;
+
+    /// @brief Whether to order by descending field values
+    bool descending;
+};
+
+/// @brief Compare provided field of two trips, the comparator shared by all trip representations
+///
+/// @param lhs[in] - Trip (FlightTrip or stored record, any type with fare, departure_time and arrival_time members)
+/// @param rhs[in] - Trip
+/// @param field[in] - Field to compare
+/// @param compare_strings[in] - Compares string field (name, operator or city) of lhs and rhs, like std::string
+///
+/// @return comparison - negative if lhs is less, zero if equal, positive if lhs is greater
+template <typename Trip, typename CompareStrings>
+int CompareTrips(const Trip& lhs, const Trip& rhs, const TripField field, const CompareStrings& compare_strings)
+{
+    const auto compare_values = [](const auto& lhs_value, const auto& rhs_value) {
+        return (lhs_value < rhs_value) ? -1 : ((rhs_value < lhs_value) ? 1 : 0);
+    };
+    switch (field)
+    {
+        case TripField::kName:
+        case TripField::kOperatedBy:
+        case TripField::kOriginCity:
+        case TripField::kDestinationCity:
+            return compare_strings(lhs, rhs, field);
+        case TripField::kFare:
+            return compare_values(lhs.fare, rhs.fare);
+        case TripField::kDepartureTime:
+            return compare_values(lhs.departure_time, rhs.departure_time);
+        case TripField::kArrivalTime:
+            return compare_values(lhs.arrival_time, rhs.arrival_time);
+        default:
+            return 0;
+    }
+}
+
+/// @brief Lazy, composable query over Flight Trips of a database (see IFlightTripDatabase::Query).
+///
+/// Building a query only records predicates, projection, ordering and limit; the database executes it when its
+/// results are consumed, choosing the most selective index for the predicates and streaming matching trips to the
+/// consumer one by one. i.e.
+///
+///     database.Query().WhereOperatedBy("Indigo").WhereOriginCity("Pune").WhereFareBelow(5000.0).Limit(10).ToVector()
+class FlightTripQuery
+{
+  public:
+    /// @brief Constructor
+    /// @param database[in] - Database to execute the query on (must outlive the query)
+    explicit FlightTripQuery(const IFlightTripDatabase& database);
+
+    /// @brief Match trips with provided flight number/name (case-sensitive)
+    FlightTripQuery& WhereName(const std::string& name);
+
+    /// @brief Match trips whose flight number/name starts with provided prefix, ignoring case
+    FlightTripQuery& WhereNamePrefix(const std::string& prefix);
+
+    /// @brief Match trips of provided flight operator
+    FlightTripQuery& WhereOperatedBy(const std::string& operated_by);
+
+    /// @brief Match trips from provided origin city
+    FlightTripQuery& WhereOriginCity(const std::string& origin_city);
+
+    /// @brief Match trips to provided destination city
+    FlightTripQuery& WhereDestinationCity(const std::string& destination_city);
+
+    /// @brief Match trips with fare within [min_fare, max_fare)
+    FlightTripQuery& WhereFareBetween(const double min_fare, const double max_fare);
+
+    /// @brief Match trips with fare below provided fare
+    FlightTripQuery& WhereFareBelow(const double max_fare);
+
+    /// @brief Match trips departing within time window [from, to)
+    FlightTripQuery& WhereDepartureBetween(const Timestamp from, const Timestamp to);
+
+    /// @brief Match trips satisfying custom predicate (evaluated after all field predicates)
+    FlightTripQuery& Where(TripPredicate predicate);
+
+    /// @brief Return only provided fields, other fields of results are left default (empty/zero)
+    FlightTripQuery& Select(std::initializer_list<TripField> fields);
+
+    /// @brief Order results by provided field; subsequent calls add lower priority ordering keys. Trips equal on all
+    ///        ordering keys are returned in unspecified order, as are trips of unordered queries.
+    FlightTripQuery& OrderBy(const TripField field, const bool descending = false);
+
+    /// @brief Return at most provided number of results
+    FlightTripQuery& Limit(const std::size_t limit);
+
+    /// @brief Execute query, streaming results to consumer
+    ///
+    /// @param consumer[in] - Called for each result, returns false to stop the query
+    ///
+    /// @return count - number of results passed to consumer
+    std::size_t ForEach(const TripConsumer& consumer) const;
+
+    /// @brief Execute query, collecting results
+    ///
+    /// @return flight_trips - list of results
+    std::vector<FlightTrip> ToVector() const;
+
+    /// @brief Get predicates of the query
+    const FlightTripFilter& GetFilter() const;
+
+    /// @brief Get ordering keys of the query (highest priority first)
+    const std::vector<TripOrder>& GetOrder() const;
+
+    /// @brief Get maximum number of results
+    std::size_t GetLimit() const;
+
+    /// @brief Check whether provided field is returned by the query
+    bool IsSelected(const TripField field) const;
+
+    /// @brief Check whether lhs is ordered before rhs by the ordering keys of the query
+    bool IsOrderedBefore(const FlightTrip& lhs, const FlightTrip& rhs) const;
+
+    /// @brief Check whether lhs is ordered before rhs by the ordering keys of the query (any trip representation, see
+    ///        CompareTrips)
+    template <typename Trip, typename CompareStrings>
+    bool IsOrderedBefore(const Trip& lhs, const Trip& rhs, const CompareStrings& compare_strings) const;
+
+    /// @brief Clear fields not returned by the query
+    ///
+    /// @param trip[in] - Matching trip
+    ///
+    /// @return trip - Trip holding selected fields only
+    FlightTrip Project(FlightTrip trip) const;
+
+  private:
+    /// @brief Database to execute the query on
+    const IFlightTripDatabase* database_;
+
+    /// @brief Predicates
+    FlightTripFilter filter_;
+
+    /// @brief Ordering keys
+    std::vector<TripOrder> order_;
+
+    /// @brief Maximum number of results
+    std::size_t limit_;
+
+    /// @brief Bit mask of selected fields (bit index is TripField value)
+    std::uint32_t selected_fields_;
+};
+
+template <typename Trip, typename CompareStrings>
+bool FlightTripQuery::IsOrderedBefore(const Trip& lhs, const Trip& rhs, const CompareStrings& compare_strings) const
+{
+    for (const auto& order : order_)
+    {
+        const auto comparison = CompareTrips(lhs, rhs, order.field, compare_strings);
+        if (comparison != 0)
+        {
+            return order.descending ? (comparison > 0) : (comparison < 0);
+        }
+    }
+    return false;
+}
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_FLIGHT_TRIP_QUERY_H_
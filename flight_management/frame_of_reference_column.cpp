@@ -0,0 +1,46 @@
+///
+/// @file frame_of_reference_column.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/frame_of_reference_column.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace fms
+{
+FrameOfReferenceColumn::FrameOfReferenceColumn(const std::vector<std::int64_t>& values)
+    : min_{values.empty() ? 0 : *std::min_element(values.begin(), values.end())},
+      max_{values.empty() ? 0 : *std::max_element(values.begin(), values.end())},
+      width_{1U},
+      offsets_{}
+{
+    const auto range = static_cast<std::uint64_t>(max_) - static_cast<std::uint64_t>(min_);
+    while ((width_ < sizeof(std::uint64_t)) && ((range >> (width_ * 8U)) != 0U))
+    {
+        width_ *= 2U;
+    }
+
+    offsets_.reserve(values.size() * width_);
+    for (const auto value : values)
+    {
+        const auto offset = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(min_);
+        for (std::size_t byte = 0U; byte < width_; ++byte)
+        {
+            offsets_.push_back(static_cast<std::uint8_t>(offset >> (byte * 8U)));
+        }
+    }
+}
+
+std::int64_t FrameOfReferenceColumn::Get(const std::size_t row) const
+{
+    std::uint64_t offset = 0U;
+    const auto* encoded = &offsets_[row * width_];
+    for (std::size_t byte = 0U; byte < width_; ++byte)
+    {
+        offset |= static_cast<std::uint64_t>(encoded[byte]) << (byte * 8U);
+    }
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(min_) + offset);
+}
+
+}  // namespace fms
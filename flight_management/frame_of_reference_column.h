@@ -0,0 +1,57 @@
+///
+/// @file frame_of_reference_column.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_FRAME_OF_REFERENCE_COLUMN_H_
+#define FLIGHT_MANAGEMENT_FRAME_OF_REFERENCE_COLUMN_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace fms
+{
+/// @brief Immutable integer column, Frame-of-Reference encoded.
+///
+/// Values are stored as unsigned offsets from the minimum value (reference), each offset using the smallest byte
+/// width (1, 2, 4 or 8) which fits the range of values. Minimum and maximum double as zone map of the column.
+class FrameOfReferenceColumn
+{
+  public:
+    /// @brief Constructor
+    /// @param values[in] - Values to encode
+    explicit FrameOfReferenceColumn(const std::vector<std::int64_t>& values);
+
+    /// @brief Decode value at provided row
+    ///
+    /// @param row[in] - Row index
+    ///
+    /// @return value - Decoded value
+    std::int64_t Get(const std::size_t row) const;
+
+    /// @brief Minimum of all values
+    std::int64_t Min() const { return min_; }
+
+    /// @brief Maximum of all values
+    std::int64_t Max() const { return max_; }
+
+    /// @brief Number of bytes used by encoded offsets
+    std::size_t GetMemoryUsage() const { return offsets_.size(); }
+
+  private:
+    /// @brief Minimum of all values (reference)
+    std::int64_t min_;
+
+    /// @brief Maximum of all values
+    std::int64_t max_;
+
+    /// @brief Width of each offset in bytes
+    std::size_t width_;
+
+    /// @brief Encoded offsets (little endian)
+    std::vector<std::uint8_t> offsets_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_FRAME_OF_REFERENCE_COLUMN_H_
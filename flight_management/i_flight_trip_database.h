@@ -6,6 +6,7 @@
 #define FLIGHT_MANAGEMENT_I_FLIGHT_TRIP_DATABASE_H_
 
 #include "flight_management/flight_trip.h"
+#include "flight_management/flight_trip_query.h"
 
 #include <cstdint>
 #include <string>
@@ -31,6 +32,20 @@ class IFlightTripDatabase
     virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
                          const std::string& destination, const double& fare) = 0;
 
+    /// @brief Add scheduled Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    /// @param departure_time[in] - Departure time
+    /// @param arrival_time[in] - Arrival time (not before departure time)
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare, const Timestamp departure_time,
+                         const Timestamp arrival_time) = 0;
+
     /// @brief Remove Trip from the database
     ///
     /// @param name[in] - Flight Number/name to be deleted from Database
@@ -38,11 +53,26 @@ class IFlightTripDatabase
     ///
     virtual void RemoveTrip(const std::string& name) = 0;
 
+    /// @brief Remove one departure of a Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    /// @param departure_time[in] - Departure time of the trip to be deleted
+    ///                             If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name, const Timestamp departure_time) = 0;
+
     /// @brief Update Flight Fare for the provided Trip
     /// @param name[in] - Flight Number/name to be updated in Database
     ///                   If trip does not exist, function does nothing.
     virtual void UpdateFareByTrip(const std::string& name, const double& fare) = 0;
 
+    /// @brief Update Flight Fare for one departure of the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    /// @param departure_time[in] - Departure time of the trip to be updated
+    ///                             If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByTrip(const std::string& name, const Timestamp departure_time, const double& fare) = 0;
+
     /// @brief Update Flight Fare for the provided Trip
     /// @param operated_by[in] - Flight operator to be updated in Database
     ///                          If trip does not exist, function does nothing.
@@ -66,6 +96,20 @@ class IFlightTripDatabase
     /// @return flight_trips - list of flight trips
     virtual std::vector<FlightTrip> FindFlightsByOriginCity(const std::string& origin_city) const = 0;
 
+    /// @brief Find flight trips whose flight number/name starts with provided prefix, ignoring case (e.g. "6e-")
+    ///
+    /// @param prefix[in] - Flight Number/name prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by flight number/name
+    virtual std::vector<FlightTrip> FindFlightsByNumberPrefix(const std::string& prefix) const = 0;
+
+    /// @brief Find flight trips whose origin city starts with provided prefix, ignoring case (e.g. "beng")
+    ///
+    /// @param prefix[in] - Flight origin city prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by origin city
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityPrefix(const std::string& prefix) const = 0;
+
     /// @brief Find average cost of all the trips
     ///
     /// @return min_fare - average fare cost of flight trips
@@ -80,6 +124,29 @@ class IFlightTripDatabase
     virtual double FindMinFareBetweenCities(const std::string& origin_city,
                                             const std::string& destination_city) const = 0;
 
+    /// @brief Find flight trips from provided origin city departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return flight_trips - list of flight trips, ordered by departure time
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                        const Timestamp from,
+                                                                        const Timestamp to) const = 0;
+
+    /// @brief Find minimum fare cost flight between provided cities departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities within time window
+    virtual double FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                        const std::string& destination_city, const Timestamp from,
+                                                        const Timestamp to) const = 0;
+
     /// @brief Find maximum fare cost flight trip from provided operator
     ///
     /// @param operated_by[in] - Flight operator
@@ -91,6 +158,17 @@ class IFlightTripDatabase
     ///
     /// @return length - total number of trips in database
     virtual std::size_t GetTotalTrips(void) const = 0;
+
+    /// @brief Execute query, streaming matching trips in query order (see FlightTripQuery)
+    ///
+    /// @param query[in] - Query (predicates, projection, ordering, limit)
+    /// @param consumer[in] - Called for each result, returns false to stop the query
+    virtual void Execute(const FlightTripQuery& query, const TripConsumer& consumer) const = 0;
+
+    /// @brief Start building lazy query over flight trips, executed when its results are consumed
+    ///
+    /// @return query - Query matching all trips
+    FlightTripQuery Query() const { return FlightTripQuery{*this}; }
 };
 
 }  // namespace fms
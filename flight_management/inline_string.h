@@ -0,0 +1,65 @@
+///
+/// @file inline_string.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_INLINE_STRING_H_
+#define FLIGHT_MANAGEMENT_INLINE_STRING_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace fms
+{
+/// @brief Fixed capacity, trivially copyable string stored inline (no heap allocation)
+///
+/// @tparam Capacity - Maximum number of characters (at most 255)
+template <std::size_t Capacity>
+struct InlineString
+{
+    static_assert(Capacity <= 255U, "InlineString length must fit in one byte.");
+
+    /// @brief Characters (not null terminated)
+    std::array<char, Capacity> data;
+
+    /// @brief Number of used characters
+    std::uint8_t length;
+
+    /// @brief Check whether provided string fits in inline storage
+    ///
+    /// @param value[in] - String to check
+    ///
+    /// @return fits - true if value has at most Capacity characters
+    static bool Fits(const std::string& value) { return value.size() <= Capacity; }
+
+    /// @brief Create inline string from provided string (truncated to Capacity characters)
+    ///
+    /// @param value[in] - String to copy
+    ///
+    /// @return inline_string - Inline copy of value
+    static InlineString FromString(const std::string& value)
+    {
+        InlineString inline_string{};
+        inline_string.length = static_cast<std::uint8_t>(std::min(value.size(), Capacity));
+        std::memcpy(inline_string.data.data(), value.data(), inline_string.length);
+        return inline_string;
+    }
+
+    /// @brief Convert to std::string
+    std::string ToString() const { return std::string{data.data(), length}; }
+
+    /// @brief Compare with std::string without allocation
+    bool operator==(const std::string& value) const
+    {
+        return (value.size() == length) && (std::memcmp(data.data(), value.data(), length) == 0);
+    }
+
+    /// @brief Compare with std::string without allocation
+    bool operator!=(const std::string& value) const { return !(*this == value); }
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_INLINE_STRING_H_
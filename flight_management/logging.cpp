@@ -15,6 +15,7 @@
 ///            limitations under the License.
 ///
 #include "flight_management/logging.h"
+#include "flight_management/tracing.h"
 
 namespace fms
 {
@@ -33,6 +34,7 @@ LoggingWrapper::~LoggingWrapper()
 {
     if (should_log_)
     {
+        TRACE_SPAN("LoggingWrapper::Write");
         switch (severity_)
         {
 #ifdef NDEBUG
@@ -0,0 +1,123 @@
+///
+/// @file lru_cache.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_LRU_CACHE_H_
+#define FLIGHT_MANAGEMENT_LRU_CACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace fms
+{
+/// @brief Bounded Least-Recently-Used (LRU) cache
+///
+/// @tparam Key - Cache key type
+/// @tparam Value - Cached value type
+/// @tparam Hash - Hash function for the key type
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache
+{
+  public:
+    /// @brief Constructor
+    /// @param capacity[in] - Maximum number of entries held by the cache (0 disables caching)
+    explicit LruCache(const std::size_t capacity) : capacity_{capacity}, evictions_{0U} {}
+
+    /// @brief Find cached value and mark it as most recently used
+    ///
+    /// @param key[in] - Key to search
+    ///
+    /// @return value - pointer to cached value, nullptr if key is not cached
+    const Value* Find(const Key& key)
+    {
+        const auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            return nullptr;
+        }
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    /// @brief Insert (or replace) value for the key, evicting least recently used entry if cache is full
+    ///
+    /// @param key[in] - Key to cache
+    /// @param value[in] - Value to cache
+    void Insert(const Key& key, Value value)
+    {
+        if (capacity_ == 0U)
+        {
+            return;
+        }
+
+        const auto it = index_.find(key);
+        if (it != index_.end())
+        {
+            it->second->second = std::move(value);
+            entries_.splice(entries_.begin(), entries_, it->second);
+            return;
+        }
+
+        if (entries_.size() >= capacity_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+            ++evictions_;
+        }
+        entries_.emplace_front(key, std::move(value));
+        index_.emplace(key, entries_.begin());
+    }
+
+    /// @brief Erase cached value for the key
+    ///
+    /// @param key[in] - Key to erase
+    ///
+    /// @return erased - true if key was cached, false otherwise
+    bool Erase(const Key& key)
+    {
+        const auto it = index_.find(key);
+        if (it == index_.end())
+        {
+            return false;
+        }
+        entries_.erase(it->second);
+        index_.erase(it);
+        return true;
+    }
+
+    /// @brief Erase all cached values
+    void Clear()
+    {
+        index_.clear();
+        entries_.clear();
+    }
+
+    /// @brief Get number of cached entries
+    std::size_t Size() const { return entries_.size(); }
+
+    /// @brief Get maximum number of cached entries
+    std::size_t Capacity() const { return capacity_; }
+
+    /// @brief Get number of entries evicted due to capacity so far
+    std::size_t Evictions() const { return evictions_; }
+
+  private:
+    /// @brief Cached entries, ordered from most recently to least recently used
+    std::list<std::pair<Key, Value>> entries_;
+
+    /// @brief Lookup from key to cached entry
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index_;
+
+    /// @brief Maximum number of cached entries
+    std::size_t capacity_;
+
+    /// @brief Number of entries evicted due to capacity
+    std::size_t evictions_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_LRU_CACHE_H_
@@ -0,0 +1,220 @@
+///
+/// @file remote_flight_trip_database.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/remote_flight_trip_database.h"
+#include "flight_management/logging.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace fms
+{
+namespace
+{
+/// @brief Arguments of operations which take only some of the trip fields
+FlightTrip MakeArguments(const std::string& name, const std::string& operated_by, const std::string& origin_city,
+                         const std::string& destination_city, const double fare = 0.0)
+{
+    return FlightTrip{name, operated_by, origin_city, destination_city, fare};
+}
+
+/// @brief Number of results fetched by the first page of a remote query
+constexpr std::size_t kFirstPageSize{256U};
+
+/// @brief Maximum number of results fetched by a page of a remote query, bounds the size of a single response
+constexpr std::size_t kMaxPageSize{16384U};
+
+/// @brief Ordering keys of query followed by all other fields as tie breakers, such that every page is cut from the
+///        same total order. Unordered queries are visited in the (deterministic) order of their access path.
+std::vector<TripOrder> MakeTotalOrder(const std::vector<TripOrder>& order)
+{
+    if (order.empty())
+    {
+        return order;
+    }
+    auto total_order = order;
+    for (const auto field : {TripField::kName, TripField::kOperatedBy, TripField::kOriginCity,
+                             TripField::kDestinationCity, TripField::kFare, TripField::kDepartureTime,
+                             TripField::kArrivalTime})
+    {
+        if (std::none_of(order.begin(), order.end(), [field](const auto& key) { return key.field == field; }))
+        {
+            total_order.push_back(TripOrder{field, false});
+        }
+    }
+    return total_order;
+}
+}  // namespace
+
+RemoteFlightTripDatabase::RemoteFlightTripDatabase(const std::string& endpoint) : client_{endpoint} {}
+
+void RemoteFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                       const std::string& origin, const std::string& destination, const double& fare)
+{
+    AddTrip(name, operated_by, origin, destination, fare, 0, 0);
+}
+
+void RemoteFlightTripDatabase::AddTrip(const std::string& name, const std::string& operated_by,
+                                       const std::string& origin, const std::string& destination, const double& fare,
+                                       const Timestamp departure_time, const Timestamp arrival_time)
+{
+    Call(RpcOpcode::kAddTrip,
+         FlightTrip{name, operated_by, origin, destination, fare, departure_time, arrival_time});
+}
+
+void RemoteFlightTripDatabase::RemoveTrip(const std::string& name)
+{
+    Call(RpcOpcode::kRemoveTrip, MakeArguments(name, {}, {}, {}));
+}
+
+void RemoteFlightTripDatabase::RemoveTrip(const std::string& name, const Timestamp departure_time)
+{
+    Call(RpcOpcode::kRemoveTripByDeparture, FlightTrip{name, {}, {}, {}, 0.0, departure_time, departure_time});
+}
+
+void RemoteFlightTripDatabase::UpdateFareByTrip(const std::string& name, const double& fare)
+{
+    Call(RpcOpcode::kUpdateFareByTrip, MakeArguments(name, {}, {}, {}, fare));
+}
+
+void RemoteFlightTripDatabase::UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                                const double& fare)
+{
+    Call(RpcOpcode::kUpdateFareByDeparture, FlightTrip{name, {}, {}, {}, fare, departure_time, departure_time});
+}
+
+void RemoteFlightTripDatabase::UpdateFareByOperator(const std::string& operated_by, const double& fare)
+{
+    Call(RpcOpcode::kUpdateFareByOperator, MakeArguments({}, operated_by, {}, {}, fare));
+}
+
+void RemoteFlightTripDatabase::DisplayAllTrips() const
+{
+    LOG(INFO) << "Current available trips: " << std::endl << FindFlightsByNumberPrefix("");
+}
+
+std::vector<FlightTrip> RemoteFlightTripDatabase::FindFlightByNumber(const std::string& name) const
+{
+    return Call(RpcOpcode::kFindFlightByNumber, MakeArguments(name, {}, {}, {})).trips;
+}
+
+std::vector<FlightTrip> RemoteFlightTripDatabase::FindFlightsByOriginCity(const std::string& origin_city) const
+{
+    return Call(RpcOpcode::kFindFlightsByOriginCity, MakeArguments({}, {}, origin_city, {})).trips;
+}
+
+std::vector<FlightTrip> RemoteFlightTripDatabase::FindFlightsByNumberPrefix(const std::string& prefix) const
+{
+    return Call(RpcOpcode::kFindFlightsByNumberPrefix, MakeArguments(prefix, {}, {}, {})).trips;
+}
+
+std::vector<FlightTrip> RemoteFlightTripDatabase::FindFlightsByOriginCityPrefix(const std::string& prefix) const
+{
+    return Call(RpcOpcode::kFindFlightsByOriginCityPrefix, MakeArguments({}, {}, prefix, {})).trips;
+}
+
+double RemoteFlightTripDatabase::FindAverageCostOfAllTrips() const
+{
+    return Call(RpcOpcode::kFindAverageCostOfAllTrips, MakeArguments({}, {}, {}, {})).fare;
+}
+
+double RemoteFlightTripDatabase::FindMinFareBetweenCities(const std::string& origin_city,
+                                                          const std::string& destination_city) const
+{
+    return Call(RpcOpcode::kFindMinFareBetweenCities, MakeArguments({}, {}, origin_city, destination_city)).fare;
+}
+
+std::vector<FlightTrip> RemoteFlightTripDatabase::FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                                      const Timestamp from,
+                                                                                      const Timestamp to) const
+{
+    return Call(RpcOpcode::kFindFlightsByOriginCityInTimeWindow, MakeArguments({}, {}, origin_city, {}), from, to)
+        .trips;
+}
+
+double RemoteFlightTripDatabase::FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                                      const std::string& destination_city,
+                                                                      const Timestamp from, const Timestamp to) const
+{
+    return Call(RpcOpcode::kFindMinFareBetweenCitiesInTimeWindow,
+                MakeArguments({}, {}, origin_city, destination_city), from, to)
+        .fare;
+}
+
+double RemoteFlightTripDatabase::FindMaxFareByOperator(const std::string& operated_by) const
+{
+    return Call(RpcOpcode::kFindMaxFareByOperator, MakeArguments({}, operated_by, {}, {})).fare;
+}
+
+std::size_t RemoteFlightTripDatabase::GetTotalTrips(void) const
+{
+    return static_cast<std::size_t>(Call(RpcOpcode::kGetTotalTrips, MakeArguments({}, {}, {}, {})).total_trips);
+}
+
+void RemoteFlightTripDatabase::Execute(const FlightTripQuery& query, const TripConsumer& consumer) const
+{
+    const auto& filter = query.GetFilter();
+    const auto limit = query.GetLimit();
+    if (limit == 0U)
+    {
+        return;
+    }
+
+    // Results are fetched in pages of growing size, so that small or early stopped queries transfer few trips and
+    // large ones few pages. Custom predicates are evaluated here, hence without them the page is also bounded by the
+    // remaining limit, with them the number of matching trips of a page is unknown.
+    const auto order = MakeTotalOrder(query.GetOrder());
+    std::size_t page_size{kFirstPageSize};
+    std::size_t count{0U};
+    std::uint64_t offset{0U};
+    while (true)
+    {
+        const auto page_limit = filter.predicates.empty() ? std::min(page_size, limit - count) : page_size;
+        const auto trips = Call(RpcRequest{0U, RpcOpcode::kExecuteQuery, MakeArguments({}, {}, {}, {}), 0, 0,
+                                           RpcQuery{filter, order, offset, page_limit}})
+                               .trips;
+        for (const auto& trip : trips)
+        {
+            if (!filter.Matches(trip))
+            {
+                continue;
+            }
+            ++count;
+            if (!consumer(query.Project(trip)) || (count >= limit))
+            {
+                return;
+            }
+        }
+        if (trips.size() < page_limit)
+        {
+            return;
+        }
+        offset += trips.size();
+        page_size = std::min(2U * page_size, kMaxPageSize);
+    }
+}
+
+bool RemoteFlightTripDatabase::IsConnected() const { return client_.IsConnected(); }
+
+RpcResponse RemoteFlightTripDatabase::Call(const RpcOpcode opcode, const FlightTrip& trip, const Timestamp from,
+                                           const Timestamp to) const
+{
+    return Call(RpcRequest{0U, opcode, trip, from, to, RpcQuery{{}, {}, 0U, 0U}});
+}
+
+RpcResponse RemoteFlightTripDatabase::Call(const RpcRequest& request) const
+{
+    RpcResponse response{};
+    if (!client_.Call(request, response))
+    {
+        throw RemoteCallFailed{"Remote call failed, server is not connected"};
+    }
+    if (response.status == RpcStatus::kResultTooLarge)
+    {
+        throw RemoteCallFailed{"Remote result exceeds maximum frame size"};
+    }
+    return response;
+}
+
+}  // namespace fms
@@ -0,0 +1,222 @@
+///
+/// @file remote_flight_trip_database.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_REMOTE_FLIGHT_TRIP_DATABASE_H_
+#define FLIGHT_MANAGEMENT_REMOTE_FLIGHT_TRIP_DATABASE_H_
+
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/rpc_client.h"
+#include "flight_management/rpc_protocol.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+/// @brief Error thrown by RemoteFlightTripDatabase operations whose call failed (i.e. no connection to the server) or
+///        whose result exceeds the maximum frame size
+class RemoteCallFailed : public std::runtime_error
+{
+  public:
+    /// @brief Constructor
+    ///
+    /// @param what[in] - Reason of the failure
+    explicit RemoteCallFailed(const std::string& what) : std::runtime_error{what} {}
+};
+
+/// @brief Flight Trip Database served by a remote RpcServer.
+///
+/// Each operation is a blocking call over a single connection. Operations throw RemoteCallFailed instead of returning
+/// a result if the call fails, so that neither lost mutations nor missing results go unnoticed. If the connection
+/// fails after a mutation has been sent, the server may or may not have applied it.
+class RemoteFlightTripDatabase : public IFlightTripDatabase
+{
+  public:
+    /// @brief Constructor, connects to server
+    ///
+    /// @param endpoint[in] - Server endpoint, "unix:<path>" or "tcp:<port>"
+    explicit RemoteFlightTripDatabase(const std::string& endpoint);
+
+    /// @brief Destructor
+    virtual ~RemoteFlightTripDatabase() = default;
+
+    /// @brief Add Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare) override;
+
+    /// @brief Add scheduled Flight Trip to the Database
+    ///
+    /// @param name[in] - Flight number/name
+    /// @param operated_by[in] - Flight Operator
+    /// @param origin[in] - Flight Origin City
+    /// @param destination[in] - Flight Destination City
+    /// @param fare[in] - Flight Airfare
+    /// @param departure_time[in] - Departure time
+    /// @param arrival_time[in] - Arrival time (not before departure time)
+    ///
+    virtual void AddTrip(const std::string& name, const std::string& operated_by, const std::string& origin,
+                         const std::string& destination, const double& fare, const Timestamp departure_time,
+                         const Timestamp arrival_time) override;
+
+    /// @brief Remove Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    ///                   If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name) override;
+
+    /// @brief Remove one departure of a Trip from the database
+    ///
+    /// @param name[in] - Flight Number/name to be deleted from Database
+    /// @param departure_time[in] - Departure time of the trip to be deleted
+    ///                             If trip does not exist, function does nothing.
+    ///
+    virtual void RemoveTrip(const std::string& name, const Timestamp departure_time) override;
+
+    /// @brief Update Flight Fare for the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    ///                   If trip does not exist, function does nothing.
+    virtual void UpdateFareByTrip(const std::string& name, const double& fare) override;
+
+    /// @brief Update Flight Fare for one departure of the provided Trip
+    /// @param name[in] - Flight Number/name to be updated in Database
+    /// @param departure_time[in] - Departure time of the trip to be updated
+    ///                             If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByTrip(const std::string& name, const Timestamp departure_time,
+                                  const double& fare) override;
+
+    /// @brief Update Flight Fare for the provided Trip
+    /// @param operated_by[in] - Flight operator to be updated in Database
+    ///                          If trip does not exist, function does nothing.
+    /// @param fare[in] - Flight fare
+    virtual void UpdateFareByOperator(const std::string& operated_by, const double& fare) override;
+
+    /// @brief Display all trips in database (fetched from server, logged locally)
+    virtual void DisplayAllTrips() const override;
+
+    /// @brief Find flight trips by flight number/name
+    ///
+    /// @param name[in] - Flight Number/name to search
+    ///
+    /// @return flight_trips - list of flight trips
+    virtual std::vector<FlightTrip> FindFlightByNumber(const std::string& name) const override;
+
+    /// @brief Find flight trips by flight origin city
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    ///
+    /// @return flight_trips - list of flight trips
+    virtual std::vector<FlightTrip> FindFlightsByOriginCity(const std::string& origin_city) const override;
+
+    /// @brief Find flight trips whose flight number/name starts with provided prefix, ignoring case (e.g. "6e-")
+    ///
+    /// @param prefix[in] - Flight Number/name prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by flight number/name
+    virtual std::vector<FlightTrip> FindFlightsByNumberPrefix(const std::string& prefix) const override;
+
+    /// @brief Find flight trips whose origin city starts with provided prefix, ignoring case (e.g. "beng")
+    ///
+    /// @param prefix[in] - Flight origin city prefix to search
+    ///
+    /// @return flight_trips - list of flight trips, ordered by origin city
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityPrefix(const std::string& prefix) const override;
+
+    /// @brief Find average cost of all the trips
+    ///
+    /// @return min_fare - average fare cost of flight trips
+    virtual double FindAverageCostOfAllTrips() const override;
+
+    /// @brief Find minimum fare cost flight between provided cities
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities
+    virtual double FindMinFareBetweenCities(const std::string& origin_city,
+                                            const std::string& destination_city) const override;
+
+    /// @brief Find flight trips from provided origin city departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city to search
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return flight_trips - list of flight trips, ordered by departure time
+    virtual std::vector<FlightTrip> FindFlightsByOriginCityInTimeWindow(const std::string& origin_city,
+                                                                        const Timestamp from,
+                                                                        const Timestamp to) const override;
+
+    /// @brief Find minimum fare cost flight between provided cities departing within time window [from, to)
+    ///
+    /// @param origin_city[in] - Flight origin city
+    /// @param destination_city[in] - Flight destination city
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return min_fare - minimum fare cost of flight trips between provided cities within time window
+    virtual double FindMinFareBetweenCitiesInTimeWindow(const std::string& origin_city,
+                                                        const std::string& destination_city, const Timestamp from,
+                                                        const Timestamp to) const override;
+
+    /// @brief Find maximum fare cost flight trip from provided operator
+    ///
+    /// @param operated_by[in] - Flight operator
+    ///
+    /// @return max_fare - maximum fare cost of flight trips from provided operator
+    virtual double FindMaxFareByOperator(const std::string& operated_by) const override;
+
+    /// @brief Get Total number of trips in database
+    ///
+    /// @return length - total number of trips in database
+    virtual std::size_t GetTotalTrips(void) const override;
+
+    /// @brief Execute query, streaming matching trips in query order. The server executes field predicates, ordering
+    ///        and limit (see RpcQuery); custom predicates and projection are applied on client side. Results are
+    ///        fetched in bounded pages of growing size, each page being a separate call, hence trips added or removed
+    ///        concurrently may shift results between pages. Throws RemoteCallFailed if a call fails or a page exceeds
+    ///        the maximum frame size.
+    ///
+    /// @param query[in] - Query (predicates, projection, ordering, limit)
+    /// @param consumer[in] - Called for each result, returns false to stop the query
+    virtual void Execute(const FlightTripQuery& query, const TripConsumer& consumer) const override;
+
+    /// @brief Check whether database is connected to server
+    bool IsConnected() const;
+
+  private:
+    /// @brief Call operation on server
+    ///
+    /// @param opcode[in] - Operation
+    /// @param trip[in] - Operation arguments (see RpcRequest)
+    /// @param from[in] - Earliest departure time of time window queries
+    /// @param to[in] - Latest departure time of time window queries
+    ///
+    /// @return response - server response (throws RemoteCallFailed if call failed)
+    RpcResponse Call(const RpcOpcode opcode, const FlightTrip& trip, const Timestamp from = 0,
+                     const Timestamp to = 0) const;
+
+    /// @brief Call operation on server
+    ///
+    /// @param request[in] - Request (id is assigned by the client)
+    ///
+    /// @return response - server response (throws RemoteCallFailed if call failed or result is too large)
+    RpcResponse Call(const RpcRequest& request) const;
+
+    /// @brief Connection to server
+    mutable RpcClient client_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_REMOTE_FLIGHT_TRIP_DATABASE_H_
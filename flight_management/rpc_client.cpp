@@ -0,0 +1,102 @@
+///
+/// @file rpc_client.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/rpc_client.h"
+#include "flight_management/logging.h"
+#include "flight_management/rpc_socket.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+namespace fms
+{
+RpcClient::RpcClient(const std::string& endpoint)
+    : fd_{ConnectTo(endpoint)}, next_id_{0U}, requests_{}, responses_{}, responses_offset_{0U}
+{
+}
+
+RpcClient::~RpcClient() { Disconnect(); }
+
+bool RpcClient::IsConnected() const { return fd_ >= 0; }
+
+std::uint32_t RpcClient::Send(RpcRequest request)
+{
+    request.id = next_id_++;
+    EncodeRequest(request, requests_);
+    return request.id;
+}
+
+bool RpcClient::Flush()
+{
+    std::size_t sent_bytes{0U};
+    while (IsConnected() && (sent_bytes < requests_.size()))
+    {
+        const auto sent = ::send(fd_, requests_.data() + sent_bytes, requests_.size() - sent_bytes, MSG_NOSIGNAL);
+        if (sent > 0)
+        {
+            sent_bytes += static_cast<std::size_t>(sent);
+        }
+        else if (errno != EINTR)
+        {
+            LOG(ERROR) << "Failed to send requests: " << std::strerror(errno);
+            Disconnect();
+        }
+    }
+    requests_.clear();
+    return IsConnected();
+}
+
+bool RpcClient::Receive(RpcResponse& response)
+{
+    std::array<char, 65536U> buffer{};
+    while (IsConnected())
+    {
+        const auto status = DecodeResponse(responses_, responses_offset_, response);
+        if (status == RpcDecodeStatus::kDecoded)
+        {
+            return true;
+        }
+        if (status == RpcDecodeStatus::kMalformed)
+        {
+            LOG(ERROR) << "Received malformed response";
+            Disconnect();
+            break;
+        }
+
+        responses_.erase(0U, responses_offset_);
+        responses_offset_ = 0U;
+        const auto received = ::recv(fd_, buffer.data(), buffer.size(), 0);
+        if (received > 0)
+        {
+            responses_.append(buffer.data(), static_cast<std::size_t>(received));
+        }
+        else if ((received == 0) || (errno != EINTR))
+        {
+            LOG(ERROR) << "Connection closed by server";
+            Disconnect();
+        }
+    }
+    return false;
+}
+
+bool RpcClient::Call(const RpcRequest& request, RpcResponse& response)
+{
+    const auto id = Send(request);
+    return Flush() && Receive(response) && (response.id == id);
+}
+
+void RpcClient::Disconnect()
+{
+    if (fd_ >= 0)
+    {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+}  // namespace fms
@@ -0,0 +1,85 @@
+///
+/// @file rpc_client.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_RPC_CLIENT_H_
+#define FLIGHT_MANAGEMENT_RPC_CLIENT_H_
+
+#include "flight_management/rpc_protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fms
+{
+/// @brief Blocking client of RpcServer, single connection.
+///
+/// Requests can be pipelined: Send queues any number of requests, Flush writes them at once and Receive returns
+/// responses in request order. Connection failures are logged, after which the client stays disconnected.
+class RpcClient
+{
+  public:
+    /// @brief Constructor, connects to server
+    /// @param endpoint[in] - Server endpoint, "unix:<path>" or "tcp:<port>"
+    explicit RpcClient(const std::string& endpoint);
+
+    /// @brief Destructor, closes connection
+    ~RpcClient();
+
+    RpcClient(const RpcClient&) = delete;
+    RpcClient& operator=(const RpcClient&) = delete;
+
+    /// @brief Check whether client is connected
+    bool IsConnected() const;
+
+    /// @brief Queue request to be sent by next Flush
+    ///
+    /// @param request[in] - Request (id is assigned by the client)
+    ///
+    /// @return id - id assigned to the request
+    std::uint32_t Send(RpcRequest request);
+
+    /// @brief Send all queued requests
+    ///
+    /// @return sent - false if disconnected
+    bool Flush();
+
+    /// @brief Wait for next response
+    ///
+    /// @param response[out] - Received response
+    ///
+    /// @return received - false if disconnected
+    bool Receive(RpcResponse& response);
+
+    /// @brief Send request and wait for its response (requires no other requests in flight)
+    ///
+    /// @param request[in] - Request
+    /// @param response[out] - Received response
+    ///
+    /// @return succeeded - false if disconnected
+    bool Call(const RpcRequest& request, RpcResponse& response);
+
+  private:
+    /// @brief Close connection
+    void Disconnect();
+
+    /// @brief Connected socket, -1 if disconnected
+    int fd_;
+
+    /// @brief Id of next request
+    std::uint32_t next_id_;
+
+    /// @brief Encoded requests to be sent
+    std::string requests_;
+
+    /// @brief Received bytes
+    std::string responses_;
+
+    /// @brief Start of first response in responses_ which is not returned yet
+    std::size_t responses_offset_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_RPC_CLIENT_H_
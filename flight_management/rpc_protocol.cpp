@@ -0,0 +1,526 @@
+///
+/// @file rpc_protocol.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/rpc_protocol.h"
+#include "flight_management/logging.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace fms
+{
+namespace
+{
+/// @brief Size of frame header (payload length)
+constexpr std::size_t kFrameHeaderSize{sizeof(std::uint32_t)};
+
+/// @brief Arguments transmitted with a request (bit set)
+enum Argument : std::uint8_t
+{
+    kName = 1U << 0U,
+    kOperatedBy = 1U << 1U,
+    kOrigin = 1U << 2U,
+    kDestination = 1U << 3U,
+    kFare = 1U << 4U,
+    kSchedule = 1U << 5U,
+    kTimeWindow = 1U << 6U,
+    kQuery = 1U << 7U
+};
+
+/// @brief Equality predicates of a transmitted query (bit set)
+enum QueryPredicate : std::uint8_t
+{
+    kMatchesNothing = 1U << 0U,
+    kHasName = 1U << 1U,
+    kHasOperatedBy = 1U << 2U,
+    kHasOriginCity = 1U << 3U,
+    kHasDestinationCity = 1U << 4U
+};
+
+/// @brief Result transmitted with a response
+enum class ResultType : std::uint8_t
+{
+    kNone = 0U,
+    kTrips = 1U,
+    kFare = 2U,
+    kTotalTrips = 3U
+};
+
+/// @brief Check whether opcode is known
+bool IsValid(const RpcOpcode opcode) { return opcode <= RpcOpcode::kExecuteQuery; }
+
+/// @brief Check whether status is known
+bool IsValid(const RpcStatus status) { return status <= RpcStatus::kResultTooLarge; }
+
+/// @brief Get arguments transmitted with request of operation
+std::uint8_t GetArguments(const RpcOpcode opcode)
+{
+    switch (opcode)
+    {
+        case RpcOpcode::kAddTrip:
+            return kName | kOperatedBy | kOrigin | kDestination | kFare | kSchedule;
+        case RpcOpcode::kRemoveTrip:
+        case RpcOpcode::kFindFlightByNumber:
+        case RpcOpcode::kFindFlightsByNumberPrefix:
+            return kName;
+        case RpcOpcode::kUpdateFareByTrip:
+            return kName | kFare;
+        case RpcOpcode::kUpdateFareByOperator:
+            return kOperatedBy | kFare;
+        case RpcOpcode::kRemoveTripByDeparture:
+            return kName | kSchedule;
+        case RpcOpcode::kUpdateFareByDeparture:
+            return kName | kFare | kSchedule;
+        case RpcOpcode::kFindMaxFareByOperator:
+            return kOperatedBy;
+        case RpcOpcode::kFindFlightsByOriginCity:
+        case RpcOpcode::kFindFlightsByOriginCityPrefix:
+            return kOrigin;
+        case RpcOpcode::kFindMinFareBetweenCities:
+            return kOrigin | kDestination;
+        case RpcOpcode::kFindFlightsByOriginCityInTimeWindow:
+            return kOrigin | kTimeWindow;
+        case RpcOpcode::kFindMinFareBetweenCitiesInTimeWindow:
+            return kOrigin | kDestination | kTimeWindow;
+        case RpcOpcode::kExecuteQuery:
+            return kQuery;
+        case RpcOpcode::kFindAverageCostOfAllTrips:
+        case RpcOpcode::kGetTotalTrips:
+        default:
+            return 0U;
+    }
+}
+
+/// @brief Get result transmitted with response of operation
+ResultType GetResultType(const RpcOpcode opcode)
+{
+    switch (opcode)
+    {
+        case RpcOpcode::kFindFlightByNumber:
+        case RpcOpcode::kFindFlightsByOriginCity:
+        case RpcOpcode::kFindFlightsByNumberPrefix:
+        case RpcOpcode::kFindFlightsByOriginCityPrefix:
+        case RpcOpcode::kFindFlightsByOriginCityInTimeWindow:
+        case RpcOpcode::kExecuteQuery:
+            return ResultType::kTrips;
+        case RpcOpcode::kFindAverageCostOfAllTrips:
+        case RpcOpcode::kFindMinFareBetweenCities:
+        case RpcOpcode::kFindMinFareBetweenCitiesInTimeWindow:
+        case RpcOpcode::kFindMaxFareByOperator:
+            return ResultType::kFare;
+        case RpcOpcode::kGetTotalTrips:
+            return ResultType::kTotalTrips;
+        default:
+            return ResultType::kNone;
+    }
+}
+
+/// @brief Appends little endian encoded values to buffer
+class WireWriter
+{
+  public:
+    explicit WireWriter(std::string& buffer) : buffer_{buffer} {}
+
+    /// @brief Write integer (little endian)
+    template <typename Integer>
+    void Write(const Integer value)
+    {
+        auto bits = static_cast<std::make_unsigned_t<Integer>>(value);
+        for (std::size_t idx = 0U; idx < sizeof(Integer); ++idx)
+        {
+            buffer_.push_back(static_cast<char>(bits & 0xFFU));
+            bits = static_cast<decltype(bits)>(bits >> 8U);
+        }
+    }
+
+    /// @brief Write double (IEEE 754 bits)
+    void Write(const double value)
+    {
+        std::uint64_t bits{};
+        std::memcpy(&bits, &value, sizeof(bits));
+        Write(bits);
+    }
+
+    /// @brief Write string (length prefixed)
+    void Write(const std::string& value)
+    {
+        Write(static_cast<std::uint32_t>(value.size()));
+        buffer_.append(value);
+    }
+
+    /// @brief Write all fields of trip
+    void Write(const FlightTrip& trip)
+    {
+        Write(trip.name);
+        Write(trip.operated_by);
+        Write(trip.origin_city);
+        Write(trip.destination_city);
+        Write(trip.fare);
+        Write(trip.departure_time);
+        Write(trip.arrival_time);
+    }
+
+    /// @brief Write field predicates, ordering keys, offset and limit of query
+    void Write(const RpcQuery& query)
+    {
+        const auto& filter = query.filter;
+        Write(static_cast<std::uint8_t>((filter.matches_nothing ? kMatchesNothing : 0U) |
+                                        (filter.has_name ? kHasName : 0U) |
+                                        (filter.has_operated_by ? kHasOperatedBy : 0U) |
+                                        (filter.has_origin_city ? kHasOriginCity : 0U) |
+                                        (filter.has_destination_city ? kHasDestinationCity : 0U)));
+        Write(filter.name);
+        Write(filter.name_prefix);
+        Write(filter.operated_by);
+        Write(filter.origin_city);
+        Write(filter.destination_city);
+        Write(filter.min_fare);
+        Write(filter.max_fare);
+        Write(filter.departure_from);
+        Write(filter.departure_to);
+        Write(static_cast<std::uint32_t>(query.order.size()));
+        for (const auto& order : query.order)
+        {
+            Write(static_cast<std::uint8_t>(order.field));
+            Write(static_cast<std::uint8_t>(order.descending ? 1U : 0U));
+        }
+        Write(query.offset);
+        Write(query.limit);
+    }
+
+  private:
+    std::string& buffer_;
+};
+
+/// @brief Reads little endian encoded values from a frame, any read past the frame fails
+class WireReader
+{
+  public:
+    WireReader(const std::string& buffer, const std::size_t begin, const std::size_t end)
+        : buffer_{buffer}, position_{begin}, end_{end}
+    {
+    }
+
+    /// @brief Read integer (little endian)
+    template <typename Integer>
+    bool Read(Integer& value)
+    {
+        if ((end_ - position_) < sizeof(Integer))
+        {
+            return false;
+        }
+        std::make_unsigned_t<Integer> bits{0U};
+        for (std::size_t idx = sizeof(Integer); idx > 0U; --idx)
+        {
+            bits = static_cast<decltype(bits)>((bits << 8U) | static_cast<std::uint8_t>(buffer_[position_ + idx - 1U]));
+        }
+        position_ += sizeof(Integer);
+        value = static_cast<Integer>(bits);
+        return true;
+    }
+
+    /// @brief Read double (IEEE 754 bits)
+    bool Read(double& value)
+    {
+        std::uint64_t bits{0U};
+        if (!Read(bits))
+        {
+            return false;
+        }
+        std::memcpy(&value, &bits, sizeof(value));
+        return true;
+    }
+
+    /// @brief Read string (length prefixed)
+    bool Read(std::string& value)
+    {
+        std::uint32_t size{0U};
+        if (!Read(size) || ((end_ - position_) < size))
+        {
+            return false;
+        }
+        value.assign(buffer_, position_, size);
+        position_ += size;
+        return true;
+    }
+
+    /// @brief Read all fields of trip
+    bool Read(FlightTrip& trip)
+    {
+        return Read(trip.name) && Read(trip.operated_by) && Read(trip.origin_city) && Read(trip.destination_city) &&
+               Read(trip.fare) && Read(trip.departure_time) && Read(trip.arrival_time);
+    }
+
+    /// @brief Read field predicates, ordering keys, offset and limit of query, fails for unknown fields
+    bool Read(RpcQuery& query)
+    {
+        auto& filter = query.filter;
+        std::uint8_t predicates{0U};
+        std::uint32_t number_of_keys{0U};
+        if (!Read(predicates) || !Read(filter.name) || !Read(filter.name_prefix) || !Read(filter.operated_by) ||
+            !Read(filter.origin_city) || !Read(filter.destination_city) || !Read(filter.min_fare) ||
+            !Read(filter.max_fare) || !Read(filter.departure_from) || !Read(filter.departure_to) ||
+            !Read(number_of_keys))
+        {
+            return false;
+        }
+        filter.matches_nothing = (predicates & kMatchesNothing) != 0U;
+        filter.has_name = (predicates & kHasName) != 0U;
+        filter.has_operated_by = (predicates & kHasOperatedBy) != 0U;
+        filter.has_origin_city = (predicates & kHasOriginCity) != 0U;
+        filter.has_destination_city = (predicates & kHasDestinationCity) != 0U;
+
+        // Each ordering key takes two bytes, which bounds the number of keys by the frame size
+        query.order.clear();
+        for (std::uint32_t idx = 0U; idx < number_of_keys; ++idx)
+        {
+            std::uint8_t field{0U};
+            std::uint8_t descending{0U};
+            if (!Read(field) || !Read(descending) || (field > static_cast<std::uint8_t>(TripField::kArrivalTime)))
+            {
+                return false;
+            }
+            query.order.push_back(TripOrder{static_cast<TripField>(field), descending != 0U});
+        }
+        return Read(query.offset) && Read(query.limit);
+    }
+
+    /// @brief Read opcode, fails for unknown opcodes
+    bool Read(RpcOpcode& opcode)
+    {
+        std::uint8_t value{0U};
+        if (!Read(value))
+        {
+            return false;
+        }
+        opcode = static_cast<RpcOpcode>(value);
+        return IsValid(opcode);
+    }
+
+    /// @brief Read status, fails for unknown statuses
+    bool Read(RpcStatus& status)
+    {
+        std::uint8_t value{0U};
+        if (!Read(value))
+        {
+            return false;
+        }
+        status = static_cast<RpcStatus>(value);
+        return IsValid(status);
+    }
+
+    /// @brief Check whether whole frame is read
+    bool AtEnd() const { return position_ == end_; }
+
+  private:
+    const std::string& buffer_;
+    std::size_t position_;
+    const std::size_t end_;
+};
+
+/// @brief Append frame to buffer, payload is written by provided function
+template <typename WritePayload>
+void EncodeFrame(std::string& buffer, WritePayload write_payload)
+{
+    const auto header = buffer.size();
+    buffer.append(kFrameHeaderSize, '\0');
+    write_payload(WireWriter{buffer});
+
+    std::string size{};
+    WireWriter{size}.Write(static_cast<std::uint32_t>(buffer.size() - header - kFrameHeaderSize));
+    buffer.replace(header, kFrameHeaderSize, size);
+}
+
+/// @brief Locate payload of frame starting at offset
+RpcDecodeStatus FindFramePayload(const std::string& buffer, const std::size_t offset, std::size_t& begin,
+                                 std::size_t& end)
+{
+    std::uint32_t size{0U};
+    if (!WireReader{buffer, offset, buffer.size()}.Read(size))
+    {
+        return RpcDecodeStatus::kIncomplete;
+    }
+    if (size > kMaxRpcFrameSize)
+    {
+        return RpcDecodeStatus::kMalformed;
+    }
+    begin = offset + kFrameHeaderSize;
+    end = begin + size;
+    return (end > buffer.size()) ? RpcDecodeStatus::kIncomplete : RpcDecodeStatus::kDecoded;
+}
+}  // namespace
+
+bool IsMutation(const RpcOpcode opcode)
+{
+    return (opcode == RpcOpcode::kAddTrip) || (opcode == RpcOpcode::kRemoveTrip) ||
+           (opcode == RpcOpcode::kUpdateFareByTrip) || (opcode == RpcOpcode::kUpdateFareByOperator) ||
+           (opcode == RpcOpcode::kRemoveTripByDeparture) || (opcode == RpcOpcode::kUpdateFareByDeparture);
+}
+
+void EncodeRequest(const RpcRequest& request, std::string& buffer)
+{
+    EncodeFrame(buffer, [&request](WireWriter writer) {
+        const auto arguments = GetArguments(request.opcode);
+        writer.Write(request.id);
+        writer.Write(static_cast<std::uint8_t>(request.opcode));
+        if ((arguments & kName) != 0U)
+        {
+            writer.Write(request.trip.name);
+        }
+        if ((arguments & kOperatedBy) != 0U)
+        {
+            writer.Write(request.trip.operated_by);
+        }
+        if ((arguments & kOrigin) != 0U)
+        {
+            writer.Write(request.trip.origin_city);
+        }
+        if ((arguments & kDestination) != 0U)
+        {
+            writer.Write(request.trip.destination_city);
+        }
+        if ((arguments & kFare) != 0U)
+        {
+            writer.Write(request.trip.fare);
+        }
+        if ((arguments & kSchedule) != 0U)
+        {
+            writer.Write(request.trip.departure_time);
+            writer.Write(request.trip.arrival_time);
+        }
+        if ((arguments & kTimeWindow) != 0U)
+        {
+            writer.Write(request.from);
+            writer.Write(request.to);
+        }
+        if ((arguments & kQuery) != 0U)
+        {
+            writer.Write(request.query);
+        }
+    });
+}
+
+void EncodeResponse(const RpcResponse& response, std::string& buffer)
+{
+    const auto frame = buffer.size();
+    EncodeFrame(buffer, [&response](WireWriter writer) {
+        writer.Write(response.id);
+        writer.Write(static_cast<std::uint8_t>(response.opcode));
+        writer.Write(static_cast<std::uint8_t>(response.status));
+        switch ((response.status == RpcStatus::kOk) ? GetResultType(response.opcode) : ResultType::kNone)
+        {
+            case ResultType::kTrips:
+                writer.Write(static_cast<std::uint32_t>(response.trips.size()));
+                for (const auto& trip : response.trips)
+                {
+                    writer.Write(trip);
+                }
+                break;
+            case ResultType::kFare:
+                writer.Write(response.fare);
+                break;
+            case ResultType::kTotalTrips:
+                writer.Write(response.total_trips);
+                break;
+            case ResultType::kNone:
+            default:
+                break;
+        }
+    });
+
+    // Peers reject oversized frames as malformed, hence report the failure instead
+    if ((buffer.size() - frame - kFrameHeaderSize) > kMaxRpcFrameSize)
+    {
+        LOG(ERROR) << "Result of request {" << response.id << "} exceeds maximum frame size, responding with error";
+        buffer.resize(frame);
+        EncodeResponse(RpcResponse{response.id, response.opcode, RpcStatus::kResultTooLarge, {}, 0.0, 0U}, buffer);
+    }
+}
+
+RpcDecodeStatus DecodeRequest(const std::string& buffer, std::size_t& offset, RpcRequest& request)
+{
+    std::size_t begin{0U};
+    std::size_t end{0U};
+    const auto status = FindFramePayload(buffer, offset, begin, end);
+    if (status != RpcDecodeStatus::kDecoded)
+    {
+        return status;
+    }
+
+    request = RpcRequest{0U, RpcOpcode::kGetTotalTrips, FlightTrip{{}, {}, {}, {}, 0.0}, 0, 0,
+                         RpcQuery{{}, {}, 0U, 0U}};
+    WireReader reader{buffer, begin, end};
+    if (!reader.Read(request.id) || !reader.Read(request.opcode))
+    {
+        return RpcDecodeStatus::kMalformed;
+    }
+    const auto arguments = GetArguments(request.opcode);
+    const auto decoded =
+        (((arguments & kName) == 0U) || reader.Read(request.trip.name)) &&
+        (((arguments & kOperatedBy) == 0U) || reader.Read(request.trip.operated_by)) &&
+        (((arguments & kOrigin) == 0U) || reader.Read(request.trip.origin_city)) &&
+        (((arguments & kDestination) == 0U) || reader.Read(request.trip.destination_city)) &&
+        (((arguments & kFare) == 0U) || reader.Read(request.trip.fare)) &&
+        (((arguments & kSchedule) == 0U) ||
+         (reader.Read(request.trip.departure_time) && reader.Read(request.trip.arrival_time))) &&
+        (((arguments & kTimeWindow) == 0U) || (reader.Read(request.from) && reader.Read(request.to))) &&
+        (((arguments & kQuery) == 0U) || reader.Read(request.query));
+    if (!decoded || !reader.AtEnd())
+    {
+        return RpcDecodeStatus::kMalformed;
+    }
+    offset = end;
+    return RpcDecodeStatus::kDecoded;
+}
+
+RpcDecodeStatus DecodeResponse(const std::string& buffer, std::size_t& offset, RpcResponse& response)
+{
+    std::size_t begin{0U};
+    std::size_t end{0U};
+    const auto status = FindFramePayload(buffer, offset, begin, end);
+    if (status != RpcDecodeStatus::kDecoded)
+    {
+        return status;
+    }
+
+    response = RpcResponse{0U, RpcOpcode::kGetTotalTrips, RpcStatus::kOk, {}, 0.0, 0U};
+    WireReader reader{buffer, begin, end};
+    if (!reader.Read(response.id) || !reader.Read(response.opcode) || !reader.Read(response.status))
+    {
+        return RpcDecodeStatus::kMalformed;
+    }
+
+    auto decoded = true;
+    switch ((response.status == RpcStatus::kOk) ? GetResultType(response.opcode) : ResultType::kNone)
+    {
+        case ResultType::kTrips:
+        {
+            std::uint32_t number_of_trips{0U};
+            decoded = reader.Read(number_of_trips);
+            for (std::uint32_t idx = 0U; decoded && (idx < number_of_trips); ++idx)
+            {
+                response.trips.push_back(FlightTrip{{}, {}, {}, {}, 0.0});
+                decoded = reader.Read(response.trips.back());
+            }
+            break;
+        }
+        case ResultType::kFare:
+            decoded = reader.Read(response.fare);
+            break;
+        case ResultType::kTotalTrips:
+            decoded = reader.Read(response.total_trips);
+            break;
+        case ResultType::kNone:
+        default:
+            break;
+    }
+    if (!decoded || !reader.AtEnd())
+    {
+        return RpcDecodeStatus::kMalformed;
+    }
+    offset = end;
+    return RpcDecodeStatus::kDecoded;
+}
+
+}  // namespace fms
@@ -0,0 +1,163 @@
+///
+/// @file rpc_protocol.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_RPC_PROTOCOL_H_
+#define FLIGHT_MANAGEMENT_RPC_PROTOCOL_H_
+
+#include "flight_management/flight_trip.h"
+#include "flight_management/flight_trip_query.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+/// @brief Maximum size of frame payload, larger frames are rejected as malformed
+constexpr std::size_t kMaxRpcFrameSize{std::size_t{1U} << 24U};
+
+/// @brief Database operation requested over RPC (one per IFlightTripDatabase operation, except DisplayAllTrips)
+enum class RpcOpcode : std::uint8_t
+{
+    kAddTrip = 0U,
+    kRemoveTrip = 1U,
+    kUpdateFareByTrip = 2U,
+    kUpdateFareByOperator = 3U,
+    kFindFlightByNumber = 4U,
+    kFindFlightsByOriginCity = 5U,
+    kFindFlightsByNumberPrefix = 6U,
+    kFindFlightsByOriginCityPrefix = 7U,
+    kFindAverageCostOfAllTrips = 8U,
+    kFindMinFareBetweenCities = 9U,
+    kFindFlightsByOriginCityInTimeWindow = 10U,
+    kFindMinFareBetweenCitiesInTimeWindow = 11U,
+    kFindMaxFareByOperator = 12U,
+    kGetTotalTrips = 13U,
+    kRemoveTripByDeparture = 14U,
+    kUpdateFareByDeparture = 15U,
+    kExecuteQuery = 16U
+};
+
+/// @brief Outcome of a request, reported in its response
+enum class RpcStatus : std::uint8_t
+{
+    kOk = 0U,
+    kResultTooLarge = 1U
+};
+
+/// @brief Result of decoding a frame (malformed frames can not be skipped, i.e. connection is to be closed)
+enum class RpcDecodeStatus : std::uint8_t
+{
+    kDecoded = 0U,
+    kIncomplete = 1U,
+    kMalformed = 2U
+};
+
+/// @brief Query executed over RPC: the serializable part of a FlightTripQuery (field predicates, ordering, limit) and
+///        the page of results to return. Custom predicates and projection can not be transmitted, they are applied on
+///        client side.
+struct RpcQuery
+{
+    /// @brief Field predicates (custom predicates are not transmitted)
+    FlightTripFilter filter;
+
+    /// @brief Ordering keys
+    std::vector<TripOrder> order;
+
+    /// @brief Number of leading results to skip (i.e. results of previous pages)
+    std::uint64_t offset;
+
+    /// @brief Maximum number of results (after skipping offset results)
+    std::uint64_t limit;
+};
+
+/// @brief RPC Request
+///
+/// Operation arguments are carried in the fields of trip (e.g. name for RemoveTrip, name prefix for
+/// FindFlightsByNumberPrefix), in from/to for time window queries and in query for kExecuteQuery. Only the arguments
+/// used by the opcode are transmitted.
+struct RpcRequest
+{
+    /// @brief Request id, echoed in the response (lets clients pipeline requests)
+    std::uint32_t id;
+
+    /// @brief Requested operation
+    RpcOpcode opcode;
+
+    /// @brief Operation arguments
+    FlightTrip trip;
+
+    /// @brief Earliest departure time (inclusive) of time window queries
+    Timestamp from;
+
+    /// @brief Latest departure time (exclusive) of time window queries
+    Timestamp to;
+
+    /// @brief Query of kExecuteQuery
+    RpcQuery query;
+};
+
+/// @brief RPC Response
+///
+/// Only the result used by the opcode is transmitted: trips for Find*Flight* queries and kExecuteQuery, fare for fare
+/// queries and total_trips for GetTotalTrips. Failed requests (status other than kOk) carry no result.
+struct RpcResponse
+{
+    /// @brief Id of answered request
+    std::uint32_t id;
+
+    /// @brief Operation of answered request
+    RpcOpcode opcode;
+
+    /// @brief Outcome of answered request
+    RpcStatus status;
+
+    /// @brief Found flight trips
+    std::vector<FlightTrip> trips;
+
+    /// @brief Found fare
+    double fare;
+
+    /// @brief Total number of trips
+    std::uint64_t total_trips;
+};
+
+/// @brief Check whether operation modifies the database
+bool IsMutation(const RpcOpcode opcode);
+
+/// @brief Append request frame (little endian, length prefixed) to buffer
+///
+/// @param request[in] - Request to encode
+/// @param buffer[in/out] - Encoded frame is appended
+void EncodeRequest(const RpcRequest& request, std::string& buffer);
+
+/// @brief Append response frame (little endian, length prefixed) to buffer. Responses whose frame would exceed
+///        kMaxRpcFrameSize are replaced by a result-less response with status kResultTooLarge.
+///
+/// @param response[in] - Response to encode
+/// @param buffer[in/out] - Encoded frame is appended
+void EncodeResponse(const RpcResponse& response, std::string& buffer);
+
+/// @brief Decode request frame starting at offset
+///
+/// @param buffer[in] - Received bytes
+/// @param offset[in/out] - Start of frame, advanced past the frame if decoded
+/// @param request[out] - Decoded request
+///
+/// @return status - kDecoded, kIncomplete (more bytes are required) or kMalformed
+RpcDecodeStatus DecodeRequest(const std::string& buffer, std::size_t& offset, RpcRequest& request);
+
+/// @brief Decode response frame starting at offset
+///
+/// @param buffer[in] - Received bytes
+/// @param offset[in/out] - Start of frame, advanced past the frame if decoded
+/// @param response[out] - Decoded response
+///
+/// @return status - kDecoded, kIncomplete (more bytes are required) or kMalformed
+RpcDecodeStatus DecodeResponse(const std::string& buffer, std::size_t& offset, RpcResponse& response);
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_RPC_PROTOCOL_H_
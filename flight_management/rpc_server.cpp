@@ -0,0 +1,745 @@
+///
+/// @file rpc_server.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/rpc_server.h"
+#include "flight_management/logging.h"
+#include "flight_management/rpc_socket.h"
+#include "flight_management/tracing.h"
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace fms
+{
+namespace
+{
+/// @brief Unsent response bytes of a connection above which reading its requests is paused
+constexpr std::size_t kMaxUnsentResponseBytes{4U * kMaxRpcFrameSize};
+
+/// @brief Unsent response bytes of a connection below which reading its requests is resumed
+constexpr std::size_t kResumeUnsentResponseBytes{kMaxUnsentResponseBytes / 2U};
+
+/// @brief Queued (decoded but not yet executed) requests of a connection above which reading its requests is paused
+constexpr std::size_t kMaxQueuedRequests{1024U};
+
+/// @brief Queued requests of a connection below which reading its requests is resumed
+constexpr std::size_t kResumeQueuedRequests{kMaxQueuedRequests / 2U};
+
+/// @brief Encoded bytes of queued requests of a connection above which reading its requests is paused
+constexpr std::size_t kMaxQueuedRequestBytes{2U * kMaxRpcFrameSize};
+
+/// @brief Encoded bytes of queued requests of a connection below which reading its requests is resumed
+constexpr std::size_t kResumeQueuedRequestBytes{kMaxQueuedRequestBytes / 2U};
+}  // namespace
+
+/// @brief Connection served by an event loop
+struct RpcConnection
+{
+    /// @brief Constructor
+    ///
+    /// @param connection_fd[in] - Connected socket
+    /// @param connection_event_loop[in] - Event loop serving the connection
+    RpcConnection(const int connection_fd, RpcEventLoop& connection_event_loop)
+        : fd{connection_fd},
+          event_loop{connection_event_loop},
+          received{},
+          mutex{},
+          responses{},
+          sending{},
+          sent{0U},
+          queued_requests{0U},
+          queued_request_bytes{0U},
+          reading{true},
+          closed{false}
+    {
+    }
+
+    /// @brief Destructor, closes socket
+    ~RpcConnection() { ::close(fd); }
+
+    RpcConnection(const RpcConnection&) = delete;
+    RpcConnection& operator=(const RpcConnection&) = delete;
+
+    /// @brief Socket (closed once the last reference is dropped, so that its number is not reused too early)
+    const int fd;
+
+    /// @brief Event loop serving the connection
+    RpcEventLoop& event_loop;
+
+    /// @brief Received bytes which do not form a complete frame yet (event loop only)
+    std::string received;
+
+    /// @brief Guards responses
+    std::mutex mutex;
+
+    /// @brief Encoded responses to be sent (appended by database thread)
+    std::string responses;
+
+    /// @brief Responses being sent (event loop only)
+    std::string sending;
+
+    /// @brief Number of bytes of sending already sent (event loop only)
+    std::size_t sent;
+
+    /// @brief Number of requests queued for execution (incremented by event loop, decremented by database thread)
+    std::atomic<std::size_t> queued_requests;
+
+    /// @brief Encoded bytes of requests queued for execution
+    std::atomic<std::size_t> queued_request_bytes;
+
+    /// @brief Whether requests are read, false while too many requests are queued or response bytes are unsent (event
+    ///        loop only)
+    bool reading;
+
+    /// @brief Whether connection is closed, pending responses are dropped
+    std::atomic<bool> closed;
+};
+
+/// @brief Event loop serving connections on a dedicated thread (edge triggered epoll)
+class RpcEventLoop
+{
+  public:
+    /// @brief Constructor
+    ///
+    /// @param server[in] - Server to queue received requests on
+    /// @param listen_fd[in] - Listening socket to accept connections from
+    RpcEventLoop(RpcServer& server, const int listen_fd)
+        : server_{server},
+          listen_fd_{listen_fd},
+          epoll_fd_{::epoll_create1(EPOLL_CLOEXEC)},
+          wake_fd_{::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC)},
+          stop_{false},
+          mutex_{},
+          flush_queue_{},
+          connections_{},
+          thread_{}
+    {
+        ASSERT_CHECK((epoll_fd_ >= 0) && (wake_fd_ >= 0)) << "Failed to create event loop: " << std::strerror(errno);
+
+        // Listening socket is shared by all event loops, exclusive wake-ups spread connections over them
+        epoll_event listen_event{};
+        listen_event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        listen_event.data.fd = listen_fd_;
+        epoll_event wake_event{};
+        wake_event.events = EPOLLIN;
+        wake_event.data.fd = wake_fd_;
+        ASSERT_CHECK((::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &listen_event) == 0) &&
+                     (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &wake_event) == 0))
+            << "Failed to register event loop sockets: " << std::strerror(errno);
+    }
+
+    ~RpcEventLoop()
+    {
+        Stop();
+        ::close(wake_fd_);
+        ::close(epoll_fd_);
+    }
+
+    RpcEventLoop(const RpcEventLoop&) = delete;
+    RpcEventLoop& operator=(const RpcEventLoop&) = delete;
+
+    /// @brief Start event loop thread
+    void Start()
+    {
+        thread_ = std::thread{[this]() { Run(); }};
+    }
+
+    /// @brief Stop event loop thread and close its connections
+    void Stop()
+    {
+        if (thread_.joinable())
+        {
+            stop_.store(true);
+            Wake();
+            thread_.join();
+        }
+    }
+
+    /// @brief Send responses queued on connection (thread-safe)
+    void ScheduleFlush(std::shared_ptr<RpcConnection> connection)
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            flush_queue_.push_back(std::move(connection));
+        }
+        Wake();
+    }
+
+  private:
+    /// @brief Event loop thread: accepts connections, reads requests and sends scheduled responses
+    void Run()
+    {
+        std::array<epoll_event, 64U> events{};
+        std::vector<RpcServer::PendingRequest> received_requests;
+        while (!stop_.load())
+        {
+            const auto number_of_events = ::epoll_wait(epoll_fd_, events.data(), static_cast<int>(events.size()), -1);
+            for (int idx = 0; idx < number_of_events; ++idx)
+            {
+                const auto fd = events[static_cast<std::size_t>(idx)].data.fd;
+                const auto flags = events[static_cast<std::size_t>(idx)].events;
+                if (fd == listen_fd_)
+                {
+                    Accept();
+                }
+                else if (fd == wake_fd_)
+                {
+                    FlushScheduled();
+                }
+                else
+                {
+                    const auto connection = connections_.find(fd);
+                    if ((connection != connections_.end()) && ((flags & EPOLLOUT) != 0U))
+                    {
+                        Flush(connection->second);
+                    }
+                    if ((connection != connections_.end()) && ((flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0U))
+                    {
+                        Read(connection->second, received_requests);
+                    }
+                }
+            }
+
+            // Requests received from all connections in this iteration are queued at once
+            if (!received_requests.empty())
+            {
+                server_.Enqueue(std::move(received_requests));
+                received_requests.clear();
+            }
+        }
+
+        while (!connections_.empty())
+        {
+            Close(connections_.begin()->second);
+        }
+    }
+
+    /// @brief Accept all pending connections
+    void Accept()
+    {
+        for (auto fd = AcceptFrom(listen_fd_); fd >= 0; fd = AcceptFrom(listen_fd_))
+        {
+            auto connection = std::make_shared<RpcConnection>(fd, *this);
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLOUT | EPOLLET;
+            event.data.fd = fd;
+            if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0)
+            {
+                LOG(ERROR) << "Failed to register connection: " << std::strerror(errno);
+                continue;
+            }
+            connections_.emplace(fd, std::move(connection));
+        }
+    }
+
+    /// @brief Read and decode received requests of connection until its socket is drained or too many of its requests
+    ///        are queued, closes connection on malformed request or EOF
+    void Read(const std::shared_ptr<RpcConnection>& connection, std::vector<RpcServer::PendingRequest>& requests)
+    {
+        // Edge triggered, hence read until socket is drained, unless reading is paused (re-arming reports the rest)
+        std::array<char, 65536U> buffer{};
+        auto peer_closed = false;
+        auto status = RpcDecodeStatus::kIncomplete;
+        while (!HasTooManyQueuedRequests(*connection))
+        {
+            const auto received = ::recv(connection->fd, buffer.data(), buffer.size(), 0);
+            if (received > 0)
+            {
+                connection->received.append(buffer.data(), static_cast<std::size_t>(received));
+                status = Decode(connection, requests);
+                if (status == RpcDecodeStatus::kMalformed)
+                {
+                    break;
+                }
+            }
+            else if ((received < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            else
+            {
+                peer_closed = (received == 0) || ((errno != EAGAIN) && (errno != EWOULDBLOCK));
+                break;
+            }
+        }
+
+        if (status == RpcDecodeStatus::kMalformed)
+        {
+            LOG(ERROR) << "Closing connection, received malformed request";
+            Close(connection);
+        }
+        else if (peer_closed)
+        {
+            Close(connection);
+        }
+        else
+        {
+            UpdateReading(connection);
+        }
+    }
+
+    /// @brief Decode all complete requests received on connection and count them as queued
+    ///
+    /// @return status - kMalformed if a malformed request was received, otherwise kIncomplete
+    RpcDecodeStatus Decode(const std::shared_ptr<RpcConnection>& connection,
+                           std::vector<RpcServer::PendingRequest>& requests)
+    {
+        std::size_t offset{0U};
+        auto begin = offset;
+        RpcRequest request{};
+        auto status = DecodeRequest(connection->received, offset, request);
+        for (; status == RpcDecodeStatus::kDecoded; status = DecodeRequest(connection->received, offset, request))
+        {
+            requests.push_back(RpcServer::PendingRequest{connection, std::move(request), offset - begin});
+            ++connection->queued_requests;
+            connection->queued_request_bytes += offset - begin;
+            begin = offset;
+        }
+        connection->received.erase(0U, offset);
+        return status;
+    }
+
+    /// @brief Send responses of all connections scheduled by ScheduleFlush
+    void FlushScheduled()
+    {
+        std::uint64_t wake_ups{0U};
+        static_cast<void>(::read(wake_fd_, &wake_ups, sizeof(wake_ups)));
+
+        std::vector<std::shared_ptr<RpcConnection>> connections;
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            connections.swap(flush_queue_);
+        }
+        for (const auto& connection : connections)
+        {
+            if (!connection->closed.load())
+            {
+                Flush(connection);
+            }
+        }
+    }
+
+    /// @brief Send queued responses of connection until they are sent or socket buffer is full, then pause or resume
+    ///        reading requests
+    void Flush(const std::shared_ptr<RpcConnection>& connection)
+    {
+        Send(connection);
+        UpdateReading(connection);
+    }
+
+    /// @brief Pause reading requests of connection while too many of its requests are queued or too many of its
+    ///        response bytes are unsent, resume once both dropped below their resume thresholds
+    void UpdateReading(const std::shared_ptr<RpcConnection>& connection)
+    {
+        std::size_t unsent{connection->sending.size() - connection->sent};
+        {
+            std::lock_guard<std::mutex> lock{connection->mutex};
+            unsent += connection->responses.size();
+        }
+        if (connection->reading && (HasTooManyQueuedRequests(*connection) || (unsent > kMaxUnsentResponseBytes)))
+        {
+            SetReading(connection, false);
+        }
+        else if (!connection->reading && (connection->queued_requests.load() < kResumeQueuedRequests) &&
+                 (connection->queued_request_bytes.load() < kResumeQueuedRequestBytes) &&
+                 (unsent < kResumeUnsentResponseBytes))
+        {
+            SetReading(connection, true);
+        }
+    }
+
+    /// @brief Check whether so many requests of connection are queued that reading further requests is to be paused
+    static bool HasTooManyQueuedRequests(const RpcConnection& connection)
+    {
+        return (connection.queued_requests.load() > kMaxQueuedRequests) ||
+               (connection.queued_request_bytes.load() > kMaxQueuedRequestBytes);
+    }
+
+    /// @brief Send queued responses of connection until they are sent or socket buffer is full
+    void Send(const std::shared_ptr<RpcConnection>& connection)
+    {
+        while (true)
+        {
+            if (connection->sent == connection->sending.size())
+            {
+                std::lock_guard<std::mutex> lock{connection->mutex};
+                connection->sending.clear();
+                connection->sent = 0U;
+                connection->sending.swap(connection->responses);
+            }
+            if (connection->sending.empty())
+            {
+                return;
+            }
+
+            const auto sent = ::send(connection->fd, connection->sending.data() + connection->sent,
+                                     connection->sending.size() - connection->sent, MSG_NOSIGNAL);
+            if (sent > 0)
+            {
+                connection->sent += static_cast<std::size_t>(sent);
+            }
+            else if ((sent < 0) && (errno == EINTR))
+            {
+                continue;
+            }
+            else
+            {
+                // Socket buffer is full (EAGAIN) or peer is gone, edge triggered EPOLLOUT/EPOLLHUP resumes or closes
+                return;
+            }
+        }
+    }
+
+    /// @brief Pause or resume reading requests of connection (neither a peer which does not read its responses nor one
+    ///        which pipelines faster than the database executes can make the server buffer unbounded responses or
+    ///        requests, pending requests stay in the socket buffers instead)
+    void SetReading(const std::shared_ptr<RpcConnection>& connection, const bool reading)
+    {
+        // Re-arming EPOLLIN reports requests which arrived while paused, as the edge is evaluated again
+        epoll_event event{};
+        event.events = (reading ? EPOLLIN : 0U) | EPOLLOUT | EPOLLET;
+        event.data.fd = connection->fd;
+        if (::epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection->fd, &event) != 0)
+        {
+            LOG(ERROR) << "Failed to " << (reading ? "resume" : "pause") << " reading connection: "
+                       << std::strerror(errno);
+            return;
+        }
+        connection->reading = reading;
+        if (!reading)
+        {
+            ++server_.paused_reads_;
+        }
+    }
+
+    /// @brief Stop serving connection
+    void Close(const std::shared_ptr<RpcConnection>& connection)
+    {
+        connection->closed.store(true);
+        static_cast<void>(::epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection->fd, nullptr));
+        connections_.erase(connection->fd);
+    }
+
+    /// @brief Wake up event loop thread
+    void Wake()
+    {
+        const std::uint64_t wake_up{1U};
+        static_cast<void>(::write(wake_fd_, &wake_up, sizeof(wake_up)));
+    }
+
+    /// @brief Server to queue received requests on
+    RpcServer& server_;
+
+    /// @brief Listening socket (shared by all event loops)
+    const int listen_fd_;
+
+    /// @brief Event poll
+    const int epoll_fd_;
+
+    /// @brief Event used to wake up event loop thread
+    const int wake_fd_;
+
+    /// @brief Stop event loop thread
+    std::atomic<bool> stop_;
+
+    /// @brief Guards flush_queue_
+    std::mutex mutex_;
+
+    /// @brief Connections with responses to be sent
+    std::vector<std::shared_ptr<RpcConnection>> flush_queue_;
+
+    /// @brief Served connections by socket (event loop only)
+    std::unordered_map<int, std::shared_ptr<RpcConnection>> connections_;
+
+    /// @brief Event loop thread
+    std::thread thread_;
+};
+
+namespace
+{
+/// @brief Execute query received over RPC, rebuilt from its field predicates, ordering keys and limit, returning the
+///        requested page of results
+std::vector<FlightTrip> ExecuteQuery(const RpcQuery& rpc_query, const IFlightTripDatabase& database)
+{
+    const auto& filter = rpc_query.filter;
+    if (filter.matches_nothing)
+    {
+        return {};
+    }
+
+    auto query = database.Query();
+    if (filter.has_name)
+    {
+        query.WhereName(filter.name);
+    }
+    if (filter.has_operated_by)
+    {
+        query.WhereOperatedBy(filter.operated_by);
+    }
+    if (filter.has_origin_city)
+    {
+        query.WhereOriginCity(filter.origin_city);
+    }
+    if (filter.has_destination_city)
+    {
+        query.WhereDestinationCity(filter.destination_city);
+    }
+    // Results of previous pages are skipped while streaming, they are neither copied nor returned
+    const auto limit = std::min(rpc_query.limit, std::numeric_limits<std::uint64_t>::max() - rpc_query.offset);
+    query.WhereNamePrefix(filter.name_prefix)
+        .WhereFareBetween(filter.min_fare, filter.max_fare)
+        .WhereDepartureBetween(filter.departure_from, filter.departure_to)
+        .Limit(static_cast<std::size_t>(rpc_query.offset + limit));
+    std::for_each(rpc_query.order.begin(), rpc_query.order.end(),
+                  [&query](const auto& order) { query.OrderBy(order.field, order.descending); });
+    std::vector<FlightTrip> trips;
+    std::uint64_t skipped{0U};
+    static_cast<void>(query.ForEach([&](const FlightTrip& trip) {
+        if (skipped < rpc_query.offset)
+        {
+            ++skipped;
+        }
+        else
+        {
+            trips.push_back(trip);
+        }
+        return true;
+    }));
+    return trips;
+}
+
+/// @brief Execute request on database
+RpcResponse Execute(const RpcRequest& request, IFlightTripDatabase& database)
+{
+    const auto& trip = request.trip;
+    RpcResponse response{request.id, request.opcode, RpcStatus::kOk, {}, 0.0, 0U};
+    switch (request.opcode)
+    {
+        case RpcOpcode::kAddTrip:
+            database.AddTrip(trip.name, trip.operated_by, trip.origin_city, trip.destination_city, trip.fare,
+                             trip.departure_time, trip.arrival_time);
+            break;
+        case RpcOpcode::kRemoveTrip:
+            database.RemoveTrip(trip.name);
+            break;
+        case RpcOpcode::kUpdateFareByTrip:
+            database.UpdateFareByTrip(trip.name, trip.fare);
+            break;
+        case RpcOpcode::kUpdateFareByOperator:
+            database.UpdateFareByOperator(trip.operated_by, trip.fare);
+            break;
+        case RpcOpcode::kRemoveTripByDeparture:
+            database.RemoveTrip(trip.name, trip.departure_time);
+            break;
+        case RpcOpcode::kUpdateFareByDeparture:
+            database.UpdateFareByTrip(trip.name, trip.departure_time, trip.fare);
+            break;
+        case RpcOpcode::kFindFlightByNumber:
+            response.trips = database.FindFlightByNumber(trip.name);
+            break;
+        case RpcOpcode::kFindFlightsByOriginCity:
+            response.trips = database.FindFlightsByOriginCity(trip.origin_city);
+            break;
+        case RpcOpcode::kFindFlightsByNumberPrefix:
+            response.trips = database.FindFlightsByNumberPrefix(trip.name);
+            break;
+        case RpcOpcode::kFindFlightsByOriginCityPrefix:
+            response.trips = database.FindFlightsByOriginCityPrefix(trip.origin_city);
+            break;
+        case RpcOpcode::kFindAverageCostOfAllTrips:
+            response.fare = database.FindAverageCostOfAllTrips();
+            break;
+        case RpcOpcode::kFindMinFareBetweenCities:
+            response.fare = database.FindMinFareBetweenCities(trip.origin_city, trip.destination_city);
+            break;
+        case RpcOpcode::kFindFlightsByOriginCityInTimeWindow:
+            response.trips = database.FindFlightsByOriginCityInTimeWindow(trip.origin_city, request.from, request.to);
+            break;
+        case RpcOpcode::kFindMinFareBetweenCitiesInTimeWindow:
+            response.fare = database.FindMinFareBetweenCitiesInTimeWindow(trip.origin_city, trip.destination_city,
+                                                                          request.from, request.to);
+            break;
+        case RpcOpcode::kFindMaxFareByOperator:
+            response.fare = database.FindMaxFareByOperator(trip.operated_by);
+            break;
+        case RpcOpcode::kExecuteQuery:
+            response.trips = ExecuteQuery(request.query, database);
+            break;
+        case RpcOpcode::kGetTotalTrips:
+        default:
+            response.total_trips = database.GetTotalTrips();
+            break;
+    }
+    return response;
+}
+}  // namespace
+
+RpcServer::RpcServer(std::unique_ptr<IFlightTripDatabase> database, const std::string& endpoint,
+                     const std::size_t number_of_threads)
+    : endpoint_{endpoint},
+      number_of_threads_{std::max(std::size_t{1U}, number_of_threads)},
+      listen_fd_{-1},
+      event_loops_{},
+      mutex_{},
+      pending_requests_{},
+      requests_{0U},
+      batches_{0U},
+      deduplicated_lookups_{0U},
+      paused_reads_{0U},
+      database_{std::move(database)}
+{
+}
+
+RpcServer::~RpcServer() { Stop(); }
+
+bool RpcServer::Start()
+{
+    if (!event_loops_.empty())
+    {
+        return listen_fd_ >= 0;
+    }
+
+    listen_fd_ = ListenOn(endpoint_);
+    if (listen_fd_ < 0)
+    {
+        return false;
+    }
+    for (std::size_t idx = 0U; idx < number_of_threads_; ++idx)
+    {
+        event_loops_.push_back(std::make_unique<RpcEventLoop>(*this, listen_fd_));
+        event_loops_.back()->Start();
+    }
+    LOG(INFO) << "Serving on {" << endpoint_ << "} with " << number_of_threads_ << " event loop threads";
+    return true;
+}
+
+void RpcServer::Stop()
+{
+    if (listen_fd_ < 0)
+    {
+        return;
+    }
+    std::for_each(event_loops_.begin(), event_loops_.end(), [](auto& event_loop) { event_loop->Stop(); });
+    ::close(listen_fd_);
+    listen_fd_ = -1;
+    RemoveEndpoint(endpoint_);
+}
+
+RpcServerStatistics RpcServer::GetStatistics() const
+{
+    return RpcServerStatistics{requests_.load(), batches_.load(), deduplicated_lookups_.load(), paused_reads_.load()};
+}
+
+void RpcServer::Enqueue(std::vector<PendingRequest> requests)
+{
+    requests_ += requests.size();
+    auto schedule_batch = false;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        schedule_batch = pending_requests_.empty();
+        std::move(requests.begin(), requests.end(), std::back_inserter(pending_requests_));
+    }
+    if (schedule_batch)
+    {
+        database_.Submit<BatchResponses>(
+            [this](IFlightTripDatabase& database) { return ExecuteBatch(database); },
+            [this](std::future<BatchResponses> responses) { SendResponses(std::move(responses)); });
+    }
+}
+
+RpcServer::BatchResponses RpcServer::ExecuteBatch(IFlightTripDatabase& database)
+{
+    TRACE_SPAN("RpcServer::ExecuteBatch");
+    std::vector<PendingRequest> requests;
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        requests.swap(pending_requests_);
+    }
+    ++batches_;
+
+    // Results of lookups in this batch, keyed by encoded request (without id), valid until the next mutation
+    std::unordered_map<std::string, RpcResponse> lookups;
+    std::unordered_map<RpcConnection*, std::string> responses;
+    std::string key;
+    for (const auto& pending : requests)
+    {
+        // Executed requests no longer count against reading further requests of their connection (resumed by Flush)
+        --pending.connection->queued_requests;
+        pending.connection->queued_request_bytes -= pending.size;
+        auto& encoded_responses = responses[pending.connection.get()];
+        if (IsMutation(pending.request.opcode))
+        {
+            lookups.clear();
+            EncodeResponse(Execute(pending.request, database), encoded_responses);
+            continue;
+        }
+
+        key.clear();
+        EncodeRequest(RpcRequest{0U, pending.request.opcode, pending.request.trip, pending.request.from,
+                                 pending.request.to, pending.request.query},
+                      key);
+        auto lookup = lookups.find(key);
+        if (lookup == lookups.end())
+        {
+            lookup = lookups.emplace(key, Execute(pending.request, database)).first;
+        }
+        else
+        {
+            ++deduplicated_lookups_;
+        }
+        lookup->second.id = pending.request.id;
+        EncodeResponse(lookup->second, encoded_responses);
+    }
+
+    BatchResponses batch_responses;
+    batch_responses.reserve(responses.size());
+    for (const auto& pending : requests)
+    {
+        const auto encoded_responses = responses.find(pending.connection.get());
+        if (encoded_responses != responses.end())
+        {
+            batch_responses.emplace_back(pending.connection, std::move(encoded_responses->second));
+            responses.erase(encoded_responses);
+        }
+    }
+    return batch_responses;
+}
+
+void RpcServer::SendResponses(std::future<BatchResponses> responses)
+{
+    BatchResponses batch_responses;
+    try
+    {
+        batch_responses = responses.get();
+    }
+    catch (const std::exception& error)
+    {
+        LOG(ERROR) << "Failed to execute request batch: " << error.what();
+        return;
+    }
+
+    for (auto& response : batch_responses)
+    {
+        {
+            std::lock_guard<std::mutex> lock{response.first->mutex};
+            response.first->responses.append(response.second);
+        }
+        response.first->event_loop.ScheduleFlush(std::move(response.first));
+    }
+}
+
+}  // namespace fms
@@ -0,0 +1,154 @@
+///
+/// @file rpc_server.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_RPC_SERVER_H_
+#define FLIGHT_MANAGEMENT_RPC_SERVER_H_
+
+#include "flight_management/async_flight_trip_database.h"
+#include "flight_management/i_flight_trip_database.h"
+#include "flight_management/rpc_protocol.h"
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief RPC Server Statistics
+struct RpcServerStatistics
+{
+    /// @brief Number of received requests
+    std::size_t requests;
+
+    /// @brief Number of request batches executed on the database
+    std::size_t batches;
+
+    /// @brief Number of lookups answered by an identical lookup of the same batch
+    std::size_t deduplicated_lookups;
+
+    /// @brief Number of times reading requests of a connection was paused, as its peer did not read responses or too
+    ///        many of its requests were queued
+    std::size_t paused_reads;
+};
+
+struct RpcConnection;
+class RpcEventLoop;
+
+/// @brief Serves Flight Trip Database operations over a Unix domain socket or loopback TCP (see rpc_protocol.h).
+///
+/// Connections are spread over multiple event loop threads, which read and decode pipelined requests and write
+/// responses. Decoded requests of all connections are queued and executed as batches on the (single) database thread:
+/// while a batch executes, further requests are collected into the next batch. Within a batch, requests are executed
+/// in arrival order and identical lookups between two mutations are executed once. Reading requests of a connection is
+/// paused while too many of its requests are queued or too many of its response bytes are unsent, so that neither
+/// peers which pipeline faster than the database executes nor peers which do not read can exhaust memory.
+class RpcServer
+{
+  public:
+    /// @brief Constructor
+    ///
+    /// @param database[in] - Database to serve
+    /// @param endpoint[in] - Endpoint to listen on, "unix:<path>" or "tcp:<port>"
+    /// @param number_of_threads[in] - Number of event loop threads
+    explicit RpcServer(std::unique_ptr<IFlightTripDatabase> database, const std::string& endpoint,
+                       const std::size_t number_of_threads);
+
+    /// @brief Destructor, stops the server
+    ~RpcServer();
+
+    RpcServer(const RpcServer&) = delete;
+    RpcServer& operator=(const RpcServer&) = delete;
+
+    /// @brief Start listening and serving connections
+    ///
+    /// @return started - false if endpoint can not be listened on (already started servers return true)
+    bool Start();
+
+    /// @brief Stop serving, closes all connections (requests which are already queued are still executed)
+    void Stop();
+
+    /// @brief Get request and batch counters
+    ///
+    /// @return statistics - server statistics
+    RpcServerStatistics GetStatistics() const;
+
+  private:
+    friend class RpcEventLoop;
+
+    /// @brief Request received on a connection
+    struct PendingRequest
+    {
+        /// @brief Connection to respond on
+        std::shared_ptr<RpcConnection> connection;
+
+        /// @brief Decoded request
+        RpcRequest request;
+
+        /// @brief Size of the encoded request
+        std::size_t size;
+    };
+
+    /// @brief Encoded responses of a batch for each connection (in order of the connection's first request)
+    using BatchResponses = std::vector<std::pair<std::shared_ptr<RpcConnection>, std::string>>;
+
+    /// @brief Queue received requests, schedules a batch unless one is already pending (called by event loops)
+    ///
+    /// @param requests[in] - Requests received in one event loop iteration
+    void Enqueue(std::vector<PendingRequest> requests);
+
+    /// @brief Execute all queued requests (called on database thread)
+    ///
+    /// @param database[in] - Database to execute requests on
+    ///
+    /// @return responses - Encoded responses for each connection
+    BatchResponses ExecuteBatch(IFlightTripDatabase& database);
+
+    /// @brief Hand responses of an executed batch over to the event loops of their connections (completion of
+    ///        ExecuteBatch, called on database thread)
+    ///
+    /// @param responses[in] - Ready future of the batch's responses
+    void SendResponses(std::future<BatchResponses> responses);
+
+    /// @brief Endpoint to listen on
+    const std::string endpoint_;
+
+    /// @brief Number of event loop threads
+    const std::size_t number_of_threads_;
+
+    /// @brief Listening socket, -1 if not started
+    int listen_fd_;
+
+    /// @brief Event loops, each running on its own thread
+    std::vector<std::unique_ptr<RpcEventLoop>> event_loops_;
+
+    /// @brief Guards pending_requests_
+    std::mutex mutex_;
+
+    /// @brief Requests queued for next batch
+    std::vector<PendingRequest> pending_requests_;
+
+    /// @brief Number of received requests
+    std::atomic<std::size_t> requests_;
+
+    /// @brief Number of executed batches
+    std::atomic<std::size_t> batches_;
+
+    /// @brief Number of deduplicated lookups
+    std::atomic<std::size_t> deduplicated_lookups_;
+
+    /// @brief Number of paused reads
+    std::atomic<std::size_t> paused_reads_;
+
+    /// @brief Served database (declared last, so that queued batches finish before other members are destroyed)
+    AsyncFlightTripDatabase database_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_RPC_SERVER_H_
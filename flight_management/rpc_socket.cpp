@@ -0,0 +1,185 @@
+///
+/// @file rpc_socket.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/rpc_socket.h"
+#include "flight_management/logging.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace fms
+{
+namespace
+{
+const std::string kUnixScheme{"unix:"};
+const std::string kTcpScheme{"tcp:"};
+
+/// @brief Socket address of an endpoint
+struct SocketAddress
+{
+    sockaddr_storage storage;
+    socklen_t length;
+};
+
+bool StartsWith(const std::string& value, const std::string& prefix)
+{
+    return value.compare(0U, prefix.size(), prefix) == 0;
+}
+
+bool ToSocketAddress(const std::string& endpoint, SocketAddress& address)
+{
+    std::memset(&address.storage, 0, sizeof(address.storage));
+    if (StartsWith(endpoint, kUnixScheme))
+    {
+        const auto path = endpoint.substr(kUnixScheme.size());
+        auto& unix_address = reinterpret_cast<sockaddr_un&>(address.storage);
+        if (path.empty() || (path.size() >= sizeof(unix_address.sun_path)))
+        {
+            LOG(ERROR) << "Invalid Unix domain socket path {" << path << "}";
+            return false;
+        }
+        unix_address.sun_family = AF_UNIX;
+        std::memcpy(unix_address.sun_path, path.c_str(), path.size() + 1U);
+        address.length = sizeof(sockaddr_un);
+        return true;
+    }
+    if (StartsWith(endpoint, kTcpScheme))
+    {
+        const auto port = std::strtoul(endpoint.c_str() + kTcpScheme.size(), nullptr, 10);
+        auto& tcp_address = reinterpret_cast<sockaddr_in&>(address.storage);
+        if ((port == 0U) || (port > 65535U))
+        {
+            LOG(ERROR) << "Invalid TCP port in endpoint {" << endpoint << "}";
+            return false;
+        }
+        tcp_address.sin_family = AF_INET;
+        tcp_address.sin_port = htons(static_cast<std::uint16_t>(port));
+        tcp_address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.length = sizeof(sockaddr_in);
+        return true;
+    }
+    LOG(ERROR) << "Unsupported endpoint {" << endpoint << "}, expected unix:<path> or tcp:<port>";
+    return false;
+}
+
+/// @brief Disable Nagle's algorithm, so that small pipelined frames are sent immediately (TCP sockets only, the option
+///        is rejected by Unix domain sockets, which do not delay frames anyway)
+void SetNoDelay(const int fd)
+{
+    const int enable{1};
+    static_cast<void>(::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable)));
+}
+
+/// @brief Remove Unix domain socket file left behind by a server which did not stop cleanly (i.e. crashed), so that
+///        binding its path succeeds. Sockets still accepting connections and other files are left alone.
+void RemoveStaleSocket(const SocketAddress& address)
+{
+    const auto& unix_address = reinterpret_cast<const sockaddr_un&>(address.storage);
+    struct stat status{};
+    if ((::stat(unix_address.sun_path, &status) != 0) || !S_ISSOCK(status.st_mode))
+    {
+        return;
+    }
+
+    const auto fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return;
+    }
+    if ((::connect(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0) &&
+        (errno == ECONNREFUSED))
+    {
+        LOG(INFO) << "Removing stale Unix domain socket {" << unix_address.sun_path << "}";
+        ::unlink(unix_address.sun_path);
+    }
+    ::close(fd);
+}
+}  // namespace
+
+int ListenOn(const std::string& endpoint)
+{
+    SocketAddress address{};
+    if (!ToSocketAddress(endpoint, address))
+    {
+        return -1;
+    }
+    if (address.storage.ss_family == AF_UNIX)
+    {
+        RemoveStaleSocket(address);
+    }
+
+    const auto fd = ::socket(address.storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    const int enable{1};
+    if ((fd < 0) || ((address.storage.ss_family == AF_INET) &&
+                     (::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) != 0)) ||
+        (::bind(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0) ||
+        (::listen(fd, SOMAXCONN) != 0) || !SetNonBlocking(fd))
+    {
+        LOG(ERROR) << "Failed to listen on {" << endpoint << "}: " << std::strerror(errno)
+                   << ((errno == EADDRINUSE) ? " (is another server running?)" : "");
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return -1;
+    }
+    return fd;
+}
+
+int ConnectTo(const std::string& endpoint)
+{
+    SocketAddress address{};
+    if (!ToSocketAddress(endpoint, address))
+    {
+        return -1;
+    }
+
+    const auto fd = ::socket(address.storage.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if ((fd < 0) || (::connect(fd, reinterpret_cast<const sockaddr*>(&address.storage), address.length) != 0))
+    {
+        LOG(ERROR) << "Failed to connect to {" << endpoint << "}: " << std::strerror(errno);
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return -1;
+    }
+    SetNoDelay(fd);
+    return fd;
+}
+
+int AcceptFrom(const int listen_fd)
+{
+    const auto fd = ::accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd >= 0)
+    {
+        SetNoDelay(fd);
+    }
+    return fd;
+}
+
+void RemoveEndpoint(const std::string& endpoint)
+{
+    if (StartsWith(endpoint, kUnixScheme))
+    {
+        ::unlink(endpoint.substr(kUnixScheme.size()).c_str());
+    }
+}
+
+bool SetNonBlocking(const int fd)
+{
+    const auto flags = ::fcntl(fd, F_GETFL, 0);
+    return (flags >= 0) && (::fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0);
+}
+
+}  // namespace fms
@@ -0,0 +1,51 @@
+///
+/// @file rpc_socket.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_RPC_SOCKET_H_
+#define FLIGHT_MANAGEMENT_RPC_SOCKET_H_
+
+#include <string>
+
+namespace fms
+{
+/// @brief Open listening socket on endpoint
+///
+/// Endpoints are either "unix:<path>" (Unix domain socket) or "tcp:<port>" (TCP, loopback interface only).
+/// A stale Unix domain socket file, which no server accepts connections on anymore, is removed before binding.
+/// Failures are logged.
+///
+/// @param endpoint[in] - Endpoint to listen on
+///
+/// @return fd - non-blocking listening socket, -1 on failure
+int ListenOn(const std::string& endpoint);
+
+/// @brief Connect blocking socket to endpoint (see ListenOn). Failures are logged.
+///
+/// @param endpoint[in] - Endpoint to connect to
+///
+/// @return fd - connected socket, -1 on failure
+int ConnectTo(const std::string& endpoint);
+
+/// @brief Accept pending connection on listening socket
+///
+/// @param listen_fd[in] - Listening socket (see ListenOn)
+///
+/// @return fd - non-blocking connected socket, -1 if no connection is pending
+int AcceptFrom(const int listen_fd);
+
+/// @brief Remove file system entry of Unix domain socket endpoint (does nothing for TCP endpoints)
+///
+/// @param endpoint[in] - Endpoint
+void RemoveEndpoint(const std::string& endpoint);
+
+/// @brief Switch socket to non-blocking mode
+///
+/// @param fd[in] - Socket
+///
+/// @return success - false on failure
+bool SetNonBlocking(const int fd);
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_RPC_SOCKET_H_
@@ -0,0 +1,99 @@
+///
+/// @file schedule_index.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/schedule_index.h"
+#include "flight_management/tracing.h"
+
+#include <algorithm>
+
+namespace fms
+{
+namespace
+{
+/// @brief Order entries by departure time only
+bool DepartsBefore(const ScheduleIndex::Entry& entry, const Timestamp time) { return entry.first < time; }
+}  // namespace
+
+void ScheduleIndex::Insert(const Key key, const Timestamp departure_time, const std::size_t slot)
+{
+    TRACE_SPAN("ScheduleIndex::Insert");
+    auto& entries = entries_[key];
+    const auto position =
+        std::upper_bound(entries.begin(), entries.end(), departure_time,
+                         [](const Timestamp time, const Entry& entry) { return time < entry.first; });
+    entries.insert(position, Entry{departure_time, slot});
+}
+
+void ScheduleIndex::Erase(const Key key, const Timestamp departure_time, const std::size_t slot)
+{
+    TRACE_SPAN("ScheduleIndex::Erase");
+    const auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+        return;
+    }
+    const auto entry = FindEntry(it->second, departure_time, slot);
+    if (entry != it->second.end())
+    {
+        it->second.erase(entry);
+    }
+    if (it->second.empty())
+    {
+        entries_.erase(it);
+    }
+}
+
+void ScheduleIndex::Replace(const Key key, const Timestamp departure_time, const std::size_t old_slot,
+                            const std::size_t new_slot)
+{
+    const auto it = entries_.find(key);
+    if (it == entries_.end())
+    {
+        return;
+    }
+    const auto entry = FindEntry(it->second, departure_time, old_slot);
+    if (entry != it->second.end())
+    {
+        entry->second = new_slot;
+    }
+}
+
+void ScheduleIndex::Rebuild(const std::vector<std::pair<Key, Entry>>& entries)
+{
+    TRACE_SPAN("ScheduleIndex::Rebuild");
+    entries_.clear();
+    for (const auto& entry : entries)
+    {
+        entries_[entry.first].push_back(entry.second);
+    }
+    for (auto& key_entries : entries_)
+    {
+        std::stable_sort(key_entries.second.begin(), key_entries.second.end(),
+                         [](const Entry& lhs, const Entry& rhs) { return lhs.first < rhs.first; });
+    }
+}
+
+std::pair<std::vector<ScheduleIndex::Entry>::const_iterator, std::vector<ScheduleIndex::Entry>::const_iterator>
+ScheduleIndex::Find(const Key key, const Timestamp from, const Timestamp to) const
+{
+    TRACE_SPAN("ScheduleIndex::Find");
+    const auto it = entries_.find(key);
+    const auto& entries = (it == entries_.end()) ? no_entries_ : it->second;
+    const auto begin = std::lower_bound(entries.begin(), entries.end(), from, DepartsBefore);
+    const auto end = std::lower_bound(begin, entries.end(), std::max(from, to), DepartsBefore);
+    return std::make_pair(begin, end);
+}
+
+std::vector<ScheduleIndex::Entry>::iterator ScheduleIndex::FindEntry(std::vector<Entry>& entries,
+                                                                     const Timestamp departure_time,
+                                                                     const std::size_t slot)
+{
+    const auto begin = std::lower_bound(entries.begin(), entries.end(), departure_time, DepartsBefore);
+    const auto entry = std::find_if(begin, entries.end(), [&](const auto& candidate) {
+        return (candidate.first != departure_time) || (candidate.second == slot);
+    });
+    return ((entry != entries.end()) && (entry->first == departure_time)) ? entry : entries.end();
+}
+
+}  // namespace fms
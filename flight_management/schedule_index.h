@@ -0,0 +1,94 @@
+///
+/// @file schedule_index.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_SCHEDULE_INDEX_H_
+#define FLIGHT_MANAGEMENT_SCHEDULE_INDEX_H_
+
+#include "flight_management/flight_trip.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief Time ordered index from a key (i.e. origin city or route) to trip slots.
+///
+/// Each key holds a sorted run of (departure time, slot) entries, hence departures of a key within a time window are
+/// found by binary search instead of scanning the table. Runs are contiguous vectors, so adding a departure after all
+/// other departures of its key (the usual, chronological case) is an amortized O(1) append, whereas adding or removing
+/// a departure in the middle of a run moves all later entries of that key, i.e. O(departures of key).
+class ScheduleIndex
+{
+  public:
+    /// @brief Index key (i.e. dictionary id of origin city, or both ids of a route)
+    using Key = std::uint64_t;
+
+    /// @brief Departure time and trip slot
+    using Entry = std::pair<Timestamp, std::size_t>;
+
+    /// @brief Add slot for provided key and departure time. Appends if departure is not earlier than the latest
+    /// departure of the key, otherwise shifts later entries of the key by one.
+    ///
+    /// @param key[in] - Index key
+    /// @param departure_time[in] - Trip departure time
+    /// @param slot[in] - Trip slot in database storage
+    void Insert(const Key key, const Timestamp departure_time, const std::size_t slot);
+
+    /// @brief Remove slot for provided key and departure time. If slot does not exist, function does nothing.
+    /// Shifts later entries of the key by one.
+    ///
+    /// @param key[in] - Index key
+    /// @param departure_time[in] - Trip departure time
+    /// @param slot[in] - Trip slot in database storage
+    void Erase(const Key key, const Timestamp departure_time, const std::size_t slot);
+
+    /// @brief Replace slot for provided key and departure time (i.e. when trip has been moved in database storage)
+    ///
+    /// @param key[in] - Index key
+    /// @param departure_time[in] - Trip departure time
+    /// @param old_slot[in] - Previous trip slot
+    /// @param new_slot[in] - New trip slot
+    void Replace(const Key key, const Timestamp departure_time, const std::size_t old_slot,
+                 const std::size_t new_slot);
+
+    /// @brief Replace all entries of the index, sorting the run of each key once (instead of inserting one by one)
+    ///
+    /// @param entries[in] - Index keys with their departure time and trip slot, in any order
+    void Rebuild(const std::vector<std::pair<Key, Entry>>& entries);
+
+    /// @brief Find entries of provided key departing within time window [from, to)
+    ///
+    /// @param key[in] - Index key
+    /// @param from[in] - Earliest departure time (inclusive)
+    /// @param to[in] - Latest departure time (exclusive)
+    ///
+    /// @return entries - range (begin, end) of entries ordered by departure time
+    std::pair<std::vector<Entry>::const_iterator, std::vector<Entry>::const_iterator> Find(const Key key,
+                                                                                           const Timestamp from,
+                                                                                           const Timestamp to) const;
+
+    /// @brief Make key for a pair of dictionary ids (i.e. route)
+    static Key MakeKey(const std::uint32_t first, const std::uint32_t second)
+    {
+        return (static_cast<Key>(first) << 32U) | static_cast<Key>(second);
+    }
+
+  private:
+    /// @brief Find entry for provided slot within the sorted run
+    std::vector<Entry>::iterator FindEntry(std::vector<Entry>& entries, const Timestamp departure_time,
+                                           const std::size_t slot);
+
+    /// @brief Sorted runs of entries for each key
+    std::unordered_map<Key, std::vector<Entry>> entries_;
+
+    /// @brief Returned for keys without entries
+    const std::vector<Entry> no_entries_{};
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_SCHEDULE_INDEX_H_
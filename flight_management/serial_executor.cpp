@@ -0,0 +1,55 @@
+///
+/// @file serial_executor.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/serial_executor.h"
+
+#include <utility>
+
+namespace fms
+{
+SerialExecutor::SerialExecutor() : mutex_{}, condition_{}, tasks_{}, stop_{false}, worker_{[this]() { Run(); }} {}
+
+SerialExecutor::~SerialExecutor()
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stop_ = true;
+    }
+    condition_.notify_one();
+    worker_.join();
+}
+
+void SerialExecutor::Post(Task task)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        tasks_.push_back(std::move(task));
+    }
+    condition_.notify_one();
+}
+
+void SerialExecutor::Run()
+{
+    std::deque<Task> tasks;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{mutex_};
+            condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+            if (tasks_.empty())
+            {
+                return;
+            }
+            tasks.swap(tasks_);
+        }
+
+        for (auto& task : tasks)
+        {
+            task();
+        }
+        tasks.clear();
+    }
+}
+
+}  // namespace fms
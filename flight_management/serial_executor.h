@@ -0,0 +1,60 @@
+///
+/// @file serial_executor.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_SERIAL_EXECUTOR_H_
+#define FLIGHT_MANAGEMENT_SERIAL_EXECUTOR_H_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace fms
+{
+/// @brief Executes posted tasks one after another, in posting order, on a dedicated worker thread
+class SerialExecutor
+{
+  public:
+    /// @brief Task to be executed
+    using Task = std::function<void()>;
+
+    /// @brief Constructor, starts worker thread
+    SerialExecutor();
+
+    /// @brief Destructor, executes all posted tasks and stops worker thread
+    ~SerialExecutor();
+
+    SerialExecutor(const SerialExecutor&) = delete;
+    SerialExecutor& operator=(const SerialExecutor&) = delete;
+
+    /// @brief Post task for execution (thread-safe)
+    ///
+    /// @param task[in] - Task to execute
+    void Post(Task task);
+
+  private:
+    /// @brief Worker thread loop. Takes all pending tasks at once, so that pipelined tasks are executed back to
+    ///        back without contending on the queue lock for each of them.
+    void Run();
+
+    /// @brief Guards tasks_ and stop_
+    std::mutex mutex_;
+
+    /// @brief Signals new tasks or stop request
+    std::condition_variable condition_;
+
+    /// @brief Pending tasks
+    std::deque<Task> tasks_;
+
+    /// @brief Stop worker thread once pending tasks are executed
+    bool stop_;
+
+    /// @brief Worker thread
+    std::thread worker_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_SERIAL_EXECUTOR_H_
@@ -0,0 +1,85 @@
+///
+/// @file spsc_ring_buffer.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_SPSC_RING_BUFFER_H_
+#define FLIGHT_MANAGEMENT_SPSC_RING_BUFFER_H_
+
+#include "flight_management/cache_aligned_allocator.h"
+#include "flight_management/logging.h"
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief Bounded, lock-free Single Producer Single Consumer (SPSC) ring buffer
+///
+/// @tparam T - Element type (default constructible and move assignable)
+template <typename T>
+class SpscRingBuffer
+{
+  public:
+    /// @brief Constructor
+    /// @param capacity[in] - Maximum number of buffered elements (must be power of two)
+    explicit SpscRingBuffer(const std::size_t capacity) : elements_(capacity), mask_{capacity - 1U}, head_{0U}, tail_{0U}
+    {
+        ASSERT_CHECK((capacity > 0U) && ((capacity & mask_) == 0U)) << "Capacity must be power of two";
+    }
+
+    /// @brief Push element (producer only)
+    ///
+    /// @param element[in] - Element to push
+    ///
+    /// @return pushed - false if buffer is full (element is left untouched)
+    bool TryPush(T&& element)
+    {
+        const auto tail = tail_.load(std::memory_order_relaxed);
+        if ((tail - head_.load(std::memory_order_acquire)) == elements_.size())
+        {
+            return false;
+        }
+        elements_[tail & mask_] = std::move(element);
+        tail_.store(tail + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Pop element (consumer only)
+    ///
+    /// @param element[out] - Popped element
+    ///
+    /// @return popped - false if buffer is empty
+    bool TryPop(T& element)
+    {
+        const auto head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        element = std::move(elements_[head & mask_]);
+        head_.store(head + 1U, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Get maximum number of buffered elements
+    std::size_t Capacity() const { return elements_.size(); }
+
+  private:
+    /// @brief Element storage
+    std::vector<T> elements_;
+
+    /// @brief Mask to map positions to element index
+    const std::size_t mask_;
+
+    /// @brief Position of next element to pop (written by consumer only)
+    alignas(kCacheLineSize) std::atomic<std::size_t> head_;
+
+    /// @brief Position of next element to push (written by producer only)
+    alignas(kCacheLineSize) std::atomic<std::size_t> tail_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_SPSC_RING_BUFFER_H_
@@ -0,0 +1,39 @@
+///
+/// @file string_dictionary.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/string_dictionary.h"
+#include "flight_management/logging.h"
+
+namespace fms
+{
+StringId StringDictionary::Intern(const std::string& value)
+{
+    const auto it = ids_.find(value);
+    if (it != ids_.end())
+    {
+        return it->second;
+    }
+
+    ASSERT_CHECK(strings_.size() < kInvalidStringId) << "String dictionary is full";
+    const auto id = static_cast<StringId>(strings_.size());
+    strings_.push_back(value);
+    ids_.emplace(value, id);
+    return id;
+}
+
+StringId StringDictionary::Find(const std::string& value) const
+{
+    const auto it = ids_.find(value);
+    return (it == ids_.end()) ? kInvalidStringId : it->second;
+}
+
+const std::string& StringDictionary::Lookup(const StringId id) const
+{
+    ASSERT_CHECK(id < strings_.size()) << "Unknown string id {" << id << "}";
+    return strings_[id];
+}
+
+std::size_t StringDictionary::Size() const { return strings_.size(); }
+
+}  // namespace fms
@@ -0,0 +1,60 @@
+///
+/// @file string_dictionary.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_STRING_DICTIONARY_H_
+#define FLIGHT_MANAGEMENT_STRING_DICTIONARY_H_
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fms
+{
+/// @brief Identifier of an interned string
+using StringId = std::uint32_t;
+
+/// @brief Identifier returned for strings which are not interned
+constexpr StringId kInvalidStringId{std::numeric_limits<StringId>::max()};
+
+/// @brief Interns strings (i.e. city and operator names) and maps them to dense integer identifiers
+class StringDictionary
+{
+  public:
+    /// @brief Intern provided string
+    ///
+    /// @param value[in] - String to intern
+    ///
+    /// @return id - Identifier of the string (same string always yields same identifier)
+    StringId Intern(const std::string& value);
+
+    /// @brief Find identifier of provided string without interning it
+    ///
+    /// @param value[in] - String to search
+    ///
+    /// @return id - Identifier of the string, kInvalidStringId if string was never interned
+    StringId Find(const std::string& value) const;
+
+    /// @brief Get string for provided identifier
+    ///
+    /// @param id[in] - Identifier returned by Intern()
+    ///
+    /// @return value - Interned string
+    const std::string& Lookup(const StringId id) const;
+
+    /// @brief Get number of interned strings
+    std::size_t Size() const;
+
+  private:
+    /// @brief Interned strings, indexed by identifier
+    std::vector<std::string> strings_;
+
+    /// @brief Lookup from string to identifier
+    std::unordered_map<std::string, StringId> ids_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_STRING_DICTIONARY_H_
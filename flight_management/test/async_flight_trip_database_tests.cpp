@@ -0,0 +1,142 @@
+///
+/// @file async_flight_trip_database_tests.cpp
+/// @brief Contains unit tests for Async Flight Trip Database.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/async_flight_trip_database.h"
+#include "flight_management/flight_trip_database.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+/// @brief Async Database Test Fixture
+class AsyncFlightTripDatabaseSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        unit_ = std::make_unique<AsyncFlightTripDatabase>(std::make_unique<FlightTripDatabase>());
+        unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4000);
+        unit_->AddTrip("AI-238", "AirIndia", "Mumbai", "Delhi", 3000);
+        ASSERT_EQ(2U, unit_->GetTotalTrips().get());
+    }
+
+    /// @brief Block executor until returned promise is fulfilled
+    std::shared_ptr<std::promise<void>> BlockExecutor()
+    {
+        auto gate = std::make_shared<std::promise<void>>();
+        auto released = gate->get_future().share();
+        unit_->Submit<void>([released](IFlightTripDatabase&) { released.wait(); });
+        return gate;
+    }
+
+    /// @brief Unit under Test
+    std::unique_ptr<AsyncFlightTripDatabase> unit_;
+};
+
+/// @test Test operations are executed in submission order
+TEST_F(AsyncFlightTripDatabaseSpec, GivenPipelinedOperations_WhenAwaited_ExpectSubmissionOrder)
+{
+    auto update = unit_->UpdateFareByTrip("AI-238", 3800);
+    auto trips = unit_->FindFlightByNumber("AI-238");
+    auto max_fare = unit_->FindMaxFareByOperator("AirIndia");
+    auto min_fare = unit_->FindMinFareBetweenCities("Pune", "Delhi");
+    auto average = unit_->FindAverageCostOfAllTrips();
+    auto prefix = unit_->FindFlightsByNumberPrefix("6e");
+
+    update.get();
+    ASSERT_EQ(1U, trips.get().size());
+    EXPECT_DOUBLE_EQ(3800.0, max_fare.get());
+    EXPECT_DOUBLE_EQ(4000.0, min_fare.get());
+    EXPECT_DOUBLE_EQ(3900.0, average.get());
+    EXPECT_EQ(1U, prefix.get().size());
+}
+
+/// @test Test thousands of queries can be in flight at once
+TEST_F(AsyncFlightTripDatabaseSpec, GivenThousandsOfQueriesInFlight_WhenAwaited_ExpectAllResults)
+{
+    std::vector<std::future<std::vector<FlightTrip>>> in_flight;
+    for (auto idx = 0U; idx < 5000U; ++idx)
+    {
+        in_flight.push_back(unit_->FindFlightsByOriginCity((idx % 2U == 0U) ? "Pune" : "Chennai"));
+    }
+
+    for (auto idx = 0U; idx < in_flight.size(); ++idx)
+    {
+        EXPECT_EQ((idx % 2U == 0U) ? 1U : 0U, in_flight[idx].get().size());
+    }
+}
+
+/// @test Test batched lookups return results in request order
+TEST_F(AsyncFlightTripDatabaseSpec, GivenBatchedLookups_WhenAwaited_ExpectResultPerRequest)
+{
+    auto trips = unit_->FindFlightsByNumbers({"AI-238", "SJ-512", "6E-509"}).get();
+    auto min_fares = unit_->FindMinFaresBetweenCities({{"Mumbai", "Delhi"}, {"Pune", "Delhi"}}).get();
+
+    ASSERT_EQ(3U, trips.size());
+    EXPECT_EQ(1U, trips[0].size());
+    EXPECT_TRUE(trips[1].empty());
+    EXPECT_EQ("6E-509", trips[2][0].name);
+    EXPECT_THAT(min_fares, ::testing::ElementsAre(3000.0, 4000.0));
+}
+
+/// @test Test operations cancelled before execution are skipped
+TEST_F(AsyncFlightTripDatabaseSpec, GivenCancelledToken_WhenAwaited_ExpectOperationCancelled)
+{
+    CancellationSource source{};
+    const auto gate = BlockExecutor();
+    auto remove = unit_->RemoveTrip("AI-238", source.GetToken());
+    auto batch = unit_->FindFlightsByNumbers({"AI-238"}, source.GetToken());
+    auto total = unit_->GetTotalTrips();
+
+    source.Cancel();
+    gate->set_value();
+
+    EXPECT_THROW(remove.get(), OperationCancelled);
+    EXPECT_THROW(batch.get(), OperationCancelled);
+    EXPECT_EQ(2U, total.get());
+}
+
+/// @test Test completion callbacks are called in submission order with ready results, cancellations and errors
+TEST_F(AsyncFlightTripDatabaseSpec, GivenCompletionCallbacks_WhenCompleted_ExpectReadyResults)
+{
+    CancellationSource source{};
+    const auto gate = BlockExecutor();
+    std::vector<std::string> completions;
+    unit_->UpdateFareByOperator("Indigo", 4500, [&completions](std::future<void> result) {
+        result.get();
+        completions.push_back("update");
+    });
+    unit_->FindMaxFareByOperator("Indigo", [&completions](std::future<double> result) {
+        completions.push_back("max fare " + std::to_string(static_cast<int>(result.get())));
+    });
+    unit_->FindFlightByNumber(
+        "6E-509",
+        [&completions](std::future<std::vector<FlightTrip>> result) {
+            EXPECT_THROW(result.get(), OperationCancelled);
+            completions.push_back("cancelled");
+        },
+        source.GetToken());
+    unit_->Submit<int>([](IFlightTripDatabase&) -> int { throw std::runtime_error{"failed"}; },
+                       [&completions](std::future<int> result) {
+                           EXPECT_THROW(result.get(), std::runtime_error);
+                           completions.push_back("failed");
+                       });
+
+    source.Cancel();
+    gate->set_value();
+    ASSERT_EQ(2U, unit_->GetTotalTrips().get());
+    EXPECT_THAT(completions, ::testing::ElementsAre("update", "max fare 4500", "cancelled", "failed"));
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,154 @@
+///
+/// @file cached_flight_trip_database_tests.cpp
+/// @brief Contains unit tests for Query Cache.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/cached_flight_trip_database.h"
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/lru_cache.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <limits>
+#include <memory>
+
+namespace fms
+{
+namespace
+{
+/// @test Test least recently used entry is evicted when cache is full
+TEST(LruCacheSpec, GivenFullCache_WhenInsert_ExpectLeastRecentlyUsedEvicted)
+{
+    LruCache<std::string, double> unit{2U};
+    unit.Insert("Pune", 1.0);
+    unit.Insert("Mumbai", 2.0);
+    ASSERT_NE(nullptr, unit.Find("Pune"));
+
+    unit.Insert("Delhi", 3.0);
+
+    EXPECT_EQ(2U, unit.Size());
+    EXPECT_EQ(1U, unit.Evictions());
+    EXPECT_EQ(nullptr, unit.Find("Mumbai"));
+    EXPECT_DOUBLE_EQ(1.0, *unit.Find("Pune"));
+    EXPECT_DOUBLE_EQ(3.0, *unit.Find("Delhi"));
+}
+
+/// @test Test zero capacity disables caching
+TEST(LruCacheSpec, GivenZeroCapacity_WhenInsert_ExpectNothingCached)
+{
+    LruCache<std::string, double> unit{0U};
+    unit.Insert("Pune", 1.0);
+
+    EXPECT_EQ(0U, unit.Size());
+    EXPECT_EQ(nullptr, unit.Find("Pune"));
+}
+
+/// @brief Query Cache Test Fixture
+class CachedFlightTripDatabaseSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        unit_ = std::make_unique<CachedFlightTripDatabase>(std::make_unique<FlightTripDatabase>(), 16U);
+        unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4000);
+        unit_->AddTrip("AI-238", "AirIndia", "Mumbai", "Delhi", 3000);
+        unit_->AddTrip("6E-302", "Indigo", "Mumbai", "Bengaluru", 3230);
+        ASSERT_EQ(3U, unit_->GetTotalTrips());
+    }
+
+    /// @brief Unit under Test
+    std::unique_ptr<CachedFlightTripDatabase> unit_;
+};
+
+/// @test Test repeated queries are served from cache
+TEST_F(CachedFlightTripDatabaseSpec, GivenRepeatedQueries_WhenFind_ExpectCacheHits)
+{
+    EXPECT_EQ(1U, unit_->FindFlightsByOriginCity("Pune").size());
+    EXPECT_EQ(1U, unit_->FindFlightsByOriginCity("Pune").size());
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+    EXPECT_DOUBLE_EQ(4000.0, unit_->FindMaxFareByOperator("Indigo"));
+    EXPECT_DOUBLE_EQ(4000.0, unit_->FindMaxFareByOperator("Indigo"));
+
+    const auto statistics = unit_->GetStatistics();
+    EXPECT_EQ(3U, statistics.hits);
+    EXPECT_EQ(3U, statistics.misses);
+    EXPECT_DOUBLE_EQ(0.5, statistics.HitRate());
+}
+
+/// @test Test adding trip invalidates only the entries it touches
+TEST_F(CachedFlightTripDatabaseSpec, GivenCachedQueries_WhenAddTrip_ExpectOnlyTouchedEntriesInvalidated)
+{
+    unit_->FindFlightsByOriginCity("Pune");
+    unit_->FindFlightsByOriginCity("Mumbai");
+    unit_->FindMaxFareByOperator("AirIndia");
+
+    unit_->AddTrip("6E-111", "Indigo", "Pune", "Chennai", 2000);
+
+    EXPECT_EQ(2U, unit_->FindFlightsByOriginCity("Pune").size());
+    EXPECT_EQ(2U, unit_->FindFlightsByOriginCity("Mumbai").size());
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMaxFareByOperator("AirIndia"));
+
+    const auto statistics = unit_->GetStatistics();
+    EXPECT_EQ(1U, statistics.invalidations);
+    EXPECT_EQ(2U, statistics.hits);
+}
+
+/// @test Test trip rejected by underlying database neither invalidates nor counts routes
+TEST_F(CachedFlightTripDatabaseSpec, GivenRejectedTrip_WhenAddTrip_ExpectCacheUntouched)
+{
+    unit_->FindFlightsByOriginCity("Pune");
+
+    unit_->AddTrip("6E-111", "Indigo", "Pune", "Chennai", 2000, 200, 100);
+    unit_->UpdateFareByOperator("AirIndia", 3500);
+
+    EXPECT_EQ(3U, unit_->GetTotalTrips());
+    EXPECT_EQ(1U, unit_->FindFlightsByOriginCity("Pune").size());
+    const auto statistics = unit_->GetStatistics();
+    EXPECT_EQ(0U, statistics.invalidations);
+    EXPECT_EQ(1U, statistics.hits);
+}
+
+/// @test Test removing trip invalidates cached results
+TEST_F(CachedFlightTripDatabaseSpec, GivenCachedQueries_WhenRemoveTrip_ExpectFreshResults)
+{
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMaxFareByOperator("AirIndia"));
+
+    unit_->RemoveTrip("AI-238");
+
+    EXPECT_DOUBLE_EQ(std::numeric_limits<double>::max(), unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+    EXPECT_TRUE(unit_->FindFlightsByOriginCity("Mumbai")[0].name == "6E-302");
+    EXPECT_EQ(2U, unit_->GetStatistics().invalidations);
+}
+
+/// @test Test updating fare by trip invalidates cached results
+TEST_F(CachedFlightTripDatabaseSpec, GivenCachedQueries_WhenUpdateFareByTrip_ExpectFreshResults)
+{
+    EXPECT_DOUBLE_EQ(4000.0, unit_->FindFlightsByOriginCity("Pune")[0].fare);
+    EXPECT_DOUBLE_EQ(4000.0, unit_->FindMaxFareByOperator("Indigo"));
+
+    unit_->UpdateFareByTrip("6E-509", 5000);
+
+    EXPECT_DOUBLE_EQ(5000.0, unit_->FindFlightsByOriginCity("Pune")[0].fare);
+    EXPECT_DOUBLE_EQ(5000.0, unit_->FindMaxFareByOperator("Indigo"));
+    EXPECT_EQ(0U, unit_->GetStatistics().hits);
+}
+
+/// @test Test updating fare by operator invalidates all routes served by the operator
+TEST_F(CachedFlightTripDatabaseSpec, GivenCachedQueries_WhenUpdateFareByOperator_ExpectFreshResults)
+{
+    EXPECT_DOUBLE_EQ(4000.0, unit_->FindMinFareBetweenCities("Pune", "Delhi"));
+    EXPECT_DOUBLE_EQ(3230.0, unit_->FindMinFareBetweenCities("Mumbai", "Bengaluru"));
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+
+    unit_->UpdateFareByOperator("Indigo", 1000);
+
+    EXPECT_DOUBLE_EQ(1000.0, unit_->FindMinFareBetweenCities("Pune", "Delhi"));
+    EXPECT_DOUBLE_EQ(1000.0, unit_->FindMinFareBetweenCities("Mumbai", "Bengaluru"));
+    EXPECT_DOUBLE_EQ(3000.0, unit_->FindMinFareBetweenCities("Mumbai", "Delhi"));
+    EXPECT_EQ(1U, unit_->GetStatistics().hits);
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,287 @@
+///
+/// @file change_data_capture_tests.cpp
+/// @brief Contains unit tests for Change Data Capture.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/change_data_capture.h"
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/spsc_ring_buffer.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+/// @brief Get all trips of database, ordered by all fields
+std::vector<FlightTrip> GetSortedTrips(const FlightTripDatabase& database)
+{
+    auto trips = database.FindFlightsByNumberPrefix("");
+    std::sort(trips.begin(), trips.end(), [](const auto& lhs, const auto& rhs) {
+        return std::tie(lhs.name, lhs.departure_time, lhs.fare, lhs.operated_by, lhs.origin_city,
+                        lhs.destination_city) < std::tie(rhs.name, rhs.departure_time, rhs.fare, rhs.operated_by,
+                                                         rhs.origin_city, rhs.destination_city);
+    });
+    return trips;
+}
+
+/// @brief Expect databases to hold the same trips
+void ExpectSameTrips(const FlightTripDatabase& expected, const FlightTripDatabase& actual)
+{
+    ASSERT_EQ(expected.GetTotalTrips(), actual.GetTotalTrips());
+    const auto expected_trips = GetSortedTrips(expected);
+    const auto actual_trips = GetSortedTrips(actual);
+    ASSERT_EQ(expected_trips.size(), actual_trips.size());
+    for (std::size_t idx = 0U; idx < expected_trips.size(); ++idx)
+    {
+        EXPECT_EQ(expected_trips[idx].name, actual_trips[idx].name);
+        EXPECT_EQ(expected_trips[idx].operated_by, actual_trips[idx].operated_by);
+        EXPECT_EQ(expected_trips[idx].origin_city, actual_trips[idx].origin_city);
+        EXPECT_EQ(expected_trips[idx].destination_city, actual_trips[idx].destination_city);
+        EXPECT_DOUBLE_EQ(expected_trips[idx].fare, actual_trips[idx].fare);
+        EXPECT_EQ(expected_trips[idx].departure_time, actual_trips[idx].departure_time);
+    }
+}
+
+/// @test Test ring buffer rejects push when full and preserves FIFO order
+TEST(SpscRingBufferSpec, GivenFullBuffer_WhenTryPush_ExpectRejected)
+{
+    SpscRingBuffer<int> unit{2U};
+    EXPECT_TRUE(unit.TryPush(1));
+    EXPECT_TRUE(unit.TryPush(2));
+    EXPECT_FALSE(unit.TryPush(3));
+
+    int element = 0;
+    EXPECT_TRUE(unit.TryPop(element));
+    EXPECT_EQ(1, element);
+    EXPECT_TRUE(unit.TryPush(3));
+    EXPECT_TRUE(unit.TryPop(element));
+    EXPECT_EQ(2, element);
+    EXPECT_TRUE(unit.TryPop(element));
+    EXPECT_EQ(3, element);
+    EXPECT_FALSE(unit.TryPop(element));
+}
+
+/// @test Test ring buffer requires power of two capacity
+TEST(SpscRingBufferSpec, GivenNonPowerOfTwoCapacity_WhenConstructed_ExpectAbort)
+{
+    EXPECT_EXIT(SpscRingBuffer<int>{3U}, ::testing::KilledBySignal(SIGABRT), "");
+}
+
+/// @test Test each mutation is published with consecutive sequence numbers
+TEST(ChangeDataCaptureSpec, GivenSubscriber_WhenMutated_ExpectSequencedChangeEvents)
+{
+    FlightTripDatabase unit{};
+    const auto stream = unit.SubscribeToChanges(8U);
+
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+    unit.UpdateFareByTrip("6E-702", 3500);
+    unit.UpdateFareByOperator("Indigo", 4000);
+    unit.RemoveTrip("6E-702");
+
+    ChangeEvent event{};
+    ASSERT_TRUE(stream->TryPop(event));
+    EXPECT_EQ(1U, event.sequence);
+    EXPECT_EQ(ChangeType::kAddTrip, event.type);
+    EXPECT_EQ("Bengaluru", event.trip.destination_city);
+    ASSERT_TRUE(stream->TryPop(event));
+    EXPECT_EQ(2U, event.sequence);
+    EXPECT_EQ(ChangeType::kUpdateFareByTrip, event.type);
+    EXPECT_DOUBLE_EQ(3500.0, event.trip.fare);
+    ASSERT_TRUE(stream->TryPop(event));
+    EXPECT_EQ(3U, event.sequence);
+    EXPECT_EQ(ChangeType::kUpdateFareByOperator, event.type);
+    EXPECT_EQ("Indigo", event.trip.operated_by);
+    ASSERT_TRUE(stream->TryPop(event));
+    EXPECT_EQ(4U, event.sequence);
+    EXPECT_EQ(ChangeType::kRemoveTrip, event.type);
+    EXPECT_FALSE(stream->TryPop(event));
+
+    // Removing a missing trip changes nothing, hence publishes nothing
+    unit.RemoveTrip("6E-702");
+    unit.UpdateFareByOperator("Indigo", 4500);
+    ASSERT_TRUE(stream->TryPop(event));
+    EXPECT_EQ(5U, event.sequence);
+    EXPECT_EQ(ChangeType::kUpdateFareByOperator, event.type);
+}
+
+/// @test Test subscriber which never drains its stream neither blocks the master nor other subscribers
+TEST(ChangeDataCaptureSpec, GivenStalledSubscriber_WhenMutated_ExpectStreamOverflowed)
+{
+    FlightTripDatabase unit{};
+    const auto stalled_stream = unit.SubscribeToChanges(2U);
+    const auto stream = unit.SubscribeToChanges(8U);
+
+    ::testing::internal::CaptureStderr();
+    for (std::size_t idx = 0U; idx < 5U; ++idx)
+    {
+        unit.AddTrip("6E-70" + std::to_string(idx), "Indigo", "Pune", "Bengaluru", 3000);
+    }
+    EXPECT_FALSE(::testing::internal::GetCapturedStderr().empty());
+
+    EXPECT_EQ(5U, unit.GetTotalTrips());
+    EXPECT_TRUE(stalled_stream->IsOverflowed());
+    EXPECT_EQ(3U, stalled_stream->GetDroppedEvents());
+    EXPECT_FALSE(stream->IsOverflowed());
+
+    // Buffered events are kept, no event is delivered after the gap
+    ChangeEvent event{};
+    ASSERT_TRUE(stalled_stream->TryPop(event));
+    EXPECT_EQ(1U, event.sequence);
+    ASSERT_TRUE(stalled_stream->TryPop(event));
+    EXPECT_EQ(2U, event.sequence);
+    unit.AddTrip("6E-705", "Indigo", "Pune", "Bengaluru", 3000);
+    EXPECT_FALSE(stalled_stream->TryPop(event));
+    EXPECT_EQ(4U, stalled_stream->GetDroppedEvents());
+}
+
+/// @test Test mutations of single departures are replicated
+TEST(ReplicaApplierSpec, GivenDepartureMutations_WhenReplicated_ExpectSameDepartures)
+{
+    FlightTripDatabase master{};
+    FlightTripDatabase replica{};
+    ReplicaApplier unit{master.SubscribeToChanges(8U), replica};
+
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000, 100, 200);
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3200, 300, 400);
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3400, 500, 600);
+    master.UpdateFareByTrip("6E-702", 300, 2800);
+    master.RemoveTrip("6E-702", 500);
+    EXPECT_EQ(5U, unit.ApplyPending());
+
+    const auto trips = replica.FindFlightsByOriginCityInTimeWindow("Pune", 0, 1000);
+    ASSERT_EQ(2U, trips.size());
+    EXPECT_DOUBLE_EQ(3000.0, trips[0].fare);
+    EXPECT_DOUBLE_EQ(2800.0, trips[1].fare);
+    EXPECT_EQ(300, trips[1].departure_time);
+}
+
+/// @test Test replica applier reports missing change events and stops applying
+TEST(ReplicaApplierSpec, GivenSequenceGap_WhenApplyPending_ExpectResynchronizationNeeded)
+{
+    FlightTripDatabase replica{};
+    auto stream = std::make_shared<ChangeStream>(4U, 0U);
+    const FlightTrip trip{"6E-702", "Indigo", "Pune", "Delhi", 3000.0};
+    ASSERT_TRUE(stream->TryPush(ChangeEvent{1U, ChangeType::kAddTrip, trip}));
+    ASSERT_TRUE(stream->TryPush(ChangeEvent{3U, ChangeType::kRemoveTrip, trip}));
+    ASSERT_TRUE(stream->TryPush(ChangeEvent{4U, ChangeType::kRemoveTrip, trip}));
+    ReplicaApplier unit{stream, replica};
+
+    ::testing::internal::CaptureStderr();
+    EXPECT_EQ(1U, unit.ApplyPending());
+    EXPECT_FALSE(::testing::internal::GetCapturedStderr().empty());
+    EXPECT_TRUE(unit.NeedsResynchronization());
+    EXPECT_EQ(1U, unit.GetLastAppliedSequence());
+    EXPECT_EQ(0U, unit.ApplyPending());
+    EXPECT_EQ(1U, replica.GetTotalTrips());
+}
+
+/// @test Test replica subscribed after mutations, or resubscribed after an overflow, is bootstrapped from a snapshot
+TEST(ReplicaApplierSpec, GivenOverflowedStream_WhenResubscribedWithSnapshot_ExpectConvergedReplica)
+{
+    FlightTripDatabase master{};
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000, 100, 200);
+    std::vector<FlightTrip> snapshot;
+    auto replica = std::make_unique<FlightTripDatabase>();
+    auto unit = std::make_unique<ReplicaApplier>(master.SubscribeToChanges(4U, snapshot), snapshot, *replica);
+    EXPECT_EQ(1U, unit->GetLastAppliedSequence());
+
+    ::testing::internal::CaptureStderr();
+    for (Timestamp departure_time = 300; departure_time < 1000; departure_time += 100)
+    {
+        master.AddTrip("AI-101", "AirIndia", "Pune", "Delhi", 5000, departure_time, departure_time + 100);
+    }
+    EXPECT_FALSE(::testing::internal::GetCapturedStderr().empty());
+    EXPECT_EQ(4U, unit->ApplyPending());
+    EXPECT_EQ(5U, unit->GetLastAppliedSequence());
+    EXPECT_TRUE(unit->NeedsResynchronization());
+
+    replica = std::make_unique<FlightTripDatabase>();
+    unit = std::make_unique<ReplicaApplier>(master.SubscribeToChanges(4U, snapshot), snapshot, *replica);
+    master.UpdateFareByTrip("AI-101", 700, 5500);
+    master.RemoveTrip("6E-702");
+    EXPECT_EQ(2U, unit->ApplyPending());
+    EXPECT_FALSE(unit->NeedsResynchronization());
+    EXPECT_EQ(master.GetTotalTrips(), 7U);
+    ExpectSameTrips(master, *replica);
+}
+
+/// @test Test master and replica converge under heavy, concurrently replicated mutation workload
+TEST(ReplicaApplierSpec, GivenHeavyMutationWorkload_WhenReplicated_ExpectConvergedDatabases)
+{
+    constexpr std::size_t kNumberOfMutations{100000U};
+    constexpr std::size_t kNumberOfFlights{500U};
+    const std::vector<std::string> operators{"AirIndia", "Indigo", "SpiceJet", "Vistara"};
+    const std::vector<std::string> cities{"Pune", "Delhi", "Mumbai", "Bengaluru", "Chennai"};
+
+    constexpr std::size_t kCapacity{1024U};
+    FlightTripDatabase master{};
+    FlightTripDatabase replica{};
+    const auto stream = master.SubscribeToChanges(kCapacity);
+    ReplicaApplier unit{stream, replica};
+
+    std::atomic<std::uint64_t> applied_sequence{0U};
+    std::atomic<bool> done{false};
+    std::thread replicator{[&]() {
+        while (!done.load())
+        {
+            unit.ApplyPending();
+            applied_sequence.store(unit.GetLastAppliedSequence());
+        }
+        unit.ApplyPending();
+    }};
+
+    std::mt19937 generator{42U};
+    std::uniform_int_distribution<std::size_t> mutation{0U, 9U};
+    std::uniform_int_distribution<std::size_t> flight{0U, kNumberOfFlights - 1U};
+    std::uniform_int_distribution<std::size_t> airline{0U, operators.size() - 1U};
+    std::uniform_int_distribution<std::size_t> city{0U, cities.size() - 1U};
+    std::uniform_real_distribution<double> fare{1000.0, 10000.0};
+    for (std::size_t idx = 0U; idx < kNumberOfMutations; ++idx)
+    {
+        const auto name = "FL-" + std::to_string(flight(generator));
+        const auto selected = mutation(generator);
+        if (selected < 5U)
+        {
+            master.AddTrip(name, operators[airline(generator)], cities[city(generator)], cities[city(generator)],
+                           fare(generator));
+        }
+        else if (selected < 7U)
+        {
+            master.RemoveTrip(name);
+        }
+        else if (selected < 9U)
+        {
+            master.UpdateFareByTrip(name, fare(generator));
+        }
+        else
+        {
+            master.UpdateFareByOperator(operators[airline(generator)], fare(generator));
+        }
+
+        // Keep the master less than a full ring ahead, so that the ring wraps around without overflowing
+        while (master.GetLastChangeSequence() - applied_sequence.load() >= kCapacity / 2U)
+        {
+            std::this_thread::yield();
+        }
+    }
+    done.store(true);
+    replicator.join();
+
+    EXPECT_FALSE(stream->IsOverflowed());
+    EXPECT_FALSE(unit.NeedsResynchronization());
+    EXPECT_GT(master.GetLastChangeSequence(), 50U * kCapacity);
+    ExpectSameTrips(master, replica);
+}
+
+}  // namespace
+}  // namespace fms
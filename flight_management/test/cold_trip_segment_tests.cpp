@@ -0,0 +1,280 @@
+///
+/// @file cold_trip_segment_tests.cpp
+/// @brief Contains unit tests for Cold Trip Segment and its column encodings.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/change_data_capture.h"
+#include "flight_management/cold_trip_segment.h"
+#include "flight_management/dictionary_column.h"
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/frame_of_reference_column.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+/// @brief Number of seconds per day
+constexpr Timestamp kDay{86400};
+
+/// @brief Number of archived days
+constexpr std::size_t kNumberOfDays{4096U};
+
+/// @test Test values are restored and encoded with the smallest byte width fitting their range
+TEST(FrameOfReferenceColumnSpec, GivenValues_WhenEncoded_ExpectRestoredValuesAndNarrowOffsets)
+{
+    const std::vector<std::int64_t> narrow_values{1600000000, 1600000200, 1600000100};
+    const FrameOfReferenceColumn narrow{narrow_values};
+    EXPECT_EQ(1600000000, narrow.Min());
+    EXPECT_EQ(1600000200, narrow.Max());
+    EXPECT_EQ(3U, narrow.GetMemoryUsage());
+    EXPECT_EQ(1600000100, narrow.Get(2U));
+
+    const std::vector<std::int64_t> wide_values{std::numeric_limits<std::int64_t>::min(), 0,
+                                                std::numeric_limits<std::int64_t>::max()};
+    const FrameOfReferenceColumn wide{wide_values};
+    EXPECT_EQ(24U, wide.GetMemoryUsage());
+    for (std::size_t row = 0U; row < wide_values.size(); ++row)
+    {
+        EXPECT_EQ(wide_values[row], wide.Get(row));
+    }
+}
+
+/// @test Test values are restored from sorted distinct values and codes
+TEST(DictionaryColumnSpec, GivenRepeatedValues_WhenEncoded_ExpectDistinctValuesAndCodes)
+{
+    const DictionaryColumn<std::string> unit{{"Pune", "Delhi", "Pune", "Mumbai"}};
+    EXPECT_THAT(unit.GetValues(), ElementsAre("Delhi", "Mumbai", "Pune"));
+    EXPECT_EQ("Pune", unit.Get(2U));
+    EXPECT_EQ(2U, unit.GetCode(0U));
+    EXPECT_EQ(DictionaryColumn<std::string>::kNoCode, unit.Find("Chennai"));
+}
+
+/// @brief Cold Trip Segment Test Fixture
+class ColdTripSegmentSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        // One departure per day on each of two routes, operated by Indigo until day 2000, by Vistara afterwards
+        const std::vector<std::string> operators{"Indigo", "Vistara"};
+        const std::vector<std::string> cities{"Pune", "Delhi", "Mumbai"};
+        std::vector<CompactFlightTrip> trips;
+        for (Timestamp day = 0; day < static_cast<Timestamp>(kNumberOfDays); ++day)
+        {
+            const auto& operated_by = operators[(day < 2000) ? 0U : 1U];
+            const auto fare = 3000.0 + static_cast<double>(day % 100);
+            trips.push_back(ToCompactFlightTrip(
+                FlightTrip{"6E-" + std::to_string(day % 50), operated_by, "Pune", "Delhi", fare, day * kDay,
+                           (day * kDay) + 7200},
+                dictionary_));
+            trips.push_back(ToCompactFlightTrip(
+                FlightTrip{"AI-" + std::to_string(day % 50), operated_by, "Mumbai", "Delhi", fare + 0.25, day * kDay,
+                           (day * kDay) + 7200},
+                dictionary_));
+        }
+        unit_ = std::make_unique<ColdTripSegment>(trips, dictionary_);
+    }
+
+    /// @brief Dictionary for operator and city names
+    StringDictionary dictionary_;
+
+    /// @brief Unit under Test
+    std::unique_ptr<ColdTripSegment> unit_;
+};
+
+/// @test Test archived trips take less memory than their fixed size records
+TEST_F(ColdTripSegmentSpec, GivenArchivedTrips_WhenGetMemoryUsage_ExpectSmallerThanCompactRecords)
+{
+    EXPECT_EQ(2U * kNumberOfDays, unit_->GetTotalTrips());
+    EXPECT_LT(unit_->GetMemoryUsage() * 2U, unit_->GetTotalTrips() * sizeof(CompactFlightTrip));
+}
+
+/// @test Test time window query skips blocks whose departures are outside of the window
+TEST_F(ColdTripSegmentSpec, GivenTimeWindow_WhenFindByOriginCity_ExpectOtherBlocksSkipped)
+{
+    std::vector<FlightTrip> trips;
+    unit_->FindByOriginCity(dictionary_.Find("Pune"), 100 * kDay, 103 * kDay, dictionary_, trips);
+
+    ASSERT_EQ(3U, trips.size());
+    EXPECT_EQ("6E-0", trips[0].name);
+    EXPECT_EQ(100 * kDay, trips[0].departure_time);
+    EXPECT_DOUBLE_EQ(3000.0, trips[0].fare);
+    EXPECT_EQ(1U, unit_->GetStatistics().blocks_scanned);
+    EXPECT_EQ((2U * kNumberOfDays / ColdTripSegment::kBlockSize) - 1U, unit_->GetStatistics().blocks_skipped);
+}
+
+/// @test Test min/max fare queries are exact for fares in minor units and skip blocks via zone map
+TEST_F(ColdTripSegmentSpec, GivenFareQueries_WhenFind_ExpectExactFaresAndSkippedBlocks)
+{
+    const auto max_fare = std::numeric_limits<double>::max();
+    EXPECT_DOUBLE_EQ(3000.25, unit_->FindMinFare(dictionary_.Find("Mumbai"), dictionary_.Find("Delhi"),
+                                                 std::numeric_limits<Timestamp>::min(),
+                                                 std::numeric_limits<Timestamp>::max(), max_fare));
+    EXPECT_DOUBLE_EQ(2999.0, unit_->FindMinFare(dictionary_.Find("Pune"), dictionary_.Find("Delhi"), 0, kDay, 2999.0));
+    EXPECT_DOUBLE_EQ(3099.25, unit_->FindMaxFare(dictionary_.Find("Vistara"), 0.0));
+    EXPECT_GT(unit_->GetStatistics().blocks_skipped, unit_->GetStatistics().blocks_scanned);
+}
+
+/// @test Test removed trips are no longer found nor counted
+TEST_F(ColdTripSegmentSpec, GivenRemovedTrips_WhenFind_ExpectRemovedTripsIgnored)
+{
+    EXPECT_EQ((kNumberOfDays / 50U) + 1U, unit_->Remove("6E-7"));
+    EXPECT_EQ(0U, unit_->Remove("6E-7"));
+
+    std::vector<FlightTrip> trips;
+    unit_->FindByName("6E-7", dictionary_, trips);
+    unit_->FindByNamePrefix("6e-7", dictionary_, trips);
+    EXPECT_TRUE(trips.empty());
+    unit_->FindByOriginCityPrefix("mum", dictionary_, trips);
+    EXPECT_EQ(kNumberOfDays, trips.size());
+    EXPECT_EQ((2U * kNumberOfDays) - ((kNumberOfDays / 50U) + 1U), unit_->GetTotalTrips());
+}
+
+/// @test Test updated fares stay exact, whether or not they are folded back into the fare columns
+TEST_F(ColdTripSegmentSpec, GivenUpdatedFares_WhenFolded_ExpectExactFaresAndBoundedPatches)
+{
+    const auto memory_usage = unit_->GetMemoryUsage();
+    const auto vistara = dictionary_.Find("Vistara");
+    const auto indigo = dictionary_.Find("Indigo");
+    const auto updated_trips = 2U * (kNumberOfDays - 2000U);
+    EXPECT_EQ(updated_trips, unit_->UpdateFaresByOperator(vistara, 2500.0));
+    EXPECT_LT(unit_->GetMemoryUsage(), memory_usage + ((updated_trips / 4U) * sizeof(std::pair<std::size_t, double>)));
+    EXPECT_DOUBLE_EQ(2500.0, unit_->FindMaxFare(vistara, 0.0));
+
+    EXPECT_EQ(4000U, unit_->UpdateFaresByOperator(indigo, 1000.125));
+    EXPECT_EQ(1U, unit_->UpdateFares("6E-7", 7 * kDay, 7 * kDay, 1000.0));
+    EXPECT_DOUBLE_EQ(1000.125, unit_->FindMaxFare(indigo, 0.0));
+    EXPECT_DOUBLE_EQ(1000.0, unit_->FindMinFare(dictionary_.Find("Pune"), dictionary_.Find("Delhi"), 0,
+                                                static_cast<Timestamp>(kNumberOfDays) * kDay, 3000.0));
+    EXPECT_DOUBLE_EQ((3999.0 * 1000.125) + 1000.0 + (static_cast<double>(updated_trips) * 2500.0),
+                     unit_->GetSumOfUnroundedFares());
+}
+
+/// @test Test database queries cover both hot and archived (cold) trips
+TEST(FlightTripDatabaseColdTierSpec, GivenArchivedTrips_WhenQueried_ExpectHotAndColdTrips)
+{
+    FlightTripDatabase unit{};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000, 100, 200);
+    unit.AddTrip("AI-101", "AirIndia", "Pune", "Bengaluru", 5000, 300, 400);
+    unit.AddTrip("6E-703", "Indigo", "Pune", "Bengaluru", 4000, 500, 600);
+    unit.AddTrip("6e-704", "Indigo", "Bengaluru", "Pune", 2000, 700, 800);
+
+    unit.ArchiveTripsDepartedBefore(400);
+    EXPECT_EQ(4U, unit.GetTotalTrips());
+    EXPECT_DOUBLE_EQ(3500.0, unit.FindAverageCostOfAllTrips());
+    EXPECT_DOUBLE_EQ(3000.0, unit.FindMinFareBetweenCities("Pune", "Bengaluru"));
+    EXPECT_DOUBLE_EQ(5000.0, unit.FindMaxFareByOperator("AirIndia"));
+    EXPECT_EQ(1U, unit.FindFlightByNumber("AI-101").size());
+
+    const auto window_trips = unit.FindFlightsByOriginCityInTimeWindow("Pune", 0, 1000);
+    ASSERT_EQ(3U, window_trips.size());
+    EXPECT_EQ("6E-702", window_trips[0].name);
+    EXPECT_EQ("AI-101", window_trips[1].name);
+    EXPECT_EQ("6E-703", window_trips[2].name);
+
+    const auto prefix_trips = unit.FindFlightsByNumberPrefix("6E-");
+    ASSERT_EQ(3U, prefix_trips.size());
+    EXPECT_EQ("6E-702", prefix_trips[0].name);
+    EXPECT_EQ("6E-703", prefix_trips[1].name);
+    EXPECT_EQ("6e-704", prefix_trips[2].name);
+
+    unit.RemoveTrip("6E-702");
+    EXPECT_THAT(unit.FindFlightByNumber("6E-702"), IsEmpty());
+    EXPECT_EQ(3U, unit.GetTotalTrips());
+    EXPECT_GT(unit.GetColdTierStatistics().blocks_scanned, 0U);
+}
+
+/// @test Test indexes of remaining hot trips are consistent after archiving interleaved trips at once
+TEST(FlightTripDatabaseColdTierSpec, GivenInterleavedDepartures_WhenArchived_ExpectConsistentHotIndexes)
+{
+    FlightTripDatabase unit{FareRepresentation::kFixedPoint};
+    for (Timestamp idx = 0; idx < 100; ++idx)
+    {
+        // Odd trips depart late (stay hot) and are added out of departure order
+        const auto departure_time = ((idx % 2) == 0) ? idx : (1000 - idx);
+        unit.AddTrip("6E-" + std::to_string(idx), "Indigo", "Pune", "Bengaluru", 1000.0 + idx, departure_time,
+                     departure_time + 1);
+    }
+
+    unit.ArchiveTripsDepartedBefore(500);
+    EXPECT_EQ(100U, unit.GetTotalTrips());
+    unit.RemoveTrip("6E-1");
+    unit.RemoveTrip("6E-2");
+    EXPECT_THAT(unit.FindFlightByNumber("6E-1"), IsEmpty());
+    EXPECT_DOUBLE_EQ(1097.0, unit.FindFlightByNumber("6E-97").at(0U).fare);
+    EXPECT_EQ(11U, unit.FindFlightsByNumberPrefix("6E-9").size());
+
+    const auto window_trips = unit.FindFlightsByOriginCityInTimeWindow("Pune", 900, 1000);
+    ASSERT_EQ(49U, window_trips.size());
+    EXPECT_EQ("6E-99", window_trips.front().name);
+    EXPECT_EQ("6E-3", window_trips.back().name);
+    EXPECT_DOUBLE_EQ(1003.0, unit.FindMinFareBetweenCitiesInTimeWindow("Pune", "Bengaluru", 500, 1000));
+    EXPECT_DOUBLE_EQ(1099.0, unit.FindMaxFareByOperator("Indigo"));
+}
+
+/// @test Test archived fares are kept exactly, also when not in minor units or updated after archiving
+TEST(FlightTripDatabaseColdTierSpec, GivenArchivedFares_WhenUpdated_ExpectExactFares)
+{
+    FlightTripDatabase unit{};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000.125, 100, 200);
+    unit.AddTrip("AI-101", "AirIndia", "Pune", "Bengaluru", 5000, 300, 400);
+    unit.ArchiveTripsDepartedBefore(1000);
+
+    EXPECT_DOUBLE_EQ(3000.125, unit.FindFlightByNumber("6E-702").at(0U).fare);
+    EXPECT_DOUBLE_EQ(4000.0625, unit.FindAverageCostOfAllTrips());
+
+    unit.UpdateFareByOperator("Indigo", 2000.5);
+    unit.UpdateFareByTrip("AI-101", 300, 1000.001);
+    EXPECT_DOUBLE_EQ(2000.5, unit.FindFlightByNumber("6E-702").at(0U).fare);
+    EXPECT_DOUBLE_EQ(1000.001, unit.FindMinFareBetweenCities("Pune", "Bengaluru"));
+    EXPECT_DOUBLE_EQ(1000.001, unit.FindMaxFareByOperator("AirIndia"));
+    EXPECT_DOUBLE_EQ(1500.2505, unit.FindAverageCostOfAllTrips());
+}
+
+/// @test Test master and replica hold the same trips, whether or not the master archived them
+TEST(FlightTripDatabaseColdTierSpec, GivenArchivingMaster_WhenReplicated_ExpectSameTrips)
+{
+    FlightTripDatabase master{};
+    FlightTripDatabase replica{};
+    ReplicaApplier unit{master.SubscribeToChanges(16U), replica};
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000.125, 100, 200);
+    master.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3100, 1100, 1200);
+    master.AddTrip("AI-101", "AirIndia", "Pune", "Delhi", 5000, 300, 400);
+    master.AddTrip("SG-301", "SpiceJet", "Delhi", "Pune", 4000, 500, 600);
+
+    master.ArchiveTripsDepartedBefore(1000);
+    master.UpdateFareByOperator("Indigo", 1000);
+    master.UpdateFareByTrip("AI-101", 4500.75);
+    master.UpdateFareByTrip("6E-702", 100, 900);
+    master.RemoveTrip("SG-301");
+    unit.ApplyPending();
+
+    ASSERT_EQ(master.GetTotalTrips(), replica.GetTotalTrips());
+    const auto expected_trips = master.Query().OrderBy(TripField::kName).OrderBy(TripField::kDepartureTime).ToVector();
+    const auto actual_trips = replica.Query().OrderBy(TripField::kName).OrderBy(TripField::kDepartureTime).ToVector();
+    ASSERT_EQ(3U, actual_trips.size());
+    for (std::size_t idx = 0U; idx < expected_trips.size(); ++idx)
+    {
+        EXPECT_EQ(expected_trips[idx].name, actual_trips[idx].name);
+        EXPECT_EQ(expected_trips[idx].departure_time, actual_trips[idx].departure_time);
+        EXPECT_DOUBLE_EQ(expected_trips[idx].fare, actual_trips[idx].fare);
+    }
+    EXPECT_DOUBLE_EQ(master.FindAverageCostOfAllTrips(), replica.FindAverageCostOfAllTrips());
+    EXPECT_DOUBLE_EQ(master.FindMinFareBetweenCities("Pune", "Bengaluru"),
+                     replica.FindMinFareBetweenCities("Pune", "Bengaluru"));
+    EXPECT_DOUBLE_EQ(900.0, master.FindMinFareBetweenCities("Pune", "Bengaluru"));
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,93 @@
+///
+/// @file compact_flight_trip_tests.cpp
+/// @brief Contains unit tests for Compact Flight Trip record.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/compact_flight_trip.h"
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/string_dictionary.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstring>
+
+namespace fms
+{
+namespace
+{
+/// @test Test interning same string yields same identifier
+TEST(StringDictionarySpec, GivenSameString_WhenIntern_ExpectSameId)
+{
+    StringDictionary unit{};
+    const auto pune = unit.Intern("Pune");
+    const auto delhi = unit.Intern("Delhi");
+
+    EXPECT_EQ(pune, unit.Intern("Pune"));
+    EXPECT_NE(pune, delhi);
+    EXPECT_EQ(2U, unit.Size());
+    EXPECT_EQ("Delhi", unit.Lookup(delhi));
+}
+
+/// @test Test finding string which was never interned
+TEST(StringDictionarySpec, GivenUnknownString_WhenFind_ExpectInvalidId)
+{
+    StringDictionary unit{};
+    unit.Intern("Pune");
+
+    EXPECT_EQ(kInvalidStringId, unit.Find("Delhi"));
+    EXPECT_EQ(0U, unit.Find("Pune"));
+}
+
+/// @test Test inline string comparison
+TEST(InlineStringSpec, GivenInlineString_WhenCompared_ExpectExactMatch)
+{
+    const auto unit = FlightName::FromString("6E-702");
+
+    EXPECT_TRUE(unit == "6E-702");
+    EXPECT_TRUE(unit != "6E-70");
+    EXPECT_TRUE(unit != "6E-7020");
+    EXPECT_EQ("6E-702", unit.ToString());
+    EXPECT_FALSE(FlightName::Fits("AI-123456789"));
+}
+
+/// @test Test round trip conversion between FlightTrip and CompactFlightTrip
+TEST(CompactFlightTripSpec, GivenFlightTrip_WhenConvertedBackAndForth_ExpectSameTrip)
+{
+    StringDictionary dictionary{};
+    const FlightTrip trip{"6E-702", "Indigo", "Pune", "Bengaluru", 3000.0};
+
+    const auto unit = ToCompactFlightTrip(trip, dictionary);
+    CompactFlightTrip copy{};
+    std::memcpy(&copy, &unit, sizeof(CompactFlightTrip));
+    const auto result = ToFlightTrip(copy, dictionary);
+
+    EXPECT_EQ(trip.name, result.name);
+    EXPECT_EQ(trip.operated_by, result.operated_by);
+    EXPECT_EQ(trip.origin_city, result.origin_city);
+    EXPECT_EQ(trip.destination_city, result.destination_city);
+    EXPECT_DOUBLE_EQ(trip.fare, result.fare);
+}
+
+/// @test Test flight names which do not fit inline are interned and behave like inline names
+TEST(CompactFlightTripSpec, GivenLongFlightName_WhenAddTrip_ExpectTripStoredOutOfLine)
+{
+    FlightTripDatabase unit{};
+    unit.AddTrip("AI-123456789", "AirIndia", "Pune", "Delhi", 4000);
+    unit.AddTrip("AI-12345678", "AirIndia", "Pune", "Delhi", 4500);
+    unit.ArchiveTripsDepartedBefore(1);
+    unit.AddTrip("AI-1234567890", "AirIndia", "Delhi", "Pune", 5000, 100, 200);
+
+    EXPECT_EQ(3U, unit.GetTotalTrips());
+    ASSERT_EQ(1U, unit.FindFlightByNumber("AI-123456789").size());
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindFlightByNumber("AI-123456789")[0].fare);
+    EXPECT_EQ("AI-1234567890", unit.FindFlightByNumber("AI-1234567890")[0].name);
+    EXPECT_EQ(3U, unit.FindFlightsByNumberPrefix("ai-1234").size());
+
+    unit.UpdateFareByTrip("AI-1234567890", 5500);
+    unit.RemoveTrip("AI-123456789");
+    EXPECT_EQ(2U, unit.GetTotalTrips());
+    EXPECT_DOUBLE_EQ(5500.0, unit.FindFlightByNumber("AI-1234567890")[0].fare);
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,151 @@
+///
+/// @file fare_kernels_tests.cpp
+/// @brief Contains unit tests for fixed-point fares and their kernels.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/fare.h"
+#include "flight_management/fare_kernels.h"
+#include "flight_management/flight_trip_database.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+/// @test Test fares are rounded to nearest minor currency unit
+TEST(FareSpec, GivenFare_WhenConvertedToFixedPoint_ExpectRoundedMinorUnits)
+{
+    EXPECT_EQ(320050, ToFixedPointFare(3200.5));
+    EXPECT_EQ(10, ToFixedPointFare(0.1));
+    EXPECT_EQ(1, ToFixedPointFare(0.005));
+    EXPECT_EQ(-250, ToFixedPointFare(-2.5));
+    EXPECT_DOUBLE_EQ(3200.5, ToFare(320050));
+}
+
+/// @test Test fares which llround cannot convert saturate instead
+TEST(FareSpec, GivenNonFiniteOrHugeFare_WhenConvertedToFixedPoint_ExpectSaturatedFare)
+{
+    EXPECT_EQ(0, ToFixedPointFare(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_EQ(std::numeric_limits<FixedPointFare>::max(), ToFixedPointFare(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ(std::numeric_limits<FixedPointFare>::min(), ToFixedPointFare(-1e300));
+    EXPECT_TRUE(IsFixedPointFare(1e16));
+    EXPECT_FALSE(IsFixedPointFare(1e17));
+    EXPECT_FALSE(IsFixedPointFare(std::numeric_limits<double>::quiet_NaN()));
+    EXPECT_FALSE(IsFixedPointFare(-std::numeric_limits<double>::infinity()));
+}
+
+/// @test Test min/max kernels find extremes, also for tails not filling a vector register
+TEST(FareKernelsSpec, GivenFares_WhenFindMinMaxFare_ExpectExtremes)
+{
+    const std::vector<FixedPointFare> fares{300, -5, 700, 100, 900, 20, 35};
+    EXPECT_EQ(-5, FindMinFare(fares.data(), fares.size()));
+    EXPECT_EQ(900, FindMaxFare(fares.data(), fares.size()));
+    EXPECT_EQ(std::numeric_limits<FixedPointFare>::max(), FindMinFare(fares.data(), 0U));
+    EXPECT_EQ(std::numeric_limits<FixedPointFare>::min(), FindMaxFare(fares.data(), 0U));
+}
+
+/// @test Test masked max kernel only considers fares of provided key
+TEST(FareKernelsSpec, GivenKeyedFares_WhenFindMaxFareOfKey_ExpectExtremeOfKey)
+{
+    const std::vector<FixedPointFare> fares{300, -5, 700, 100, 900, 20, 35};
+    const std::vector<std::uint32_t> keys{1U, 2U, 1U, 2U, 3U, 2U, 1U};
+    EXPECT_EQ(700, FindMaxFareOfKey(fares.data(), keys.data(), 1U, fares.size()));
+    EXPECT_EQ(100, FindMaxFareOfKey(fares.data(), keys.data(), 2U, fares.size()));
+    EXPECT_EQ(std::numeric_limits<FixedPointFare>::min(),
+              FindMaxFareOfKey(fares.data(), keys.data(), 4U, fares.size()));
+}
+
+/// @test Test sum kernel is exact even if sum exceeds range of FixedPointFare
+TEST(FareKernelsSpec, GivenLargeFares_WhenSumFares_ExpectNoOverflow)
+{
+    const auto min_fare = std::numeric_limits<FixedPointFare>::min();
+    const auto max_fare = std::numeric_limits<FixedPointFare>::max();
+    const std::vector<FixedPointFare> fares{max_fare, max_fare, max_fare, -1, min_fare};
+
+    const auto expected = (FixedPointFareSum{max_fare} * 3) - 1 + min_fare;
+    EXPECT_TRUE(expected == SumFares(fares.data(), fares.size()));
+    EXPECT_TRUE(FixedPointFareSum{0} == SumFares(fares.data(), 0U));
+}
+
+/// @test Test average of fixed-point fares is exact where double accumulation drifts
+TEST(FlightTripDatabaseFixedPointSpec, GivenManyFares_WhenFindAverageCost_ExpectNoRoundingDrift)
+{
+    constexpr std::size_t kNumberOfTrips{100000U};
+    FlightTripDatabase fixed_point{FareRepresentation::kFixedPoint};
+    FlightTripDatabase floating_point{FareRepresentation::kFloatingPoint};
+    for (std::size_t idx = 0U; idx < kNumberOfTrips; ++idx)
+    {
+        const auto name = "FL-" + std::to_string(idx);
+        const auto fare = (idx % 2U == 0U) ? 0.1 : 1000000.2;
+        fixed_point.AddTrip(name, "Indigo", "Pune", "Delhi", fare);
+        floating_point.AddTrip(name, "Indigo", "Pune", "Delhi", fare);
+    }
+
+    EXPECT_EQ(500000.15, fixed_point.FindAverageCostOfAllTrips());
+    EXPECT_NE(500000.15, floating_point.FindAverageCostOfAllTrips());
+    EXPECT_NEAR(500000.15, floating_point.FindAverageCostOfAllTrips(), 1e-3);
+}
+
+/// @test Test fixed-point fares are converted at API boundary and kept up to date by mutations
+TEST(FlightTripDatabaseFixedPointSpec, GivenMutatedFares_WhenQueried_ExpectRoundedFares)
+{
+    FlightTripDatabase unit{FareRepresentation::kFixedPoint};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000.004);
+    unit.AddTrip("6E-703", "Indigo", "Pune", "Delhi", 4000);
+    unit.AddTrip("AI-101", "AirIndia", "Pune", "Delhi", 5000);
+
+    EXPECT_DOUBLE_EQ(3000.0, unit.FindFlightByNumber("6E-702").at(0U).fare);
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindMaxFareByOperator("Indigo"));
+    EXPECT_DOUBLE_EQ(std::numeric_limits<double>::min(), unit.FindMaxFareByOperator("Vistara"));
+
+    unit.UpdateFareByTrip("6E-702", 4500.125);
+    EXPECT_DOUBLE_EQ(4500.13, unit.FindMaxFareByOperator("Indigo"));
+    unit.RemoveTrip("6E-702");
+    unit.UpdateFareByOperator("AirIndia", 1000);
+    EXPECT_DOUBLE_EQ(1000.0, unit.FindMinFareBetweenCities("Pune", "Delhi"));
+    EXPECT_DOUBLE_EQ(2500.0, unit.FindAverageCostOfAllTrips());
+}
+
+/// @test Test fares out of fixed-point range are rejected instead of being stored saturated
+TEST(FlightTripDatabaseFixedPointSpec, GivenOutOfRangeFares_WhenMutated_ExpectRejected)
+{
+    FlightTripDatabase unit{FareRepresentation::kFixedPoint};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+    unit.AddTrip("6E-703", "Indigo", "Pune", "Delhi", std::numeric_limits<double>::quiet_NaN());
+    unit.UpdateFareByTrip("6E-702", std::numeric_limits<double>::infinity());
+    unit.UpdateFareByOperator("Indigo", 1e300);
+
+    EXPECT_EQ(1U, unit.GetTotalTrips());
+    EXPECT_DOUBLE_EQ(3000.0, unit.FindMaxFareByOperator("Indigo"));
+}
+
+/// @test Test max fare of operator is found after trips of other operators have been moved into removed slots
+TEST(FlightTripDatabaseFixedPointSpec, GivenRemovedAndArchivedTrips_WhenFindMaxFareByOperator_ExpectOperatorFare)
+{
+    FlightTripDatabase unit{FareRepresentation::kFixedPoint};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 9000, 100, 200);
+    unit.AddTrip("AI-101", "AirIndia", "Pune", "Delhi", 5000, 300, 400);
+    unit.AddTrip("6E-703", "Indigo", "Pune", "Delhi", 4000, 500, 600);
+    unit.AddTrip("AI-102", "AirIndia", "Pune", "Delhi", 7000, 700, 800);
+
+    unit.RemoveTrip("6E-702");
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindMaxFareByOperator("Indigo"));
+    EXPECT_DOUBLE_EQ(7000.0, unit.FindMaxFareByOperator("AirIndia"));
+    unit.ArchiveTripsDepartedBefore(600);
+    unit.AddTrip("AI-103", "AirIndia", "Pune", "Delhi", 6000, 900, 1000);
+    EXPECT_DOUBLE_EQ(7000.0, unit.FindMaxFareByOperator("AirIndia"));
+    unit.RemoveTrip("AI-102");
+    EXPECT_DOUBLE_EQ(6000.0, unit.FindMaxFareByOperator("AirIndia"));
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindMaxFareByOperator("Indigo"));
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindMinFareBetweenCitiesInTimeWindow("Pune", "Delhi", 0, 1000));
+    EXPECT_DOUBLE_EQ(6000.0, unit.FindMinFareBetweenCitiesInTimeWindow("Pune", "Delhi", 600, 1000));
+}
+
+}  // namespace
+}  // namespace fms
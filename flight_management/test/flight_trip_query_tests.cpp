@@ -0,0 +1,247 @@
+///
+/// @file flight_trip_query_tests.cpp
+/// @brief Contains unit tests for composed queries (Flight Trip Query and its execution).
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/cached_flight_trip_database.h"
+#include "flight_management/cold_trip_segment.h"
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/flight_trip_query.h"
+#include "flight_management/remote_flight_trip_database.h"
+#include "flight_management/rpc_server.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+/// @brief Get flight names of provided trips
+std::vector<std::string> Names(const std::vector<FlightTrip>& trips)
+{
+    std::vector<std::string> names;
+    std::transform(trips.begin(), trips.end(), std::back_inserter(names), [](const auto& trip) { return trip.name; });
+    return names;
+}
+
+/// @brief Execute query by filtering, ordering and limiting all trips of the database (reference implementation)
+std::vector<FlightTrip> ExecuteByFiltering(const IFlightTripDatabase& database, const FlightTripQuery& query)
+{
+    auto trips = database.FindFlightsByNumberPrefix("");
+    const auto& filter = query.GetFilter();
+    trips.erase(std::remove_if(trips.begin(), trips.end(),
+                               [&filter](const auto& trip) { return filter.matches_nothing || !filter.Matches(trip); }),
+                trips.end());
+    std::stable_sort(trips.begin(), trips.end(),
+                     [&query](const auto& lhs, const auto& rhs) { return query.IsOrderedBefore(lhs, rhs); });
+    trips.resize(std::min(trips.size(), query.GetLimit()));
+    return trips;
+}
+
+/// @brief Flight Trip Query Test Fixture
+class FlightTripQuerySpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        unit_.AddTrip("6E-2131", "Indigo", "Bengaluru", "Pune", 3000.0, 100, 200);
+        unit_.AddTrip("6E-0202", "Indigo", "Bengaluru", "Delhi", 4500.0, 200, 300);
+        unit_.AddTrip("SG-0345", "SpiceJet", "Bengaluru", "Pune", 2500.0, 300, 400);
+        unit_.AddTrip("AI-0101", "AirIndia", "Pune", "Delhi", 6000.0, 400, 500);
+        unit_.AddTrip("6E-7777", "Indigo", "Pune", "Bengaluru", 2000.0, 500, 600);
+        unit_.AddTrip("6E-2132", "Indigo", "Bengaluru", "Pune", 5500.0, 600, 700);
+    }
+
+    /// @brief Unit under Test
+    FlightTripDatabase unit_;
+};
+
+/// @test Test combined predicates are served from the most selective index
+TEST_F(FlightTripQuerySpec, GivenCombinedPredicates_WhenExecuted_ExpectMatchesFromMostSelectiveIndex)
+{
+    auto query = unit_.Query().WhereOperatedBy("Indigo").WhereOriginCity("Bengaluru").WhereFareBelow(5000.0);
+
+    EXPECT_THAT(Names(query.ToVector()), ElementsAre("6E-2131", "6E-0202"));
+    const auto plan = unit_.ExplainQuery(query);
+    EXPECT_EQ(QueryAccessPath::kOriginCitySchedule, plan.access_path);
+    EXPECT_EQ(4U, plan.candidates);
+}
+
+/// @test Test access path is chosen by number of candidates
+TEST_F(FlightTripQuerySpec, GivenPredicates_WhenExplained_ExpectAccessPathWithFewestCandidates)
+{
+    EXPECT_EQ(QueryAccessPath::kNameIndex,
+              unit_.ExplainQuery(unit_.Query().WhereName("AI-0101").WhereOriginCity("Pune")).access_path);
+    EXPECT_EQ(QueryAccessPath::kRouteSchedule,
+              unit_.ExplainQuery(unit_.Query().WhereOriginCity("Bengaluru").WhereDestinationCity("Pune")).access_path);
+    EXPECT_EQ(QueryAccessPath::kNamePrefixIndex, unit_.ExplainQuery(unit_.Query().WhereNamePrefix("sg")).access_path);
+    EXPECT_EQ(QueryAccessPath::kFullScan, unit_.ExplainQuery(unit_.Query().WhereOperatedBy("Indigo")).access_path);
+    EXPECT_EQ(QueryAccessPath::kNone, unit_.ExplainQuery(unit_.Query().WhereOriginCity("Chennai")).access_path);
+    EXPECT_EQ(QueryAccessPath::kNone,
+              unit_.ExplainQuery(unit_.Query().WhereName("AI-0101").WhereName("SG-0345")).access_path);
+
+    const auto window = unit_.ExplainQuery(unit_.Query().WhereOriginCity("Bengaluru").WhereDepartureBetween(150, 350));
+    EXPECT_EQ(QueryAccessPath::kOriginCitySchedule, window.access_path);
+    EXPECT_EQ(2U, window.candidates);
+}
+
+/// @test Test results are ordered and limited
+TEST_F(FlightTripQuerySpec, GivenOrderAndLimit_WhenExecuted_ExpectTopResults)
+{
+    EXPECT_THAT(Names(unit_.Query().OrderBy(TripField::kFare, true).Limit(3U).ToVector()),
+                ElementsAre("AI-0101", "6E-2132", "6E-0202"));
+    EXPECT_THAT(Names(unit_.Query()
+                          .WhereOperatedBy("Indigo")
+                          .OrderBy(TripField::kDestinationCity)
+                          .OrderBy(TripField::kFare, true)
+                          .ToVector()),
+                ElementsAre("6E-7777", "6E-0202", "6E-2132", "6E-2131"));
+    EXPECT_THAT(unit_.Query().Limit(0U).ToVector(), IsEmpty());
+}
+
+/// @test Test ascending departure order is taken from schedule index without sorting
+TEST_F(FlightTripQuerySpec, GivenDepartureOrderOnSchedule_WhenExecuted_ExpectIndexOrder)
+{
+    auto query = unit_.Query().WhereOriginCity("Bengaluru").OrderBy(TripField::kDepartureTime).Limit(3U);
+
+    EXPECT_TRUE(unit_.ExplainQuery(query).is_ordered);
+    EXPECT_THAT(Names(query.ToVector()), ElementsAre("6E-2131", "6E-0202", "SG-0345"));
+    EXPECT_FALSE(unit_.ExplainQuery(query.OrderBy(TripField::kFare)).is_ordered);
+}
+
+/// @test Test projection leaves unselected fields default
+TEST_F(FlightTripQuerySpec, GivenSelectedFields_WhenExecuted_ExpectOnlySelectedFields)
+{
+    const auto trips = unit_.Query().WhereName("AI-0101").Select({TripField::kName, TripField::kFare}).ToVector();
+
+    ASSERT_EQ(1U, trips.size());
+    EXPECT_EQ("AI-0101", trips[0].name);
+    EXPECT_DOUBLE_EQ(6000.0, trips[0].fare);
+    EXPECT_TRUE(trips[0].operated_by.empty());
+    EXPECT_TRUE(trips[0].origin_city.empty());
+    EXPECT_EQ(0, trips[0].departure_time);
+}
+
+/// @test Test custom predicates and early stop of streamed results
+TEST_F(FlightTripQuerySpec, GivenCustomPredicate_WhenStreamed_ExpectConsumerStopsQuery)
+{
+    auto query = unit_.Query().Where([](const FlightTrip& trip) { return trip.destination_city != "Delhi"; });
+    EXPECT_EQ(4U, query.ToVector().size());
+
+    std::vector<FlightTrip> consumed;
+    EXPECT_EQ(2U, query.ForEach([&consumed](const FlightTrip& trip) {
+        consumed.push_back(trip);
+        return consumed.size() < 2U;
+    }));
+    EXPECT_EQ(2U, consumed.size());
+}
+
+/// @test Test archived trips are merged in query order
+TEST_F(FlightTripQuerySpec, GivenArchivedTrips_WhenExecuted_ExpectMergedResults)
+{
+    unit_.ArchiveTripsDepartedBefore(350);
+
+    EXPECT_THAT(Names(unit_.Query().WhereOriginCity("Bengaluru").OrderBy(TripField::kDepartureTime).ToVector()),
+                ElementsAre("6E-2131", "6E-0202", "SG-0345", "6E-2132"));
+    EXPECT_THAT(Names(unit_.Query().OrderBy(TripField::kFare).Limit(4U).ToVector()),
+                ElementsAre("6E-7777", "SG-0345", "6E-2131", "6E-0202"));
+    EXPECT_THAT(
+        Names(unit_.Query().WhereOperatedBy("Indigo").WhereFareBelow(4000.0).OrderBy(TripField::kName).ToVector()),
+        ElementsAre("6E-2131", "6E-7777"));
+}
+
+/// @test Test limited queries stream hot and then cold trips, decoding no more cold trips than they return
+TEST_F(FlightTripQuerySpec, GivenArchivedTrips_WhenLimited_ExpectOnlyNeededCandidatesVisited)
+{
+    for (std::size_t idx = 0U; idx < 3U * ColdTripSegment::kBlockSize; ++idx)
+    {
+        const auto departure_time = -static_cast<Timestamp>(idx);
+        unit_.AddTrip("UK-" + std::to_string(idx), "Vistara", "Chennai", "Goa", 1000.0 + static_cast<double>(idx),
+                      departure_time, departure_time + 100);
+    }
+    unit_.ArchiveTripsDepartedBefore(350);
+
+    EXPECT_EQ(2U, unit_.Query().Limit(2U).ToVector().size());
+    EXPECT_EQ(0U, unit_.GetColdTierStatistics().blocks_scanned);
+    EXPECT_EQ(0U, unit_.GetColdTierStatistics().trips_decoded);
+
+    EXPECT_EQ(1U, unit_.Query().WhereOperatedBy("Vistara").Limit(1U).ToVector().size());
+    EXPECT_EQ(1U, unit_.GetColdTierStatistics().blocks_scanned);
+    EXPECT_EQ(1U, unit_.GetColdTierStatistics().trips_decoded);
+
+    std::size_t consumed{0U};
+    unit_.Query().WhereOperatedBy("Vistara").ForEach([&consumed](const FlightTrip&) { return ++consumed < 5U; });
+    EXPECT_EQ(5U, consumed);
+    EXPECT_EQ(6U, unit_.GetColdTierStatistics().trips_decoded);
+
+    EXPECT_THAT(Names(unit_.Query().WhereOperatedBy("Vistara").OrderBy(TripField::kFare).Limit(2U).ToVector()),
+                ElementsAre("UK-0", "UK-1"));
+}
+
+/// @test Test queries give the same results on every database implementation and with plain filtering
+TEST(FlightTripQueryConsistencySpec, GivenQueries_WhenExecutedEverywhere_ExpectSameResults)
+{
+    FlightTripDatabase database;
+    CachedFlightTripDatabase cached_database{std::make_unique<FlightTripDatabase>(), 16U};
+    auto served_database = std::make_unique<FlightTripDatabase>();
+    for (std::size_t idx = 0U; idx < 3000U; ++idx)
+    {
+        const auto departure_time = static_cast<Timestamp>(idx) * 60;
+        for (auto* unit : std::vector<IFlightTripDatabase*>{&database, &cached_database, served_database.get()})
+        {
+            unit->AddTrip("FL-" + std::to_string(idx), "Operator-" + std::to_string(idx % 7U),
+                          "City-" + std::to_string(idx % 13U), "City-" + std::to_string(idx % 11U),
+                          1000.0 + static_cast<double>((idx * 37U) % 5000U), departure_time, departure_time + 3600);
+        }
+    }
+    database.ArchiveTripsDepartedBefore(1000 * 60);
+    served_database->ArchiveTripsDepartedBefore(1000 * 60);
+    const std::string endpoint{"unix:/tmp/flight_management_query_tests_" + std::to_string(::getpid()) + ".sock"};
+    RpcServer server{std::move(served_database), endpoint, 1U};
+    ASSERT_TRUE(server.Start());
+    RemoteFlightTripDatabase remote_database{endpoint};
+
+    const std::vector<FlightTripQuery> queries{
+        database.Query().WhereOperatedBy("Operator-3").WhereOriginCity("City-5").WhereFareBelow(4000.0),
+        database.Query().WhereOriginCity("City-1").WhereDestinationCity("City-2").OrderBy(TripField::kFare, true),
+        database.Query().WhereNamePrefix("fl-12").WhereDepartureBetween(0, 2000 * 60).OrderBy(TripField::kFare),
+        database.Query().WhereFareBetween(2000.0, 2100.0).OrderBy(TripField::kDepartureTime, true).Limit(25U),
+        database.Query().WhereOriginCity("City-4").OrderBy(TripField::kDepartureTime).Limit(100U),
+        database.Query().WhereName("FL-42"),
+        database.Query().WhereOperatedBy("Operator-2").OrderBy(TripField::kFare).Limit(10U),
+        database.Query()
+            .WhereDestinationCity("City-3")
+            .Where([](const FlightTrip& trip) { return trip.departure_time % 120 == 0; })
+            .Limit(40U)};
+    for (const auto& query : queries)
+    {
+        // Order by unique name last, so that results are fully ordered
+        auto ordered_query = query;
+        ordered_query.OrderBy(TripField::kName);
+        const auto expected = Names(ordered_query.ToVector());
+        EXPECT_FALSE(expected.empty());
+
+        EXPECT_EQ(expected, Names(ExecuteByFiltering(database, ordered_query)));
+        for (const auto* unit : std::vector<const IFlightTripDatabase*>{&cached_database, &remote_database})
+        {
+            std::vector<FlightTrip> trips;
+            unit->Execute(ordered_query, [&trips](const FlightTrip& trip) {
+                trips.push_back(trip);
+                return true;
+            });
+            EXPECT_EQ(expected, Names(trips));
+        }
+    }
+}
+
+}  // namespace
+}  // namespace fms
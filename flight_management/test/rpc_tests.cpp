@@ -0,0 +1,460 @@
+///
+/// @file rpc_tests.cpp
+/// @brief Contains unit tests for RPC protocol, server and client.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/remote_flight_trip_database.h"
+#include "flight_management/rpc_client.h"
+#include "flight_management/rpc_protocol.h"
+#include "flight_management/rpc_server.h"
+#include "flight_management/rpc_socket.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+using ::testing::IsEmpty;
+
+/// @test Test requests are restored with all arguments of their operation
+TEST(RpcProtocolSpec, GivenEncodedRequests_WhenDecoded_ExpectArguments)
+{
+    std::string buffer;
+    EncodeRequest(RpcRequest{7U, RpcOpcode::kAddTrip, FlightTrip{"6E-702", "Indigo", "Pune", "Delhi", 3200.5, 100, 200},
+                             0, 0},
+                  buffer);
+    EncodeRequest(RpcRequest{8U, RpcOpcode::kFindMinFareBetweenCitiesInTimeWindow,
+                             FlightTrip{"ignored", {}, "Pune", "Delhi", 0.0}, -5, 500},
+                  buffer);
+
+    std::size_t offset{0U};
+    RpcRequest request{};
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeRequest(buffer, offset, request));
+    EXPECT_EQ(7U, request.id);
+    EXPECT_EQ(RpcOpcode::kAddTrip, request.opcode);
+    EXPECT_EQ("Indigo", request.trip.operated_by);
+    EXPECT_DOUBLE_EQ(3200.5, request.trip.fare);
+    EXPECT_EQ(200, request.trip.arrival_time);
+
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeRequest(buffer, offset, request));
+    EXPECT_EQ(8U, request.id);
+    EXPECT_EQ("", request.trip.name);
+    EXPECT_EQ("Delhi", request.trip.destination_city);
+    EXPECT_EQ(-5, request.from);
+    EXPECT_EQ(500, request.to);
+    EXPECT_EQ(buffer.size(), offset);
+    EXPECT_EQ(RpcDecodeStatus::kIncomplete, DecodeRequest(buffer, offset, request));
+}
+
+/// @test Test query requests are restored with their field predicates, ordering keys and limit
+TEST(RpcProtocolSpec, GivenEncodedQueryRequest_WhenDecoded_ExpectQuery)
+{
+    FlightTripFilter filter{};
+    filter.has_operated_by = true;
+    filter.operated_by = "Indigo";
+    filter.name_prefix = "6e";
+    filter.max_fare = 5000.0;
+    filter.departure_from = 100;
+    std::string buffer;
+    EncodeRequest(RpcRequest{9U, RpcOpcode::kExecuteQuery, FlightTrip{{}, {}, {}, {}, 0.0}, 0, 0,
+                             RpcQuery{filter, {TripOrder{TripField::kFare, true}}, 20U, 10U}},
+                  buffer);
+
+    std::size_t offset{0U};
+    RpcRequest request{};
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeRequest(buffer, offset, request));
+    EXPECT_EQ(RpcOpcode::kExecuteQuery, request.opcode);
+    EXPECT_TRUE(request.query.filter.has_operated_by);
+    EXPECT_FALSE(request.query.filter.has_origin_city);
+    EXPECT_EQ("Indigo", request.query.filter.operated_by);
+    EXPECT_EQ("6e", request.query.filter.name_prefix);
+    EXPECT_DOUBLE_EQ(5000.0, request.query.filter.max_fare);
+    EXPECT_EQ(100, request.query.filter.departure_from);
+    ASSERT_EQ(1U, request.query.order.size());
+    EXPECT_EQ(TripField::kFare, request.query.order[0U].field);
+    EXPECT_TRUE(request.query.order[0U].descending);
+    EXPECT_EQ(20U, request.query.offset);
+    EXPECT_EQ(10U, request.query.limit);
+}
+
+/// @test Test responses are restored with the result of their operation
+TEST(RpcProtocolSpec, GivenEncodedResponses_WhenDecoded_ExpectResults)
+{
+    std::string buffer;
+    EncodeResponse(RpcResponse{1U, RpcOpcode::kFindFlightByNumber, RpcStatus::kOk,
+                               {FlightTrip{"6E-702", "Indigo", "Pune", "Delhi", 3200.5, 100, 200}}, 0.0, 0U},
+                   buffer);
+    EncodeResponse(RpcResponse{2U, RpcOpcode::kGetTotalTrips, RpcStatus::kOk, {}, 0.0, 42U}, buffer);
+
+    std::size_t offset{0U};
+    RpcResponse response{};
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeResponse(buffer, offset, response));
+    ASSERT_EQ(1U, response.trips.size());
+    EXPECT_EQ("Pune", response.trips[0].origin_city);
+    EXPECT_EQ(100, response.trips[0].departure_time);
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeResponse(buffer, offset, response));
+    EXPECT_EQ(2U, response.id);
+    EXPECT_EQ(42U, response.total_trips);
+}
+
+/// @test Test responses exceeding the maximum frame size are replaced by an error response
+TEST(RpcProtocolSpec, GivenOversizedResult_WhenEncoded_ExpectResultTooLarge)
+{
+    std::string buffer;
+    EncodeResponse(RpcResponse{3U, RpcOpcode::kFindFlightsByNumberPrefix, RpcStatus::kOk,
+                               {FlightTrip{std::string(kMaxRpcFrameSize, 'X'), "Indigo", "Pune", "Delhi", 0.0}}, 0.0,
+                               0U},
+                   buffer);
+
+    std::size_t offset{0U};
+    RpcResponse response{};
+    ASSERT_EQ(RpcDecodeStatus::kDecoded, DecodeResponse(buffer, offset, response));
+    EXPECT_EQ(3U, response.id);
+    EXPECT_EQ(RpcStatus::kResultTooLarge, response.status);
+    EXPECT_THAT(response.trips, IsEmpty());
+}
+
+/// @test Test partially received frames are incomplete and corrupted frames are malformed
+TEST(RpcProtocolSpec, GivenPartialOrCorruptedFrame_WhenDecoded_ExpectIncompleteOrMalformed)
+{
+    std::string buffer;
+    EncodeRequest(RpcRequest{1U, RpcOpcode::kRemoveTrip, FlightTrip{"6E-702", {}, {}, {}, 0.0}, 0, 0}, buffer);
+
+    RpcRequest request{};
+    for (std::size_t size = 0U; size < buffer.size(); ++size)
+    {
+        std::size_t offset{0U};
+        EXPECT_EQ(RpcDecodeStatus::kIncomplete, DecodeRequest(buffer.substr(0U, size), offset, request));
+        EXPECT_EQ(0U, offset);
+    }
+
+    std::size_t offset{0U};
+    auto unknown_opcode = buffer;
+    unknown_opcode[8U] = static_cast<char>(0xFF);
+    EXPECT_EQ(RpcDecodeStatus::kMalformed, DecodeRequest(unknown_opcode, offset, request));
+    const std::string oversized_frame{"\xFF\xFF\xFF\xFF", 4U};
+    EXPECT_EQ(RpcDecodeStatus::kMalformed, DecodeRequest(oversized_frame, offset, request));
+}
+
+/// @brief RPC Server Test Fixture
+class RpcServerSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        ASSERT_TRUE(server_.Start());
+        RemoteFlightTripDatabase database{endpoint_};
+        database.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000, 100, 200);
+        database.AddTrip("AI-101", "AirIndia", "Pune", "Delhi", 5000, 300, 400);
+    }
+
+    /// @brief Endpoint of server under test
+    const std::string endpoint_{"unix:/tmp/flight_management_rpc_tests_" + std::to_string(::getpid()) + ".sock"};
+
+    /// @brief Unit under Test
+    RpcServer server_{std::make_unique<FlightTripDatabase>(), endpoint_, 2U};
+};
+
+/// @test Test remote database serves all operations of the served database
+TEST_F(RpcServerSpec, GivenRemoteDatabase_WhenQueried_ExpectServedResults)
+{
+    RemoteFlightTripDatabase unit{endpoint_};
+    ASSERT_TRUE(unit.IsConnected());
+
+    EXPECT_EQ(2U, unit.GetTotalTrips());
+    EXPECT_EQ("Indigo", unit.FindFlightByNumber("6E-702").at(0U).operated_by);
+    EXPECT_EQ(2U, unit.FindFlightsByOriginCity("Pune").size());
+    EXPECT_EQ(1U, unit.FindFlightsByNumberPrefix("ai-").size());
+    EXPECT_EQ(2U, unit.FindFlightsByOriginCityPrefix("pu").size());
+    EXPECT_EQ(1U, unit.FindFlightsByOriginCityInTimeWindow("Pune", 250, 350).size());
+    EXPECT_DOUBLE_EQ(4000.0, unit.FindAverageCostOfAllTrips());
+    EXPECT_DOUBLE_EQ(5000.0, unit.FindMinFareBetweenCities("Pune", "Delhi"));
+    EXPECT_DOUBLE_EQ(3000.0, unit.FindMinFareBetweenCitiesInTimeWindow("Pune", "Bengaluru", 0, 150));
+
+    unit.UpdateFareByTrip("6E-702", 3500);
+    unit.UpdateFareByOperator("AirIndia", 4500);
+    EXPECT_DOUBLE_EQ(4500.0, unit.FindMaxFareByOperator("AirIndia"));
+    unit.UpdateFareByTrip("AI-101", 300, 5500);
+    EXPECT_DOUBLE_EQ(5500.0, unit.FindMaxFareByOperator("AirIndia"));
+    unit.RemoveTrip("6E-702");
+    EXPECT_THAT(unit.FindFlightByNumber("6E-702"), IsEmpty());
+    EXPECT_EQ(1U, unit.GetTotalTrips());
+    unit.RemoveTrip("AI-101", 300);
+    EXPECT_EQ(0U, unit.GetTotalTrips());
+}
+
+/// @test Test remote queries are filtered on the server, with custom predicates and projection applied by the client
+TEST_F(RpcServerSpec, GivenRemoteDatabase_WhenQueryExecuted_ExpectServerFilteredResults)
+{
+    RemoteFlightTripDatabase unit{endpoint_};
+
+    const auto trips = unit.Query()
+                           .WhereDepartureBetween(0, 1000)
+                           .Where([](const FlightTrip& trip) { return trip.fare > 4000.0; })
+                           .Select({TripField::kName})
+                           .ToVector();
+    ASSERT_EQ(1U, trips.size());
+    EXPECT_EQ("AI-101", trips[0U].name);
+    EXPECT_EQ("", trips[0U].operated_by);
+
+    const auto ordered_trips = unit.Query().WhereOperatedBy("Indigo").OrderBy(TripField::kFare, true).ToVector();
+    ASSERT_EQ(1U, ordered_trips.size());
+    EXPECT_EQ("6E-702", ordered_trips[0U].name);
+    EXPECT_EQ(1U, unit.Query().OrderBy(TripField::kFare).Limit(1U).ToVector().size());
+}
+
+/// @test Test remote queries spanning several pages return every matching trip once, in query order
+TEST_F(RpcServerSpec, GivenResultsSpanningPages_WhenQueryExecuted_ExpectEveryTripOnceInOrder)
+{
+    constexpr std::size_t kNumberOfTrips{5000U};
+    RemoteFlightTripDatabase unit{endpoint_};
+    for (std::size_t idx = 0U; idx < kNumberOfTrips; ++idx)
+    {
+        unit.AddTrip("UK-" + std::to_string(idx), "Vistara", "Mumbai", "Goa", static_cast<double>(idx % 10U) * 100.0,
+                     static_cast<Timestamp>(idx), static_cast<Timestamp>(idx + 60U));
+    }
+    const auto is_even = [](const FlightTrip& trip) { return (trip.departure_time % 2) == 0; };
+
+    const auto trips = unit.Query().WhereOperatedBy("Vistara").Where(is_even).OrderBy(TripField::kFare).ToVector();
+    ASSERT_EQ(kNumberOfTrips / 2U, trips.size());
+    std::set<std::string> names;
+    for (std::size_t idx = 0U; idx < trips.size(); ++idx)
+    {
+        EXPECT_TRUE(is_even(trips[idx]));
+        EXPECT_TRUE(names.insert(trips[idx].name).second);
+        EXPECT_TRUE((idx == 0U) || (trips[idx - 1U].fare <= trips[idx].fare));
+    }
+
+    const auto limited_trips =
+        unit.Query().WhereOperatedBy("Vistara").Where(is_even).OrderBy(TripField::kFare, true).Limit(700U).ToVector();
+    ASSERT_EQ(700U, limited_trips.size());
+    EXPECT_TRUE(std::all_of(limited_trips.begin(), limited_trips.end(),
+                            [](const FlightTrip& trip) { return trip.fare >= 600.0; }));
+    EXPECT_EQ(1000U, unit.Query().WhereOperatedBy("Vistara").Limit(1000U).ToVector().size());
+}
+
+/// @test Test pipelined identical lookups are batched and answered in request order, mutations act as barriers
+TEST_F(RpcServerSpec, GivenPipelinedRequests_WhenReceived_ExpectBatchedLookupsInRequestOrder)
+{
+    constexpr std::size_t kNumberOfLookups{100U};
+    RpcClient unit{endpoint_};
+    const RpcRequest lookup{0U, RpcOpcode::kFindMinFareBetweenCities, FlightTrip{{}, {}, "Pune", "Delhi", 0.0}, 0, 0};
+    std::vector<std::uint32_t> ids;
+    for (std::size_t idx = 0U; idx < kNumberOfLookups; ++idx)
+    {
+        ids.push_back(unit.Send(lookup));
+    }
+    ids.push_back(unit.Send(
+        RpcRequest{0U, RpcOpcode::kAddTrip, FlightTrip{"SG-512", "SpiceJet", "Pune", "Delhi", 2000.0}, 0, 0}));
+    ids.push_back(unit.Send(lookup));
+    ASSERT_TRUE(unit.Flush());
+
+    RpcResponse response{};
+    for (std::size_t idx = 0U; idx < kNumberOfLookups; ++idx)
+    {
+        ASSERT_TRUE(unit.Receive(response));
+        EXPECT_EQ(ids[idx], response.id);
+        EXPECT_DOUBLE_EQ(5000.0, response.fare);
+    }
+    ASSERT_TRUE(unit.Receive(response));
+    EXPECT_EQ(RpcOpcode::kAddTrip, response.opcode);
+    ASSERT_TRUE(unit.Receive(response));
+    EXPECT_EQ(ids.back(), response.id);
+    EXPECT_DOUBLE_EQ(2000.0, response.fare);
+
+    const auto statistics = server_.GetStatistics();
+    EXPECT_EQ(kNumberOfLookups + 2U + 2U, statistics.requests);
+    EXPECT_LT(statistics.batches, statistics.requests);
+    EXPECT_GT(statistics.deduplicated_lookups, 0U);
+}
+
+/// @test Test connection sending malformed request is closed, other connections are still served
+TEST_F(RpcServerSpec, GivenMalformedRequest_WhenReceived_ExpectConnectionClosed)
+{
+    const auto fd = ConnectTo(endpoint_);
+    ASSERT_GE(fd, 0);
+    const std::string malformed_request{"\x02\x00\x00\x00\xFF\xFF", 6U};
+    ASSERT_EQ(static_cast<ssize_t>(malformed_request.size()),
+              ::write(fd, malformed_request.data(), malformed_request.size()));
+    char received{};
+    EXPECT_EQ(0, ::read(fd, &received, 1U));
+    ::close(fd);
+
+    RemoteFlightTripDatabase unit{endpoint_};
+    EXPECT_EQ(2U, unit.GetTotalTrips());
+}
+
+/// @test Test reading requests is paused while a peer does not read its responses and resumed once it does
+TEST(RpcServerBackpressureSpec, GivenPeerNotReadingResponses_WhenPipelining_ExpectReadingPausedAndResumed)
+{
+    constexpr std::size_t kNumberOfLookups{100U};
+    auto database = std::make_unique<FlightTripDatabase>();
+    for (std::size_t idx = 0U; idx < 4000U; ++idx)
+    {
+        database->AddTrip("FL-" + std::to_string(idx), std::string(200U, 'O'), "Pune", "Delhi", 1000.0);
+    }
+    const std::string endpoint{"unix:/tmp/flight_management_rpc_backpressure_" + std::to_string(::getpid()) + ".sock"};
+    RpcServer server{std::move(database), endpoint, 1U};
+    ASSERT_TRUE(server.Start());
+
+    RpcClient unit{endpoint};
+    const RpcRequest lookup{0U, RpcOpcode::kFindFlightsByNumberPrefix, FlightTrip{"FL", {}, {}, {}, 0.0}, 0, 0};
+    for (std::size_t idx = 0U; idx < kNumberOfLookups; ++idx)
+    {
+        unit.Send(lookup);
+    }
+    ASSERT_TRUE(unit.Flush());
+    for (std::size_t attempt = 0U; (attempt < 500U) && (server.GetStatistics().paused_reads == 0U); ++attempt)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    }
+    EXPECT_GT(server.GetStatistics().paused_reads, 0U);
+
+    RpcResponse response{};
+    for (std::size_t idx = 0U; idx < kNumberOfLookups; ++idx)
+    {
+        ASSERT_TRUE(unit.Receive(response));
+        EXPECT_EQ(4000U, response.trips.size());
+    }
+    ASSERT_TRUE(unit.Call(RpcRequest{0U, RpcOpcode::kGetTotalTrips, FlightTrip{{}, {}, {}, {}, 0.0}, 0, 0}, response));
+    EXPECT_EQ(4000U, response.total_trips);
+}
+
+/// @brief Database whose first GetTotalTrips blocks until released, so that further requests queue up meanwhile
+class BlockingFlightTripDatabase : public FlightTripDatabase
+{
+  public:
+    /// @brief Constructor
+    explicit BlockingFlightTripDatabase(std::shared_future<void> released) : released_{std::move(released)} {}
+
+    /// @brief Get Total number of trips in database, once released
+    virtual std::size_t GetTotalTrips(void) const override
+    {
+        released_.wait();
+        return FlightTripDatabase::GetTotalTrips();
+    }
+
+  private:
+    /// @brief Ready once GetTotalTrips is released
+    std::shared_future<void> released_;
+};
+
+/// @test Test reading requests is paused while too many requests of a connection are queued and resumed once executed
+TEST(RpcServerBackpressureSpec, GivenSlowDatabase_WhenPipelining_ExpectReadingPausedAndResumed)
+{
+    constexpr std::size_t kNumberOfRequests{50000U};
+    std::promise<void> release;
+    const std::string endpoint{"unix:/tmp/flight_management_rpc_queued_" + std::to_string(::getpid()) + ".sock"};
+    RpcServer server{std::make_unique<BlockingFlightTripDatabase>(release.get_future().share()), endpoint, 1U};
+    ASSERT_TRUE(server.Start());
+
+    // Requests exceed the socket buffers, hence the database is released concurrently once reading has been paused
+    std::size_t requests_while_paused{0U};
+    std::thread releaser{[&]() {
+        for (std::size_t attempt = 0U; (attempt < 500U) && (server.GetStatistics().paused_reads == 0U); ++attempt)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        requests_while_paused = server.GetStatistics().requests;
+        release.set_value();
+    }};
+    RpcClient unit{endpoint};
+    const RpcRequest request{0U, RpcOpcode::kGetTotalTrips, FlightTrip{{}, {}, {}, {}, 0.0}, 0, 0};
+    for (std::size_t idx = 0U; idx < kNumberOfRequests; ++idx)
+    {
+        unit.Send(request);
+    }
+    EXPECT_TRUE(unit.Flush());
+    releaser.join();
+    EXPECT_GT(server.GetStatistics().paused_reads, 0U);
+    EXPECT_LT(requests_while_paused, kNumberOfRequests / 2U);
+
+    RpcResponse response{};
+    for (std::size_t idx = 0U; idx < kNumberOfRequests; ++idx)
+    {
+        ASSERT_TRUE(unit.Receive(response));
+        EXPECT_EQ(0U, response.total_trips);
+    }
+    EXPECT_EQ(kNumberOfRequests, server.GetStatistics().requests);
+}
+
+/// @test Test socket file left behind by a crashed server does not prevent listening on its path
+TEST(RpcServerUnixSpec, GivenStaleSocketFile_WhenStarted_ExpectServedResults)
+{
+    const auto path = "/tmp/flight_management_rpc_stale_" + std::to_string(::getpid()) + ".sock";
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1U);
+    const auto fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_EQ(0, ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)));
+    ::close(fd);
+
+    RpcServer server{std::make_unique<FlightTripDatabase>(), "unix:" + path, 1U};
+    ASSERT_TRUE(server.Start());
+    RemoteFlightTripDatabase unit{"unix:" + path};
+    EXPECT_EQ(0U, unit.GetTotalTrips());
+    EXPECT_FALSE(RpcServer(std::make_unique<FlightTripDatabase>(), "unix:" + path, 1U).Start());
+}
+
+/// @test Test server serves loopback TCP endpoint
+TEST(RpcServerTcpSpec, GivenTcpEndpoint_WhenQueried_ExpectServedResults)
+{
+    const std::string endpoint{"tcp:" + std::to_string(40000 + (::getpid() % 20000))};
+    RpcServer server{std::make_unique<FlightTripDatabase>(), endpoint, 1U};
+    ASSERT_TRUE(server.Start());
+
+    RemoteFlightTripDatabase unit{endpoint};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+    EXPECT_EQ(1U, unit.GetTotalTrips());
+}
+
+/// @test Test remote database operations fail loudly without server
+TEST(RemoteFlightTripDatabaseSpec, GivenNoServer_WhenCalled_ExpectRemoteCallFailed)
+{
+    RemoteFlightTripDatabase unit{"unix:/tmp/flight_management_rpc_tests_no_server.sock"};
+    EXPECT_FALSE(unit.IsConnected());
+    EXPECT_THROW(unit.GetTotalTrips(), RemoteCallFailed);
+    EXPECT_THROW(unit.FindFlightByNumber("6E-702"), RemoteCallFailed);
+    EXPECT_THROW(unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000), RemoteCallFailed);
+    EXPECT_THROW(unit.Execute(unit.Query(), [](const FlightTrip&) { return true; }), RemoteCallFailed);
+}
+
+/// @test Test results exceeding the maximum frame size fail loudly, while the connection stays usable
+TEST(RemoteFlightTripDatabaseSpec, GivenOversizedResult_WhenQueried_ExpectRemoteCallFailed)
+{
+    constexpr std::size_t kNumberOfTrips{17U};
+    auto database = std::make_unique<FlightTripDatabase>();
+    for (std::size_t idx = 0U; idx < kNumberOfTrips; ++idx)
+    {
+        database->AddTrip("FL-" + std::to_string(idx), std::string(kMaxRpcFrameSize / 16U, 'O'), "Pune", "Delhi",
+                          1000.0);
+    }
+    const std::string endpoint{"unix:/tmp/flight_management_rpc_too_large_" + std::to_string(::getpid()) + ".sock"};
+    RpcServer server{std::move(database), endpoint, 1U};
+    ASSERT_TRUE(server.Start());
+
+    RemoteFlightTripDatabase unit{endpoint};
+    EXPECT_THROW(unit.FindFlightsByOriginCity("Pune"), RemoteCallFailed);
+    EXPECT_EQ(kNumberOfTrips, unit.GetTotalTrips());
+    EXPECT_EQ(1U, unit.FindFlightByNumber("FL-3").size());
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,70 @@
+///
+/// @file schedule_index_tests.cpp
+/// @brief Contains unit tests for Schedule Index.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/schedule_index.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+/// @brief Collect slots of the entries found in time window
+std::vector<std::size_t> FindSlots(const ScheduleIndex& index, const ScheduleIndex::Key key, const Timestamp from,
+                                   const Timestamp to)
+{
+    std::vector<std::size_t> slots;
+    const auto entries = index.Find(key, from, to);
+    std::for_each(entries.first, entries.second, [&slots](const auto& entry) { slots.push_back(entry.second); });
+    return slots;
+}
+
+/// @brief Schedule Index Test Fixture
+class ScheduleIndexSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        unit_.Insert(key_, 300, 0U);
+        unit_.Insert(key_, 100, 1U);
+        unit_.Insert(key_, 200, 2U);
+        unit_.Insert(key_, 200, 3U);
+        unit_.Insert(ScheduleIndex::MakeKey(2U, 1U), 150, 4U);
+    }
+
+    /// @brief Key of route under test
+    const ScheduleIndex::Key key_{ScheduleIndex::MakeKey(1U, 2U)};
+
+    /// @brief Unit under Test
+    ScheduleIndex unit_;
+};
+
+/// @test Test entries are returned in departure order within time window
+TEST_F(ScheduleIndexSpec, GivenTimeWindow_WhenFind_ExpectEntriesInDepartureOrder)
+{
+    EXPECT_THAT(FindSlots(unit_, key_, 0, 1000), ElementsAre(1U, 2U, 3U, 0U));
+    EXPECT_THAT(FindSlots(unit_, key_, 150, 300), ElementsAre(2U, 3U));
+    EXPECT_THAT(FindSlots(unit_, key_, 300, 200), IsEmpty());
+    EXPECT_THAT(FindSlots(unit_, ScheduleIndex::MakeKey(3U, 3U), 0, 1000), IsEmpty());
+}
+
+/// @test Test erase and replace keep the index up to date
+TEST_F(ScheduleIndexSpec, GivenErasedAndReplacedSlots_WhenFind_ExpectUpdatedEntries)
+{
+    unit_.Erase(key_, 200, 2U);
+    unit_.Erase(key_, 100, 3U);
+    unit_.Replace(key_, 200, 3U, 7U);
+
+    EXPECT_THAT(FindSlots(unit_, key_, 0, 1000), ElementsAre(1U, 7U, 0U));
+}
+
+}  // namespace
+}  // namespace fms
@@ -0,0 +1,164 @@
+///
+/// @file tracing_tests.cpp
+/// @brief Contains unit tests for Tracing APIs.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/tracing.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace fms
+{
+namespace tracing
+{
+namespace
+{
+using ::testing::HasSubstr;
+using ::testing::Not;
+
+/// @brief Count occurrences of text in trace
+std::size_t Count(const std::string& trace, const std::string& text)
+{
+    std::size_t count = 0U;
+    for (auto position = trace.find(text); position != std::string::npos; position = trace.find(text, position + 1U))
+    {
+        ++count;
+    }
+    return count;
+}
+
+class TracingSpec : public ::testing::Test
+{
+  protected:
+    void SetUp() override { ExportTrace(); }
+
+    void TearDown() override { SetSamplingRate(0.0); }
+
+    /// @brief Export and clear recorded spans
+    std::string ExportTrace()
+    {
+        std::stringstream trace;
+        ExportChromeTrace(trace);
+        return trace.str();
+    }
+};
+
+/// @test Test no spans are recorded while tracing is off
+TEST_F(TracingSpec, Disabled)
+{
+    {
+        TRACE_SPAN("Disabled");
+    }
+
+    const auto trace = ExportTrace();
+    EXPECT_THAT(trace, HasSubstr("\"traceEvents\":["));
+    EXPECT_THAT(trace, Not(HasSubstr("Disabled")));
+}
+
+/// @test Test nested spans are recorded as complete events, inner span first
+TEST_F(TracingSpec, NestedSpans)
+{
+    SetSamplingRate(1.0);
+    {
+        TRACE_SPAN("Outer");
+        {
+            TRACE_SPAN("Inner");
+        }
+    }
+
+    const auto trace = ExportTrace();
+    EXPECT_EQ(2U, Count(trace, "\"ph\":\"X\""));
+    EXPECT_LT(trace.find("\"name\":\"Inner\""), trace.find("\"name\":\"Outer\""));
+    EXPECT_THAT(ExportTrace(), Not(HasSubstr("Outer")));
+}
+
+/// @test Test sampling rate is clamped
+TEST_F(TracingSpec, SamplingRate)
+{
+    SetSamplingRate(2.0);
+    EXPECT_DOUBLE_EQ(1.0, GetSamplingRate());
+    SetSamplingRate(0.25);
+    EXPECT_DOUBLE_EQ(0.25, GetSamplingRate());
+    SetSamplingRate(-1.0);
+    EXPECT_DOUBLE_EQ(0.0, GetSamplingRate());
+}
+
+/// @test Test root spans are sampled, nested spans follow their root span
+TEST_F(TracingSpec, SampledRootSpans)
+{
+    constexpr std::size_t kNumberOfRootSpans{1000U};
+    SetSamplingRate(0.5);
+    for (std::size_t idx = 0U; idx < kNumberOfRootSpans; ++idx)
+    {
+        TRACE_SPAN("Root");
+        TRACE_SPAN("Nested");
+    }
+
+    const auto trace = ExportTrace();
+    const auto root_spans = Count(trace, "\"name\":\"Root\"");
+    EXPECT_EQ(root_spans, Count(trace, "\"name\":\"Nested\""));
+    EXPECT_GT(root_spans, kNumberOfRootSpans / 4U);
+    EXPECT_LT(root_spans, kNumberOfRootSpans * 3U / 4U);
+}
+
+/// @test Test spans of exited threads are exported with their thread id
+TEST_F(TracingSpec, OtherThread)
+{
+    SetSamplingRate(1.0);
+    std::thread{[]() { TRACE_SPAN("OtherThread"); }}.join();
+    {
+        TRACE_SPAN("ThisThread");
+    }
+
+    const auto trace = ExportTrace();
+    const auto other_thread = trace.find("\"name\":\"OtherThread\"");
+    const auto this_thread = trace.find("\"name\":\"ThisThread\"");
+    ASSERT_NE(std::string::npos, other_thread);
+    ASSERT_NE(std::string::npos, this_thread);
+    EXPECT_NE(trace.substr(trace.find("\"tid\":", other_thread), 16U),
+              trace.substr(trace.find("\"tid\":", this_thread), 16U));
+}
+
+/// @test Test spans beyond buffer capacity are dropped and counted
+TEST_F(TracingSpec, DroppedEvents)
+{
+    constexpr std::size_t kNumberOfDroppedEvents{10U};
+    const auto dropped_events = GetDroppedEvents();
+    SetSamplingRate(1.0);
+    std::thread{[]() {
+        for (std::size_t idx = 0U; idx < kTraceBufferCapacity + kNumberOfDroppedEvents; ++idx)
+        {
+            TRACE_SPAN("Span");
+        }
+    }}.join();
+
+    EXPECT_EQ(dropped_events + kNumberOfDroppedEvents, GetDroppedEvents());
+    EXPECT_EQ(kTraceBufferCapacity, Count(ExportTrace(), "\"ph\":\"X\""));
+    EXPECT_EQ(dropped_events + kNumberOfDroppedEvents, GetDroppedEvents());
+}
+
+/// @test Test database operations are traced down to index lookups
+TEST_F(TracingSpec, DatabaseSpans)
+{
+    FlightTripDatabase database;
+    database.AddTrip("6E-2131", "Indigo", "Bengaluru", "Pune", 3000.0);
+    ExportTrace();
+
+    SetSamplingRate(1.0);
+    EXPECT_EQ(1U, database.FindFlightByNumber("6E-2131").size());
+
+    const auto trace = ExportTrace();
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"FlightTripDatabase::FindFlightByNumber\""));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"TrieIndex::VisitExact\""));
+    EXPECT_THAT(trace, HasSubstr("\"name\":\"FlightTripDatabase::ToFlightTrips\""));
+}
+
+}  // namespace
+}  // namespace tracing
+}  // namespace fms
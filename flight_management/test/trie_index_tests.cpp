@@ -0,0 +1,180 @@
+///
+/// @file trie_index_tests.cpp
+/// @brief Contains unit tests for Trie Index.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/trie_index.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace fms
+{
+namespace
+{
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+/// @brief Trie Index Test Fixture
+class TrieIndexSpec : public ::testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        unit_.Insert("Bengaluru", 0U);
+        unit_.Insert("Belgaum", 1U);
+        unit_.Insert("Pune", 2U);
+        unit_.Insert("BENGALURU", 3U);
+    }
+
+    /// @brief Unit under Test
+    TrieIndex unit_;
+};
+
+/// @test Test prefix search ignores case and orders results by key
+TEST_F(TrieIndexSpec, GivenPrefix_WhenFindPrefix_ExpectCaseInsensitiveMatches)
+{
+    EXPECT_THAT(unit_.FindPrefix("be"), ElementsAre(1U, 0U, 3U));
+    EXPECT_THAT(unit_.FindPrefix("BENG"), ElementsAre(0U, 3U));
+    EXPECT_THAT(unit_.FindPrefix("Chennai"), IsEmpty());
+}
+
+/// @test Test exact search ignores case
+TEST_F(TrieIndexSpec, GivenKey_WhenFindExact_ExpectOnlyEqualKeys)
+{
+    EXPECT_THAT(unit_.FindExact("bengaluru"), ElementsAre(0U, 3U));
+    EXPECT_THAT(unit_.FindExact("Beng"), IsEmpty());
+}
+
+/// @test Test counts match number of found slots
+TEST_F(TrieIndexSpec, GivenKey_WhenCount_ExpectNumberOfFoundSlots)
+{
+    EXPECT_EQ(2U, unit_.CountExact("bengaluru"));
+    EXPECT_EQ(0U, unit_.CountExact("Beng"));
+    EXPECT_EQ(3U, unit_.CountPrefix("be"));
+    EXPECT_EQ(4U, unit_.CountPrefix(""));
+    EXPECT_EQ(0U, unit_.CountPrefix("Chennai"));
+}
+
+/// @test Test erase and replace keep the index up to date
+TEST_F(TrieIndexSpec, GivenErasedAndReplacedSlots_WhenFindPrefix_ExpectUpdatedMatches)
+{
+    unit_.Erase("Bengaluru", 0U);
+    unit_.Replace("Pune", 2U, 0U);
+    unit_.Erase("Pune", 42U);
+
+    EXPECT_THAT(unit_.FindPrefix("be"), ElementsAre(1U, 3U));
+    EXPECT_THAT(unit_.FindExact("pune"), ElementsAre(0U));
+}
+
+/// @test Test visitors see slots in place and stop when asked to
+TEST_F(TrieIndexSpec, GivenVisitor_WhenVisitStopped_ExpectNoFurtherSlots)
+{
+    std::vector<std::size_t> slots;
+    EXPECT_FALSE(unit_.VisitPrefix("be", [&slots](const std::size_t slot) {
+        slots.push_back(slot);
+        return slots.size() < 2U;
+    }));
+    EXPECT_THAT(slots, ElementsAre(1U, 0U));
+
+    slots.clear();
+    EXPECT_TRUE(unit_.VisitExact("BENGALURU", [&slots](const std::size_t slot) {
+        slots.push_back(slot);
+        return true;
+    }));
+    EXPECT_THAT(slots, ElementsAre(0U, 3U));
+    EXPECT_TRUE(unit_.VisitExact("Chennai", [](const std::size_t) { return false; }));
+}
+
+/// @test Test matches count and visit their slots without searching the key again
+TEST_F(TrieIndexSpec, GivenMatch_WhenVisited_ExpectSlotsOfMatchedKeys)
+{
+    const auto prefix_match = unit_.MatchPrefix("BE");
+    const auto exact_match = unit_.MatchExact("bengaluru");
+    EXPECT_EQ(3U, prefix_match.count);
+    EXPECT_EQ(2U, exact_match.count);
+    EXPECT_EQ(0U, unit_.MatchExact("Beng").count);
+
+    std::vector<std::size_t> slots;
+    const auto collect = [&slots](const std::size_t slot) {
+        slots.push_back(slot);
+        return true;
+    };
+    EXPECT_TRUE(unit_.Visit(prefix_match, collect));
+    EXPECT_THAT(slots, ElementsAre(1U, 0U, 3U));
+    slots.clear();
+    EXPECT_TRUE(unit_.Visit(exact_match, collect));
+    EXPECT_THAT(slots, ElementsAre(0U, 3U));
+    slots.clear();
+    EXPECT_TRUE(unit_.Visit(unit_.MatchPrefix("Chennai"), collect));
+    EXPECT_THAT(slots, IsEmpty());
+}
+
+/// @test Test erasing slots of other keys does nothing and emptied keys are no longer found
+TEST_F(TrieIndexSpec, GivenAllSlotsOfKeyErased_WhenSearched_ExpectKeyReleased)
+{
+    unit_.Erase("Pune", 0U);
+    unit_.Replace("Pune", 1U, 9U);
+    EXPECT_THAT(unit_.FindExact("bengaluru"), ElementsAre(0U, 3U));
+    EXPECT_THAT(unit_.FindPrefix("be"), ElementsAre(1U, 0U, 3U));
+
+    unit_.Erase("Pune", 2U);
+    unit_.Erase("Belgaum", 1U);
+    EXPECT_EQ(0U, unit_.CountPrefix("p"));
+    EXPECT_EQ(0U, unit_.CountPrefix("bel"));
+    EXPECT_EQ(2U, unit_.CountPrefix(""));
+
+    unit_.Insert("Pimpri", 1U);
+    unit_.Insert("Pune", 2U);
+    EXPECT_THAT(unit_.FindPrefix("p"), ElementsAre(1U, 2U));
+    EXPECT_THAT(unit_.FindPrefix(""), ElementsAre(0U, 3U, 1U, 2U));
+}
+
+/// @test Test erase and replace keep remaining slots of heavily shared keys
+TEST(TrieIndexSharedKeySpec, GivenManySlotsPerKey_WhenErasedAndReplaced_ExpectRemainingSlots)
+{
+    TrieIndex unit{};
+    for (std::size_t slot = 0U; slot < 1000U; ++slot)
+    {
+        unit.Insert("Pune", slot);
+    }
+    for (std::size_t slot = 0U; slot < 1000U; slot += 2U)
+    {
+        unit.Erase("pune", slot);
+    }
+    unit.Replace("PUNE", 1U, 2000U);
+
+    auto slots = unit.FindExact("Pune");
+    std::sort(slots.begin(), slots.end());
+    ASSERT_EQ(500U, slots.size());
+    EXPECT_EQ(3U, slots.front());
+    EXPECT_EQ(2000U, slots.back());
+    EXPECT_EQ(500U, unit.CountExact("pune"));
+}
+
+/// @test Test database keeps indexes consistent when removal moves trips
+TEST(FlightTripDatabaseIndexSpec, GivenRemovedTrips_WhenSearched_ExpectConsistentResults)
+{
+    FlightTripDatabase unit{};
+    unit.AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+    unit.AddTrip("AI-854", "AirIndia", "Pune", "Delhi", 5000);
+    unit.AddTrip("6E-302", "Indigo", "Mumbai", "Bengaluru", 3230);
+    unit.AddTrip("SJ-512", "SpiceJet", "Bengaluru", "Ahmedabad", 5000);
+
+    unit.RemoveTrip("6E-702");
+    unit.RemoveTrip("ai-854");
+
+    EXPECT_EQ(3U, unit.GetTotalTrips());
+    ASSERT_EQ(1U, unit.FindFlightByNumber("SJ-512").size());
+    EXPECT_EQ("Bengaluru", unit.FindFlightByNumber("SJ-512")[0].origin_city);
+    EXPECT_EQ(1U, unit.FindFlightsByOriginCity("Pune").size());
+    EXPECT_TRUE(unit.FindFlightsByOriginCity("pune").empty());
+    EXPECT_EQ(1U, unit.FindFlightsByNumberPrefix("6E").size());
+    EXPECT_EQ(1U, unit.FindFlightsByOriginCityPrefix("b").size());
+}
+
+}  // namespace
+}  // namespace fms
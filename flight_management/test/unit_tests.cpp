@@ -7,6 +7,7 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <limits>
 #include <memory>
 
 namespace fms
@@ -104,6 +105,31 @@ TEST_F(UnitTestSpec, FindFlightsByOriginCity)
     EXPECT_EQ(flight_trips[0].origin_city, "Pune");
 }
 
+/// @test Test finding flights by flight number prefix
+TEST_F(UnitTestSpec, FindFlightsByNumberPrefix)
+{
+    unit_->AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+
+    const auto flight_trips = unit_->FindFlightsByNumberPrefix("6e-");
+    ASSERT_EQ(2U, flight_trips.size());
+    EXPECT_EQ(flight_trips[0].name, "6E-509");
+    EXPECT_EQ(flight_trips[1].name, "6E-702");
+    EXPECT_EQ(3U, unit_->FindFlightsByNumberPrefix("").size());
+    EXPECT_TRUE(unit_->FindFlightsByNumberPrefix("SJ").empty());
+}
+
+/// @test Test finding flights by origin city prefix
+TEST_F(UnitTestSpec, FindFlightsByOriginCityPrefix)
+{
+    unit_->AddTrip("6E-702", "Indigo", "Pune", "Bengaluru", 3000);
+    unit_->RemoveTrip("6E-509");
+
+    const auto flight_trips = unit_->FindFlightsByOriginCityPrefix("PU");
+    ASSERT_EQ(1U, flight_trips.size());
+    EXPECT_EQ(flight_trips[0].name, "6E-702");
+    EXPECT_EQ(1U, unit_->FindFlightsByOriginCityPrefix("mumbai").size());
+}
+
 /// @test Test finding flight average cost for all the trips
 TEST_F(UnitTestSpec, FindAverageCostOfAllTrips)
 {
@@ -122,6 +148,90 @@ TEST_F(UnitTestSpec, FindMinFareBetweenCities)
     EXPECT_DOUBLE_EQ(4000, min_fare);
 }
 
+/// @test Test finding flights by origin city within time window
+TEST_F(UnitTestSpec, FindFlightsByOriginCityInTimeWindow)
+{
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600000000, 1600007200);
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 3900, 1600086400, 1600093600);
+    unit_->AddTrip("AI-529", "AirIndia", "Pune", "Delhi", 8000, 1600003600, 1600010800);
+    EXPECT_EQ(5U, unit_->GetTotalTrips());
+
+    const auto flight_trips = unit_->FindFlightsByOriginCityInTimeWindow("Pune", 1600000000, 1600086400);
+    ASSERT_EQ(2U, flight_trips.size());
+    EXPECT_EQ(flight_trips[0].name, "6E-509");
+    EXPECT_EQ(flight_trips[0].departure_time, 1600000000);
+    EXPECT_EQ(flight_trips[1].name, "AI-529");
+    EXPECT_EQ(flight_trips[1].arrival_time, 1600010800);
+}
+
+/// @test Test finding minimum fare between cities within time window
+TEST_F(UnitTestSpec, FindMinFareBetweenCitiesInTimeWindow)
+{
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600000000, 1600007200);
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 3900, 1600086400, 1600093600);
+    unit_->AddTrip("AI-529", "AirIndia", "Pune", "Delhi", 8000, 1600003600, 1600010800);
+    unit_->RemoveTrip("AI-238");
+
+    EXPECT_DOUBLE_EQ(4200, unit_->FindMinFareBetweenCitiesInTimeWindow("Pune", "Delhi", 1600000000, 1600086400));
+    EXPECT_DOUBLE_EQ(3900, unit_->FindMinFareBetweenCitiesInTimeWindow("Pune", "Delhi", 1600000000, 1600086401));
+    EXPECT_DOUBLE_EQ(std::numeric_limits<double>::max(),
+                     unit_->FindMinFareBetweenCitiesInTimeWindow("Mumbai", "Delhi", 0, 1600086400));
+}
+
+/// @test Test removal of one departure of a trip
+TEST_F(UnitTestSpec, RemoveTripByDeparture)
+{
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600000000, 1600007200);
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 3900, 1600086400, 1600093600);
+
+    unit_->RemoveTrip("6E-509", 1600000001);
+    EXPECT_EQ(4U, unit_->GetTotalTrips());
+    unit_->RemoveTrip("6E-509", 1600000000);
+    EXPECT_EQ(3U, unit_->GetTotalTrips());
+    const auto flight_trips = unit_->FindFlightsByOriginCityInTimeWindow("Pune", 0, 1700000000);
+    ASSERT_EQ(2U, flight_trips.size());
+    EXPECT_EQ(0, flight_trips[0].departure_time);
+    EXPECT_EQ(1600086400, flight_trips[1].departure_time);
+}
+
+/// @test Test removal of one archived departure of a trip
+TEST_F(UnitTestSpec, RemoveArchivedTripByDeparture)
+{
+    FlightTripDatabase unit{};
+    unit.AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600000000, 1600007200);
+    unit.AddTrip("6E-509", "Indigo", "Pune", "Delhi", 3900, 1600086400, 1600093600);
+    unit.AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4100, 1600172800, 1600180000);
+    unit.ArchiveTripsDepartedBefore(1600100000);
+
+    unit.RemoveTrip("6E-509", 1600000000);
+    EXPECT_EQ(2U, unit.GetTotalTrips());
+    const auto flight_trips = unit.FindFlightsByOriginCityInTimeWindow("Pune", 0, 1700000000);
+    ASSERT_EQ(2U, flight_trips.size());
+    EXPECT_EQ(1600086400, flight_trips[0].departure_time);
+    EXPECT_EQ(1600172800, flight_trips[1].departure_time);
+}
+
+/// @test Test update of fare of one departure of a trip
+TEST_F(UnitTestSpec, UpdateFareByTripDeparture)
+{
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600000000, 1600007200);
+    unit_->UpdateFareByTrip("6E-509", 1600000000, 3600);
+
+    const auto flight_trips = unit_->FindFlightsByOriginCityInTimeWindow("Pune", 0, 1600086400);
+    ASSERT_EQ(2U, flight_trips.size());
+    EXPECT_DOUBLE_EQ(4000.0, flight_trips[0].fare);
+    EXPECT_DOUBLE_EQ(3600.0, flight_trips[1].fare);
+}
+
+/// @test Test trips arriving before departure are rejected
+TEST_F(UnitTestSpec, AddTripArrivingBeforeDeparture)
+{
+    ::testing::internal::CaptureStderr();
+    unit_->AddTrip("6E-509", "Indigo", "Pune", "Delhi", 4200, 1600007200, 1600000000);
+    EXPECT_FALSE(::testing::internal::GetCapturedStderr().empty());
+    EXPECT_EQ(2U, unit_->GetTotalTrips());
+}
+
 /// @test Test finding maximum fare by the operator
 TEST_F(UnitTestSpec, FindMaxFareByOperator)
 {
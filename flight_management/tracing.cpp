@@ -0,0 +1,229 @@
+///
+/// @file tracing.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/tracing.h"
+#include "flight_management/spsc_ring_buffer.h"
+
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace fms
+{
+namespace tracing
+{
+namespace detail
+{
+std::atomic<std::uint64_t> sampling_threshold{0U};
+
+}  // namespace detail
+
+namespace
+{
+/// @brief Scale of sampling threshold (2^32)
+constexpr double kSamplingScale{4294967296.0};
+
+/// @brief Trace events of one thread, pushed by owning thread and popped by exporter
+struct ThreadTraceBuffer
+{
+    explicit ThreadTraceBuffer(const std::int64_t id) : thread_id{id}, events{kTraceBufferCapacity}, dropped_events{0U}
+    {
+    }
+
+    /// @brief OS thread id of owning thread
+    const std::int64_t thread_id;
+
+    /// @brief Recorded, not yet exported events
+    SpscRingBuffer<TraceEvent> events;
+
+    /// @brief Number of events dropped because buffer was full
+    std::atomic<std::size_t> dropped_events;
+};
+
+/// @brief Registry of all thread buffers
+struct TraceRegistry
+{
+    /// @brief Guards buffers and serializes exporters (single consumer per buffer)
+    std::mutex mutex;
+
+    /// @brief Buffers of all threads which recorded events, kept alive until exported after thread exit
+    std::vector<std::shared_ptr<ThreadTraceBuffer>> buffers;
+
+    /// @brief Number of events dropped by exported buffers of exited threads
+    std::size_t retired_dropped_events{0U};
+};
+
+/// @brief Tracing state of one thread
+struct ThreadTraceState
+{
+    /// @brief Event buffer, registered on first recorded event
+    std::shared_ptr<ThreadTraceBuffer> buffer;
+
+    /// @brief Number of open spans
+    std::size_t depth;
+
+    /// @brief Whether current root span is sampled
+    bool sampled;
+
+    /// @brief State of xorshift random generator used for sampling
+    std::uint64_t random;
+};
+
+TraceRegistry& GetRegistry()
+{
+    static TraceRegistry registry;
+    return registry;
+}
+
+ThreadTraceState& GetThreadState()
+{
+    thread_local ThreadTraceState state{
+        nullptr, 0U, false, std::hash<std::thread::id>{}(std::this_thread::get_id()) | 1U};
+    return state;
+}
+
+std::int64_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::uint64_t NextRandom(std::uint64_t& random)
+{
+    random ^= random << 13U;
+    random ^= random >> 7U;
+    random ^= random << 17U;
+    return random;
+}
+
+ThreadTraceBuffer& GetBuffer(ThreadTraceState& state)
+{
+    if (!state.buffer)
+    {
+        state.buffer = std::make_shared<ThreadTraceBuffer>(static_cast<std::int64_t>(::syscall(SYS_gettid)));
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock{registry.mutex};
+        registry.buffers.push_back(state.buffer);
+    }
+    return *state.buffer;
+}
+
+/// @brief Write nanoseconds as microseconds with fraction (unit of Chrome trace events)
+void WriteMicroseconds(std::ostream& out, const std::int64_t nanoseconds)
+{
+    out << nanoseconds / 1000 << '.' << std::setw(3) << std::setfill('0') << nanoseconds % 1000;
+}
+
+void WriteEscaped(std::ostream& out, const char* text)
+{
+    for (; *text != '\0'; ++text)
+    {
+        if ((*text == '"') || (*text == '\\'))
+        {
+            out << '\\';
+        }
+        out << *text;
+    }
+}
+
+}  // namespace
+
+void SetSamplingRate(const double sampling_rate)
+{
+    const auto clamped_sampling_rate = std::min(std::max(sampling_rate, 0.0), 1.0);
+    detail::sampling_threshold.store(static_cast<std::uint64_t>(clamped_sampling_rate * kSamplingScale),
+                                     std::memory_order_relaxed);
+}
+
+double GetSamplingRate()
+{
+    return static_cast<double>(detail::sampling_threshold.load(std::memory_order_relaxed)) / kSamplingScale;
+}
+
+void ExportChromeTrace(std::ostream& out)
+{
+    const auto process_id = static_cast<std::int64_t>(::getpid());
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+
+    out << "{\"traceEvents\":[";
+    auto separator = "\n";
+    TraceEvent event{};
+    for (const auto& buffer : registry.buffers)
+    {
+        while (buffer->events.TryPop(event))
+        {
+            out << separator << "{\"name\":\"";
+            WriteEscaped(out, event.name);
+            out << "\",\"cat\":\"fms\",\"ph\":\"X\",\"pid\":" << process_id << ",\"tid\":" << buffer->thread_id
+                << ",\"ts\":";
+            WriteMicroseconds(out, event.begin);
+            out << ",\"dur\":";
+            WriteMicroseconds(out, event.duration);
+            out << '}';
+            separator = ",\n";
+        }
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+
+    // Buffers only referenced by the registry belong to exited threads and are fully exported now
+    const auto retired = std::partition(registry.buffers.begin(), registry.buffers.end(),
+                                        [](const auto& buffer) { return buffer.use_count() > 1; });
+    std::for_each(retired, registry.buffers.end(), [&registry](const auto& buffer) {
+        registry.retired_dropped_events += buffer->dropped_events.load(std::memory_order_relaxed);
+    });
+    registry.buffers.erase(retired, registry.buffers.end());
+}
+
+std::size_t GetDroppedEvents()
+{
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    auto dropped_events = registry.retired_dropped_events;
+    for (const auto& buffer : registry.buffers)
+    {
+        dropped_events += buffer->dropped_events.load(std::memory_order_relaxed);
+    }
+    return dropped_events;
+}
+
+void ScopedTraceSpan::Open()
+{
+    auto& state = GetThreadState();
+    if (state.depth == 0U)
+    {
+        state.sampled = (NextRandom(state.random) >> 32U) <
+                        detail::sampling_threshold.load(std::memory_order_relaxed);
+    }
+    ++state.depth;
+    opened_ = true;
+    begin_ = state.sampled ? Now() : 0;
+}
+
+void ScopedTraceSpan::Close()
+{
+    auto& state = GetThreadState();
+    --state.depth;
+    if (state.sampled)
+    {
+        const auto end = Now();
+        auto& buffer = GetBuffer(state);
+        if (!buffer.events.TryPush(TraceEvent{name_, begin_, end - begin_}))
+        {
+            buffer.dropped_events.fetch_add(1U, std::memory_order_relaxed);
+        }
+    }
+}
+
+}  // namespace tracing
+}  // namespace fms
@@ -0,0 +1,120 @@
+///
+/// @file tracing.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_TRACING_H_
+#define FLIGHT_MANAGEMENT_TRACING_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+namespace fms
+{
+namespace tracing
+{
+/// @brief Completed trace span
+struct TraceEvent
+{
+    /// @brief Span name (string literal)
+    const char* name;
+
+    /// @brief Begin of span, in nanoseconds (CLOCK_MONOTONIC)
+    std::int64_t begin;
+
+    /// @brief Duration of span, in nanoseconds
+    std::int64_t duration;
+};
+
+/// @brief Number of trace events buffered per thread, further events are dropped until buffers are exported
+constexpr std::size_t kTraceBufferCapacity{1U << 15U};
+
+/// @brief Set ratio of traced root spans (spans opened while no other span is open on the thread). Nested spans are
+///        traced together with their root span. 0.0 (default) turns tracing off, 1.0 traces every span.
+///
+/// @param sampling_rate[in] - Ratio of traced root spans, clamped to [0.0, 1.0]
+void SetSamplingRate(const double sampling_rate);
+
+/// @brief Get ratio of traced root spans
+double GetSamplingRate();
+
+/// @brief Write all buffered trace events as Chrome trace event JSON (chrome://tracing, Perfetto) and clear buffers
+///
+/// Events carry OS process/thread ids and CLOCK_MONOTONIC timestamps, so that they line up with samples of
+/// `perf record -k CLOCK_MONOTONIC`.
+///
+/// @param out[in/out] - Output stream
+void ExportChromeTrace(std::ostream& out);
+
+/// @brief Get number of trace events dropped because a thread buffer was full
+std::size_t GetDroppedEvents();
+
+namespace detail
+{
+/// @brief Sampling threshold (sampling rate scaled to 2^32), 0 if tracing is off
+extern std::atomic<std::uint64_t> sampling_threshold;
+
+}  // namespace detail
+
+/// @brief Traces the enclosing scope as span (see TRACE_SPAN)
+class ScopedTraceSpan
+{
+  public:
+    /// @brief Constructor, opens span
+    /// @param name[in] - Span name (string literal, stored by pointer)
+    explicit ScopedTraceSpan(const char* name) : name_{name}, begin_{0}, opened_{false}
+    {
+        // Tracing off costs one relaxed load and branch
+        if (detail::sampling_threshold.load(std::memory_order_relaxed) != 0U)
+        {
+            Open();
+        }
+    }
+
+    /// @brief Destructor, closes span
+    ~ScopedTraceSpan()
+    {
+        if (opened_)
+        {
+            Close();
+        }
+    }
+
+    ScopedTraceSpan(const ScopedTraceSpan&) = delete;
+    ScopedTraceSpan& operator=(const ScopedTraceSpan&) = delete;
+
+  private:
+    /// @brief Open span on calling thread, sampling root spans
+    void Open();
+
+    /// @brief Close span on calling thread, recording it if its root span is sampled
+    void Close();
+
+    /// @brief Span name
+    const char* name_;
+
+    /// @brief Begin of span, in nanoseconds (CLOCK_MONOTONIC)
+    std::int64_t begin_;
+
+    /// @brief Whether span was opened (tracing was on at construction)
+    bool opened_;
+};
+
+}  // namespace tracing
+}  // namespace fms
+
+#define TRACE_SPAN_CONCATENATE_DETAIL(lhs, rhs) lhs##rhs
+#define TRACE_SPAN_CONCATENATE(lhs, rhs) TRACE_SPAN_CONCATENATE_DETAIL(lhs, rhs)
+
+/// @brief Trace enclosing scope as span with provided name (string literal). Compiled out if FMS_DISABLE_TRACING is
+///        defined.
+/// @param name[in] - Span name
+#ifdef FMS_DISABLE_TRACING
+#define TRACE_SPAN(name)
+#else
+#define TRACE_SPAN(name) \
+    const fms::tracing::ScopedTraceSpan TRACE_SPAN_CONCATENATE(trace_span_, __LINE__) { name }
+#endif
+
+#endif  /// FLIGHT_MANAGEMENT_TRACING_H_
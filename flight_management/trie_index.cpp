@@ -0,0 +1,238 @@
+///
+/// @file trie_index.cpp
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#include "flight_management/trie_index.h"
+#include "flight_management/tracing.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace fms
+{
+namespace
+{
+/// @brief Fold character case (ASCII)
+char FoldCase(const char character)
+{
+    return static_cast<char>(std::tolower(static_cast<unsigned char>(character)));
+}
+}  // namespace
+
+constexpr TrieIndex::NodeIndex TrieIndex::kNoNode;
+
+TrieIndex::TrieIndex() : nodes_(1U, Node{{}, {}, 0U}), released_nodes_{}, slot_positions_{} {}
+
+void TrieIndex::Insert(const std::string& key, const std::size_t slot)
+{
+    TRACE_SPAN("TrieIndex::Insert");
+    NodeIndex node = 0U;
+    ++nodes_[node].subtree_slots;
+    for (const auto character : key)
+    {
+        const auto folded = FoldCase(character);
+        const auto& children = nodes_[node].children;
+        const auto child = std::lower_bound(children.begin(), children.end(), folded,
+                                            [](const auto& entry, const char value) { return entry.first < value; });
+        if ((child == children.end()) || (child->first != folded))
+        {
+            // Allocating may relocate nodes, hence children are looked up again
+            const auto position = child - children.begin();
+            const auto new_node = AllocateNode();
+            auto& parent_children = nodes_[node].children;
+            parent_children.insert(parent_children.begin() + position, std::make_pair(folded, new_node));
+            node = new_node;
+        }
+        else
+        {
+            node = child->second;
+        }
+        ++nodes_[node].subtree_slots;
+    }
+
+    auto& slots = nodes_[node].slots;
+    slots.push_back(slot);
+    if (slot >= slot_positions_.size())
+    {
+        slot_positions_.resize(slot + 1U, SlotPosition{kNoNode, 0U});
+    }
+    slot_positions_[slot] = SlotPosition{node, slots.size() - 1U};
+}
+
+void TrieIndex::Erase(const std::string& key, const std::size_t slot)
+{
+    TRACE_SPAN("TrieIndex::Erase");
+    std::vector<NodeIndex> path;
+    const auto node = FindNode(key, &path);
+    if ((node == kNoNode) || (GetSlotNode(slot) != node))
+    {
+        return;
+    }
+
+    // Move the node's last slot into the erased position
+    auto& slots = nodes_[node].slots;
+    const auto position = slot_positions_[slot].position;
+    const auto moved_slot = slots.back();
+    slots[position] = moved_slot;
+    slot_positions_[moved_slot].position = position;
+    slots.pop_back();
+    slot_positions_[slot].node = kNoNode;
+    std::for_each(path.begin(), path.end(), [this](const auto visited) { --nodes_[visited].subtree_slots; });
+
+    // Detach the highest emptied node below root, its whole subtree is empty
+    const auto emptied = std::find_if(path.begin() + 1, path.end(),
+                                      [this](const auto visited) { return nodes_[visited].subtree_slots == 0U; });
+    if (emptied != path.end())
+    {
+        auto& children = nodes_[*(emptied - 1)].children;
+        children.erase(std::find_if(children.begin(), children.end(),
+                                    [emptied](const auto& child) { return child.second == *emptied; }));
+        ReleaseSubtree(*emptied);
+    }
+}
+
+void TrieIndex::Replace(const std::string& key, const std::size_t old_slot, const std::size_t new_slot)
+{
+    const auto node = FindNode(key, nullptr);
+    if ((node == kNoNode) || (GetSlotNode(old_slot) != node))
+    {
+        return;
+    }
+    const auto position = slot_positions_[old_slot].position;
+    nodes_[node].slots[position] = new_slot;
+    slot_positions_[old_slot].node = kNoNode;
+    if (new_slot >= slot_positions_.size())
+    {
+        slot_positions_.resize(new_slot + 1U, SlotPosition{kNoNode, 0U});
+    }
+    slot_positions_[new_slot] = SlotPosition{node, position};
+}
+
+bool TrieIndex::VisitExact(const std::string& key, const SlotVisitor& visit) const
+{
+    TRACE_SPAN("TrieIndex::VisitExact");
+    return Visit(MatchExact(key), visit);
+}
+
+bool TrieIndex::VisitPrefix(const std::string& prefix, const SlotVisitor& visit) const
+{
+    TRACE_SPAN("TrieIndex::VisitPrefix");
+    return Visit(MatchPrefix(prefix), visit);
+}
+
+TrieIndex::KeyMatch TrieIndex::MatchExact(const std::string& key) const
+{
+    const auto node = FindNode(key, nullptr);
+    return KeyMatch{node, false, (node == kNoNode) ? 0U : nodes_[node].slots.size()};
+}
+
+TrieIndex::KeyMatch TrieIndex::MatchPrefix(const std::string& prefix) const
+{
+    const auto node = FindNode(prefix, nullptr);
+    return KeyMatch{node, true, (node == kNoNode) ? 0U : nodes_[node].subtree_slots};
+}
+
+bool TrieIndex::Visit(const KeyMatch& match, const SlotVisitor& visit) const
+{
+    if (match.node == kNoNode)
+    {
+        return true;
+    }
+    if (match.is_prefix)
+    {
+        return VisitSubtree(match.node, visit);
+    }
+    const auto& slots = nodes_[match.node].slots;
+    return std::all_of(slots.begin(), slots.end(), [&visit](const auto slot) { return visit(slot); });
+}
+
+std::vector<std::size_t> TrieIndex::FindExact(const std::string& key) const
+{
+    TRACE_SPAN("TrieIndex::FindExact");
+    const auto node = FindNode(key, nullptr);
+    return (node == kNoNode) ? std::vector<std::size_t>{} : nodes_[node].slots;
+}
+
+std::vector<std::size_t> TrieIndex::FindPrefix(const std::string& prefix) const
+{
+    TRACE_SPAN("TrieIndex::FindPrefix");
+    std::vector<std::size_t> slots;
+    const auto node = FindNode(prefix, nullptr);
+    if (node != kNoNode)
+    {
+        slots.reserve(nodes_[node].subtree_slots);
+        VisitSubtree(node, [&slots](const std::size_t slot) {
+            slots.push_back(slot);
+            return true;
+        });
+    }
+    return slots;
+}
+
+std::size_t TrieIndex::CountExact(const std::string& key) const { return MatchExact(key).count; }
+
+std::size_t TrieIndex::CountPrefix(const std::string& prefix) const { return MatchPrefix(prefix).count; }
+
+TrieIndex::NodeIndex TrieIndex::FindNode(const std::string& key, std::vector<NodeIndex>* path) const
+{
+    NodeIndex node = 0U;
+    if (path != nullptr)
+    {
+        path->push_back(node);
+    }
+    for (const auto character : key)
+    {
+        const auto folded = FoldCase(character);
+        const auto& children = nodes_[node].children;
+        const auto child = std::lower_bound(children.begin(), children.end(), folded,
+                                            [](const auto& entry, const char value) { return entry.first < value; });
+        if ((child == children.end()) || (child->first != folded))
+        {
+            return kNoNode;
+        }
+        node = child->second;
+        if (path != nullptr)
+        {
+            path->push_back(node);
+        }
+    }
+    return node;
+}
+
+bool TrieIndex::VisitSubtree(const NodeIndex node, const SlotVisitor& visit) const
+{
+    // Empty subtrees are released, hence every child holds slots
+    const auto& slots = nodes_[node].slots;
+    const auto& children = nodes_[node].children;
+    return std::all_of(slots.begin(), slots.end(), [&visit](const auto slot) { return visit(slot); }) &&
+           std::all_of(children.begin(), children.end(),
+                       [this, &visit](const auto& child) { return VisitSubtree(child.second, visit); });
+}
+
+TrieIndex::NodeIndex TrieIndex::GetSlotNode(const std::size_t slot) const
+{
+    return (slot < slot_positions_.size()) ? slot_positions_[slot].node : kNoNode;
+}
+
+TrieIndex::NodeIndex TrieIndex::AllocateNode()
+{
+    if (!released_nodes_.empty())
+    {
+        const auto node = released_nodes_.back();
+        released_nodes_.pop_back();
+        return node;
+    }
+    nodes_.push_back(Node{{}, {}, 0U});
+    return static_cast<NodeIndex>(nodes_.size() - 1U);
+}
+
+void TrieIndex::ReleaseSubtree(const NodeIndex node)
+{
+    std::for_each(nodes_[node].children.begin(), nodes_[node].children.end(),
+                  [this](const auto& child) { ReleaseSubtree(child.second); });
+    // Assigning an empty node frees the storage of its children and slots
+    nodes_[node] = Node{{}, {}, 0U};
+    released_nodes_.push_back(node);
+}
+
+}  // namespace fms
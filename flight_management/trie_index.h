@@ -0,0 +1,209 @@
+///
+/// @file trie_index.h
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+#ifndef FLIGHT_MANAGEMENT_TRIE_INDEX_H_
+#define FLIGHT_MANAGEMENT_TRIE_INDEX_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace fms
+{
+/// @brief Case-insensitive prefix index (trie) from string keys (i.e. flight names, cities) to trip slots.
+///
+/// Keys are case folded (ASCII) before insertion, hence each node holds slots of all keys which differ only in
+/// letter case. Callers which need case-sensitive matches filter the returned slots themselves.
+///
+/// Slots are dense storage indices, each held by at most one key. The index remembers where each slot is stored, so
+/// erasing and replacing slots runs in O(key) regardless of the number of slots per key. Nodes left without slots
+/// are released and reused by later insertions.
+class TrieIndex
+{
+  public:
+    /// @brief Visitor of trip slots (returns false to stop the visit)
+    using SlotVisitor = std::function<bool(const std::size_t)>;
+
+    /// @brief Index of node in nodes_
+    using NodeIndex = std::uint32_t;
+
+    /// @brief Index returned for non existing nodes
+    static constexpr NodeIndex kNoNode{0xFFFFFFFFU};
+
+    /// @brief Keys found by MatchExact or MatchPrefix, to count and visit their slots without searching them again.
+    ///        Valid until the index is modified.
+    struct KeyMatch
+    {
+        /// @brief Node of the key or prefix, kNoNode if no key matches
+        NodeIndex node;
+
+        /// @brief Whether slots of all keys below the node (prefix match) or only of the node (exact match) match
+        bool is_prefix;
+
+        /// @brief Number of matching slots
+        std::size_t count;
+    };
+
+    /// @brief Constructor
+    TrieIndex();
+
+    /// @brief Add slot for provided key
+    ///
+    /// @param key[in] - Key (i.e. flight name)
+    /// @param slot[in] - Trip slot in database storage, not held by any key
+    void Insert(const std::string& key, const std::size_t slot);
+
+    /// @brief Remove slot for provided key. If slot does not exist for the key, function does nothing.
+    ///
+    /// @param key[in] - Key used to insert the slot
+    /// @param slot[in] - Trip slot in database storage
+    void Erase(const std::string& key, const std::size_t slot);
+
+    /// @brief Replace slot for provided key (i.e. when trip has been moved in database storage)
+    ///
+    /// @param key[in] - Key used to insert the slot
+    /// @param old_slot[in] - Previous trip slot
+    /// @param new_slot[in] - New trip slot, not held by any key
+    void Replace(const std::string& key, const std::size_t old_slot, const std::size_t new_slot);
+
+    /// @brief Visit slots of all keys equal to provided key, ignoring case, in place. The index must not be modified
+    ///        during the visit.
+    ///
+    /// @param key[in] - Key to search
+    /// @param visit[in] - Called for each slot (in unspecified order), returns false to stop the visit
+    ///
+    /// @return completed - false if the visit has been stopped
+    bool VisitExact(const std::string& key, const SlotVisitor& visit) const;
+
+    /// @brief Visit slots of all keys starting with provided prefix, ignoring case, in place. Runs in
+    ///        O(prefix + results). The index must not be modified during the visit.
+    ///
+    /// @param prefix[in] - Prefix to search
+    /// @param visit[in] - Called for each slot (ordered by case folded key), returns false to stop the visit
+    ///
+    /// @return completed - false if the visit has been stopped
+    bool VisitPrefix(const std::string& prefix, const SlotVisitor& visit) const;
+
+    /// @brief Find keys equal to provided key, ignoring case. Runs in O(key).
+    ///
+    /// @param key[in] - Key to search
+    ///
+    /// @return match - Matching keys and their number of slots
+    KeyMatch MatchExact(const std::string& key) const;
+
+    /// @brief Find keys starting with provided prefix, ignoring case. Runs in O(prefix).
+    ///
+    /// @param prefix[in] - Prefix to search
+    ///
+    /// @return match - Matching keys and their number of slots
+    KeyMatch MatchPrefix(const std::string& prefix) const;
+
+    /// @brief Visit slots of keys found by MatchExact or MatchPrefix, in place (in the order of VisitExact or
+    ///        VisitPrefix respectively). The index must not be modified since the match and during the visit.
+    ///
+    /// @param match[in] - Matching keys
+    /// @param visit[in] - Called for each slot, returns false to stop the visit
+    ///
+    /// @return completed - false if the visit has been stopped
+    bool Visit(const KeyMatch& match, const SlotVisitor& visit) const;
+
+    /// @brief Find slots of all keys equal to provided key, ignoring case
+    ///
+    /// @param key[in] - Key to search
+    ///
+    /// @return slots - list of trip slots (in unspecified order)
+    std::vector<std::size_t> FindExact(const std::string& key) const;
+
+    /// @brief Find slots of all keys starting with provided prefix, ignoring case. Runs in O(prefix + results).
+    ///
+    /// @param prefix[in] - Prefix to search
+    ///
+    /// @return slots - list of trip slots (ordered by case folded key)
+    std::vector<std::size_t> FindPrefix(const std::string& prefix) const;
+
+    /// @brief Count slots of all keys equal to provided key, ignoring case. Runs in O(key).
+    ///
+    /// @param key[in] - Key to search
+    ///
+    /// @return count - number of trip slots
+    std::size_t CountExact(const std::string& key) const;
+
+    /// @brief Count slots of all keys starting with provided prefix, ignoring case. Runs in O(prefix).
+    ///
+    /// @param prefix[in] - Prefix to search
+    ///
+    /// @return count - number of trip slots
+    std::size_t CountPrefix(const std::string& prefix) const;
+
+  private:
+    /// @brief Trie Node
+    struct Node
+    {
+        /// @brief Child nodes, sorted by (case folded) character
+        std::vector<std::pair<char, NodeIndex>> children;
+
+        /// @brief Trip slots of keys ending at this node
+        std::vector<std::size_t> slots;
+
+        /// @brief Number of slots in this node and all of its descendants (used to skip and release empty subtrees)
+        std::size_t subtree_slots;
+    };
+
+    /// @brief Location of slot in the index
+    struct SlotPosition
+    {
+        /// @brief Node holding the slot, kNoNode if slot is not held
+        NodeIndex node;
+
+        /// @brief Position of the slot in the slots of the node
+        std::size_t position;
+    };
+
+    /// @brief Find node for provided key
+    ///
+    /// @param key[in] - Key to search
+    /// @param path[out] - Nodes visited from root to the found node (optional)
+    ///
+    /// @return node - Index of node, kNoNode if key does not exist
+    NodeIndex FindNode(const std::string& key, std::vector<NodeIndex>* path) const;
+
+    /// @brief Visit slots of the node and all of its descendants
+    ///
+    /// @param node[in] - Index of node
+    /// @param visit[in] - Called for each slot, returns false to stop the visit
+    ///
+    /// @return completed - false if the visit has been stopped
+    bool VisitSubtree(const NodeIndex node, const SlotVisitor& visit) const;
+
+    /// @brief Get node holding provided slot
+    ///
+    /// @return node - Index of node, kNoNode if slot is not held
+    NodeIndex GetSlotNode(const std::size_t slot) const;
+
+    /// @brief Get empty node, reusing a released node if there is any
+    ///
+    /// @return node - Index of node
+    NodeIndex AllocateNode();
+
+    /// @brief Release node and all of its descendants (which must hold no slots) for reuse
+    ///
+    /// @param node[in] - Index of node
+    void ReleaseSubtree(const NodeIndex node);
+
+    /// @brief Nodes of trie, root node being at index 0
+    std::vector<Node> nodes_;
+
+    /// @brief Released nodes, reused by later insertions
+    std::vector<NodeIndex> released_nodes_;
+
+    /// @brief Location of each slot (indexed by slot)
+    std::vector<SlotPosition> slot_positions_;
+};
+
+}  // namespace fms
+
+#endif  /// FLIGHT_MANAGEMENT_TRIE_INDEX_H_
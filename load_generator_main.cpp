@@ -0,0 +1,160 @@
+///
+/// @file load_generator_main.cpp
+/// @brief Generates pipelined query load on an RPC server and reports throughput and latency.
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+/// Usage: load_generator_main [--endpoint=unix:<path>|tcp:<port>] [--connections=<n>] [--pipeline=<n>]
+///                            [--seconds=<n>] [--trips=<n>] [--mutations=<percent>]
+///
+/// Queries refer to the synthetic trips preloaded by server_main --trips=<n>.
+///
+#include "flight_management/rpc_client.h"
+#include "flight_management/rpc_protocol.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// @brief Get value of command line flag (--name=value)
+std::string GetFlag(const int argc, char** argv, const std::string& name, const std::string& default_value)
+{
+    const auto prefix = "--" + name + "=";
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        const std::string argument{argv[idx]};
+        if (argument.compare(0U, prefix.size(), prefix) == 0)
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+    return default_value;
+}
+
+/// @brief Make random request (mix of lookups, and mutations with provided percentage)
+fms::RpcRequest MakeRequest(std::mt19937& generator, const std::size_t number_of_trips,
+                            const std::size_t mutations_percentage)
+{
+    std::uniform_int_distribution<std::size_t> trip{0U, std::max(std::size_t{1U}, number_of_trips) - 1U};
+    std::uniform_int_distribution<std::size_t> city{0U, 99U};
+    std::uniform_int_distribution<std::size_t> percentage{0U, 99U};
+
+    const auto name = "FL-" + std::to_string(trip(generator));
+    const auto origin_city = "City-" + std::to_string(city(generator));
+    const auto destination_city = "City-" + std::to_string(city(generator));
+    const auto selected = percentage(generator);
+    if (selected < mutations_percentage)
+    {
+        return fms::RpcRequest{0U, fms::RpcOpcode::kUpdateFareByTrip,
+                               fms::FlightTrip{name, {}, {}, {}, 1000.0 + static_cast<double>(selected)}, 0, 0};
+    }
+
+    const auto departure_time = static_cast<fms::Timestamp>(trip(generator)) * 60;
+    switch (selected % 10U)
+    {
+        case 0U:
+        case 1U:
+        case 2U:
+        case 3U:
+            return fms::RpcRequest{0U, fms::RpcOpcode::kFindFlightByNumber, fms::FlightTrip{name, {}, {}, {}, 0.0},
+                                   0, 0};
+        case 4U:
+        case 5U:
+        case 6U:
+            return fms::RpcRequest{0U, fms::RpcOpcode::kFindMinFareBetweenCities,
+                                   fms::FlightTrip{{}, {}, origin_city, destination_city, 0.0}, 0, 0};
+        case 7U:
+        case 8U:
+            return fms::RpcRequest{0U, fms::RpcOpcode::kFindFlightsByOriginCityInTimeWindow,
+                                   fms::FlightTrip{{}, {}, origin_city, {}, 0.0}, departure_time,
+                                   departure_time + 86400};
+        default:
+            return fms::RpcRequest{0U, fms::RpcOpcode::kFindMaxFareByOperator,
+                                   fms::FlightTrip{{}, "Operator-" + std::to_string(selected % 10U), {}, {}, 0.0}, 0,
+                                   0};
+    }
+}
+
+/// @brief Keep pipeline_depth requests in flight on one connection until deadline, collecting latencies
+void RunConnection(const std::string& endpoint, const std::size_t pipeline_depth, const Clock::time_point deadline,
+                   const std::size_t number_of_trips, const std::size_t mutations_percentage, const unsigned seed,
+                   std::vector<Clock::duration>& latencies)
+{
+    fms::RpcClient client{endpoint};
+    std::mt19937 generator{seed};
+    std::deque<Clock::time_point> sent_times;
+    fms::RpcResponse response{};
+    while (client.IsConnected())
+    {
+        const auto now = Clock::now();
+        for (; (now < deadline) && (sent_times.size() < pipeline_depth); sent_times.push_back(now))
+        {
+            client.Send(MakeRequest(generator, number_of_trips, mutations_percentage));
+        }
+        if (sent_times.empty() || !client.Flush() || !client.Receive(response))
+        {
+            break;
+        }
+
+        // Responses arrive in request order
+        latencies.push_back(Clock::now() - sent_times.front());
+        sent_times.pop_front();
+    }
+}
+
+/// @brief Get latency at provided percentile (latencies must be sorted)
+double GetPercentileInMicroseconds(const std::vector<Clock::duration>& latencies, const double percentile)
+{
+    if (latencies.empty())
+    {
+        return 0.0;
+    }
+    const auto idx = static_cast<std::size_t>(percentile / 100.0 * static_cast<double>(latencies.size() - 1U));
+    return std::chrono::duration<double, std::micro>(latencies[idx]).count();
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const auto endpoint = GetFlag(argc, argv, "endpoint", "unix:/tmp/flight_management.sock");
+    const auto number_of_connections = std::strtoul(GetFlag(argc, argv, "connections", "4").c_str(), nullptr, 10);
+    const auto pipeline_depth = std::strtoul(GetFlag(argc, argv, "pipeline", "16").c_str(), nullptr, 10);
+    const auto seconds = std::strtoul(GetFlag(argc, argv, "seconds", "5").c_str(), nullptr, 10);
+    const auto number_of_trips = std::strtoul(GetFlag(argc, argv, "trips", "100000").c_str(), nullptr, 10);
+    const auto mutations_percentage = std::strtoul(GetFlag(argc, argv, "mutations", "0").c_str(), nullptr, 10);
+
+    const auto start = Clock::now();
+    const auto deadline = start + std::chrono::seconds{seconds};
+    std::vector<std::vector<Clock::duration>> latencies(number_of_connections);
+    std::vector<std::thread> connections;
+    for (std::size_t idx = 0U; idx < number_of_connections; ++idx)
+    {
+        connections.emplace_back(RunConnection, endpoint, pipeline_depth, deadline, number_of_trips,
+                                 mutations_percentage, static_cast<unsigned>(idx), std::ref(latencies[idx]));
+    }
+    std::for_each(connections.begin(), connections.end(), [](auto& connection) { connection.join(); });
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<Clock::duration> all_latencies;
+    std::for_each(latencies.begin(), latencies.end(), [&all_latencies](const auto& connection_latencies) {
+        all_latencies.insert(all_latencies.end(), connection_latencies.begin(), connection_latencies.end());
+    });
+    std::sort(all_latencies.begin(), all_latencies.end());
+
+    std::cout << "connections: " << number_of_connections << ", pipeline: " << pipeline_depth
+              << ", requests: " << all_latencies.size() << std::endl
+              << "qps: " << static_cast<double>(all_latencies.size()) / elapsed << std::endl
+              << "latency p50: " << GetPercentileInMicroseconds(all_latencies, 50.0) << " us" << std::endl
+              << "latency p99: " << GetPercentileInMicroseconds(all_latencies, 99.0) << " us" << std::endl
+              << "latency p99.9: " << GetPercentileInMicroseconds(all_latencies, 99.9) << " us" << std::endl;
+    return all_latencies.empty() ? EXIT_FAILURE : EXIT_SUCCESS;
+}
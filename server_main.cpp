@@ -0,0 +1,108 @@
+///
+/// @file server_main.cpp
+/// @brief Serves Flight Trip Database over RPC (see rpc_server.h).
+/// @copyright Copyright (c) 2020. All Rights Reserved.
+///
+/// Usage: server_main [--endpoint=unix:<path>|tcp:<port>] [--threads=<n>] [--trips=<n>]
+///                    [--trace_sampling_rate=<ratio>] [--trace_output=<path>]
+///
+/// --trips preloads synthetic trips (FL-<i> operated by Operator-<i % 10> from City-<i % 100> to
+/// City-<(i / 100) % 100>), which are queried by load_generator_main.
+///
+/// SIGUSR1 toggles tracing at --trace_sampling_rate (default 0.01); when toggled off and on exit, the recorded spans
+/// are written as Chrome trace event JSON to --trace_output (default /tmp/flight_management_trace.json).
+///
+#include "flight_management/flight_trip_database.h"
+#include "flight_management/logging.h"
+#include "flight_management/rpc_server.h"
+#include "flight_management/tracing.h"
+
+#include <signal.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+/// @brief Get value of command line flag (--name=value)
+std::string GetFlag(const int argc, char** argv, const std::string& name, const std::string& default_value)
+{
+    const auto prefix = "--" + name + "=";
+    for (int idx = 1; idx < argc; ++idx)
+    {
+        const std::string argument{argv[idx]};
+        if (argument.compare(0U, prefix.size(), prefix) == 0)
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+    return default_value;
+}
+
+/// @brief Write recorded trace spans to file
+void WriteTrace(const std::string& path)
+{
+    std::ofstream trace{path};
+    fms::tracing::ExportChromeTrace(trace);
+    LOG(INFO) << "Wrote trace to " << path << " (" << fms::tracing::GetDroppedEvents() << " dropped events)";
+}
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    const auto endpoint = GetFlag(argc, argv, "endpoint", "unix:/tmp/flight_management.sock");
+    const auto number_of_threads = std::strtoul(
+        GetFlag(argc, argv, "threads", std::to_string(std::thread::hardware_concurrency())).c_str(), nullptr, 10);
+    const auto number_of_trips = std::strtoul(GetFlag(argc, argv, "trips", "0").c_str(), nullptr, 10);
+    const auto trace_sampling_rate = std::strtod(GetFlag(argc, argv, "trace_sampling_rate", "0.01").c_str(), nullptr);
+    const auto trace_output = GetFlag(argc, argv, "trace_output", "/tmp/flight_management_trace.json");
+
+    auto database = std::make_unique<fms::FlightTripDatabase>();
+    for (std::size_t idx = 0U; idx < number_of_trips; ++idx)
+    {
+        const auto departure_time = static_cast<fms::Timestamp>(idx) * 60;
+        database->AddTrip("FL-" + std::to_string(idx), "Operator-" + std::to_string(idx % 10U),
+                          "City-" + std::to_string(idx % 100U), "City-" + std::to_string((idx / 100U) % 100U),
+                          1000.0 + static_cast<double>(idx % 9000U), departure_time, departure_time + 7200);
+    }
+
+    // Block termination signals before any thread is started, so that they are delivered to sigwait below only
+    sigset_t signals{};
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    sigaddset(&signals, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    fms::RpcServer server{std::move(database), endpoint, number_of_threads};
+    if (!server.Start())
+    {
+        return EXIT_FAILURE;
+    }
+
+    int signal_number{0};
+    while ((sigwait(&signals, &signal_number) == 0) && (signal_number == SIGUSR1))
+    {
+        const auto tracing = fms::tracing::GetSamplingRate() > 0.0;
+        fms::tracing::SetSamplingRate(tracing ? 0.0 : trace_sampling_rate);
+        LOG(INFO) << "Tracing " << (tracing ? "off" : "on");
+        if (tracing)
+        {
+            WriteTrace(trace_output);
+        }
+    }
+    server.Stop();
+    if (fms::tracing::GetSamplingRate() > 0.0)
+    {
+        fms::tracing::SetSamplingRate(0.0);
+        WriteTrace(trace_output);
+    }
+
+    const auto statistics = server.GetStatistics();
+    LOG(INFO) << "Served " << statistics.requests << " requests in " << statistics.batches << " batches ("
+              << statistics.deduplicated_lookups << " deduplicated lookups)";
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,10 @@
+load("@bazel_tools//tools/build_defs/repo:http.bzl", "http_archive")
+
+def benchmark():
+    if "benchmark" not in native.existing_rules():
+        http_archive(
+            name = "benchmark",
+            url = "https://github.com/google/benchmark/archive/v1.5.0.tar.gz",
+            sha256 = "3c6a165b6ecc948967a1ead710d4a181d7b0fbcaa183ef7ea84604994966221a",
+            strip_prefix = "benchmark-1.5.0",
+        )
@@ -1,5 +1,7 @@
+load("@//third_party/benchmark:benchmark.bzl", "benchmark")
 load("@//third_party/googletest:googletest.bzl", "googletest")
 
 def third_party_dependencies():
     """ Load 3rd party dependencies """
+    benchmark()
     googletest()